@@ -0,0 +1,57 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Complex.h>
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+const size_t Count = 4096;
+
+// the bulk kernels in one layout, per element //
+template<typename T>
+void Run(const char * type, Complex::Layout layout, const std::vector< Complex::Template<T> > & x, const std::vector< Complex::Template<T> > & y) {
+	const Complex::Buffer<T> a(x.data(), Count, layout), b(y.data(), Count, layout);
+	Complex::Buffer<T> out(Count, layout), z(y.data(), Count, layout);
+	std::vector<T> real(Count);
+	const Complex::Template<T> alpha(T(0.5), T(-0.25));
+
+	const double multiply = Benchmarks::Measure([&]() { Complex::Multiply(a, b, out); Benchmarks::Keep(out.Part(0)[0]); });
+	const double magnitude = Benchmarks::Measure([&]() { Complex::Magnitude(a, real.data()); Benchmarks::Keep(real[Count/2]); });
+	const double phase = Benchmarks::Measure([&]() { Complex::Phase(a, real.data()); Benchmarks::Keep(real[Count/2]); });
+	const double axpy = Benchmarks::Measure([&]() { Complex::Axpy(alpha, a, z); Benchmarks::Keep(z.Part(0)[0]); });
+	const double dot = Benchmarks::Measure([&]() { Benchmarks::Keep(Complex::Dot(a, b)[0]); });
+	std::printf("%-6s %-11s multiply %6.2f  magnitude %6.2f  phase %6.2f  axpy %6.2f  dot %6.2f ns\n", type,
+		layout == Complex::Layout::Split ? "split" : "interleaved", 1e9*multiply/Count, 1e9*magnitude/Count, 1e9*phase/Count, 1e9*axpy/Count, 1e9*dot/Count);
+}
+
+// the same work one value at a time, through Complex::Template and std::complex //
+template<typename T>
+void Run(const char * type, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::vector< Complex::Template<T> > x(Count), y(Count), out(Count);
+	std::vector< std::complex<T> > sx(Count), sy(Count), sout(Count);
+	for(size_t i=0;i<Count;i++){
+		x[i] = Complex::Template<T>(T(u(random)), T(u(random))), y[i] = Complex::Template<T>(T(u(random)), T(u(random)));
+		sx[i] = std::complex<T>(x[i][0], x[i][1]), sy[i] = std::complex<T>(y[i][0], y[i][1]);
+	}
+	std::vector<T> real(Count);
+
+	const double multiply = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) out[i] = x[i]*y[i]; Benchmarks::Keep(out[Count/2][0]); });
+	const double standard = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) sout[i] = sx[i]*sy[i]; Benchmarks::Keep(sout[Count/2].real()); });
+	const double magnitude = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) real[i] = T(x[i].Magnitude()); Benchmarks::Keep(real[Count/2]); });
+	const double phase = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) real[i] = std::atan2(x[i][1], x[i][0]); Benchmarks::Keep(real[Count/2]); });
+	std::printf("%-6s %-11s multiply %6.2f  magnitude %6.2f  atan2 %6.2f  std::complex multiply %6.2f ns\n", type, "scalar",
+		1e9*multiply/Count, 1e9*magnitude/Count, 1e9*phase/Count, 1e9*standard/Count);
+	Run<T>(type, Complex::Layout::Split, x, y);
+	Run<T>(type, Complex::Layout::Interleaved, x, y);
+}
+
+int main() {
+	std::mt19937 random(41);
+	Run<double>("double", random);
+	Run<float>("float", random);
+	return 0;
+}
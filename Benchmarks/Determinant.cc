@@ -0,0 +1,59 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <random>
+
+using namespace Math;
+
+// the expansion along the first row that Determinant used before the LU kernel, O(n!) with a copied minor per level //
+template<typename T, int N>
+struct Cofactor {
+	static T Of(const Matrix::Template<T,N,N> & M) {
+		T det = T();
+		for(int i=0;i<N;i++) det += (i%2 ? -1 : 1)*M[0][i]*Cofactor<T,N-1>::Of(M.Reduced(0,i));
+		return det;
+	}
+};
+
+template<typename T>
+struct Cofactor<T,1> {
+	static T Of(const Matrix::Template<T,1,1> & M) { return M[0][0]; }
+};
+
+template<int N>
+void Run(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Template<double,N,N> M;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) M[i][j] = u(random);
+
+	const double cofactor = Benchmarks::Measure([&]() { Benchmarks::Keep(Cofactor<double,N>::Of(M)); });
+	const double lu = Benchmarks::Measure([&]() { Benchmarks::Keep(Matrix::Determinant(M)); });
+	std::printf("%3d  cofactor %14.3f us  lu %10.3f us  speedup %10.1fx\n", N, 1e6*cofactor, 1e6*lu, cofactor/lu);
+}
+
+// sizes past the point where the expansion is usable, through the Dynamic path //
+void Run(std::mt19937 & random, int n) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Dynamic<double> M(n, n, 0.0);
+	for(int i=0;i<n;i++)
+		for(int j=0;j<n;j++) M(i,j) = u(random);
+	const double lu = Benchmarks::Measure([&]() { Benchmarks::Keep(Matrix::Determinant(M)); });
+	std::printf("%3d  cofactor %14s     lu %10.3f us\n", n, "-", 1e6*lu);
+}
+
+int main() {
+	std::mt19937 random(5);
+	// 2 to 4 still use the closed forms, the LU kernel takes over from 5 //
+	Run<2>(random);
+	Run<3>(random);
+	Run<4>(random);
+	Run<5>(random);
+	Run<6>(random);
+	Run<7>(random);
+	Run<8>(random);
+	Run<9>(random);
+	Run<10>(random);
+	for(int n : {16, 32, 64, 128, 256}) Run(random, n);
+	return 0;
+}
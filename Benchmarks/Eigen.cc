@@ -0,0 +1,56 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Eigen.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+const size_t Count = 1000000;
+
+// |M v - lambda v| plus |V V^T - I| relative to the largest entry of M //
+template<typename T>
+double Error(const Matrix::Template<T,3,3> & M, const Eigen::Decomposition<T,3> & d) {
+	double scale = 0, residual = 0, orthogonal = 0;
+	for(int i=0;i<3;i++)
+		for(int j=0;j<3;j++) scale = Max(scale, Abs(double(M[i][j])));
+	for(int i=0;i<3;i++){
+		for(int r=0;r<3;r++){
+			double s = -double(d.values[i])*double(d.vectors[i][r]);
+			for(int k=0;k<3;k++) s += double(M[r][k])*double(d.vectors[i][k]);
+			residual = Max(residual, Abs(s));
+		}
+		for(int j=0;j<3;j++){
+			double dot = i == j ? -1 : 0;
+			for(int k=0;k<3;k++) dot += double(d.vectors[i][k])*double(d.vectors[j][k]);
+			orthogonal = Max(orthogonal, Abs(dot));
+		}
+	}
+	return residual/(scale > 0 ? scale : 1) + orthogonal;
+}
+
+// the batch kernel against the scalar closed form and cyclic Jacobi over the same random symmetric matrices, per matrix //
+template<typename T>
+void Run(const char * type, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::vector< Matrix::Template<T,3,3> > in(Count);
+	for(auto & M : in)
+		for(int i=0;i<3;i++)
+			for(int j=i;j<3;j++) M[i][j] = M[j][i] = T(u(random));
+	std::vector< Eigen::Decomposition<T,3> > out(Count);
+
+	const double batch = Benchmarks::Measure([&]() { Eigen::Symmetric(in.data(), out.data(), Count); Benchmarks::Keep(out[Count/2].values[0]); });
+	double worst = 0;
+	for(size_t i=0;i<Count;i++) worst = Max(worst, Error(in[i], out[i]));
+	const double scalar = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) out[i] = Eigen::Symmetric(in[i]); Benchmarks::Keep(out[Count/2].values[0]); });
+	const double jacobi = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) out[i] = Eigen::Jacobi(in[i]); Benchmarks::Keep(out[Count/2].values[0]); });
+	std::printf("%-6s batch %7.1f ns  closed form %7.1f ns  jacobi %7.1f ns  (per matrix)  worst error %.1e\n", type,
+		1e9*batch/Count, 1e9*scalar/Count, 1e9*jacobi/Count, worst);
+}
+
+int main() {
+	std::mt19937 random(47);
+	Run<double>("double", random);
+	Run<float>("float", random);
+	return 0;
+}
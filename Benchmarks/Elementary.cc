@@ -0,0 +1,46 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Elementary.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// small enough to stay in L1 so the polynomials rather than memory are measured //
+const size_t Count = 4096;
+
+// libm one element at a time against the Batch kernel at both accuracies, per element //
+template<typename T, typename Scalar, typename Kernel>
+void Run(const char * type, const char * name, const std::vector<T> & in, Scalar scalar, Kernel kernel) {
+	std::vector<T> out(Count);
+	const double libm = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) out[i] = scalar(in[i]); Benchmarks::Keep(out[Count/2]); });
+	const double precise = Benchmarks::Measure([&]() { kernel(in.data(), out.data(), Count, Batch::Accuracy::Precise); Benchmarks::Keep(out[Count/2]); });
+	const double fast = Benchmarks::Measure([&]() { kernel(in.data(), out.data(), Count, Batch::Accuracy::Fast); Benchmarks::Keep(out[Count/2]); });
+	std::printf("%-6s %-7s libm %7.2f ns  precise %7.2f ns  fast %7.2f ns  (per element)\n", type, name, 1e9*libm/Count, 1e9*precise/Count, 1e9*fast/Count);
+}
+
+template<typename T>
+std::vector<T> Uniform(double low, double high, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(low, high);
+	std::vector<T> x(Count);
+	for(T & v : x) v = T(u(random));
+	return x;
+}
+
+template<typename T>
+void Run(const char * type, std::mt19937 & random) {
+	const std::vector<T> exponent = Uniform<T>(-20, 20, random), positive = Uniform<T>(1e-3, 1e3, random), angle = Uniform<T>(-10, 10, random);
+	Run(type, "exp", exponent, [](T x) { return std::exp(x); }, [](const T * in, T * out, size_t n, Batch::Accuracy a) { Batch::Exp(in, out, n, a); });
+	Run(type, "log", positive, [](T x) { return std::log(x); }, [](const T * in, T * out, size_t n, Batch::Accuracy a) { Batch::Log(in, out, n, a); });
+	Run(type, "sin", angle, [](T x) { return std::sin(x); }, [](const T * in, T * out, size_t n, Batch::Accuracy a) { Batch::Sin(in, out, n, a); });
+	Run(type, "cos", angle, [](T x) { return std::cos(x); }, [](const T * in, T * out, size_t n, Batch::Accuracy a) { Batch::Cos(in, out, n, a); });
+	Run(type, "atan", angle, [](T x) { return std::atan(x); }, [](const T * in, T * out, size_t n, Batch::Accuracy a) { Batch::ArcTan(in, out, n, a); });
+}
+
+int main() {
+	std::mt19937 random(17);
+	Run<float>("float", random);
+	Run<double>("double", random);
+	return 0;
+}
@@ -0,0 +1,47 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+const int Count = 1024;
+
+// D = A + B*2 - C through the nodes against the same sum with a whole temporary per operator //
+template<typename V>
+void Run(const char * name, int lanes, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::vector<V> A(Count), B(Count), C(Count), D(Count);
+	for(int i=0;i<Count;i++){
+		double * a = reinterpret_cast<double *>(&A[i]), * b = reinterpret_cast<double *>(&B[i]), * c = reinterpret_cast<double *>(&C[i]);
+		for(int j=0;j<lanes;j++) a[j] = u(random), b[j] = u(random), c[j] = u(random);
+	}
+
+	const double eager = Benchmarks::Measure([&]() {
+		for(int i=0;i<Count;i++){
+			V t = B[i];
+			t *= 2.0;
+			V s = A[i];
+			s += t;
+			s -= C[i];
+			D[i] = s;
+		}
+		Benchmarks::Keep(reinterpret_cast<const double *>(&D[Count/2])[0]);
+	});
+	const double lazy = Benchmarks::Measure([&]() {
+		for(int i=0;i<Count;i++) D[i] = A[i] + B[i]*2.0 - C[i];
+		Benchmarks::Keep(reinterpret_cast<const double *>(&D[Count/2])[0]);
+	});
+	std::printf("%-10s eager %7.2f ns  lazy %7.2f ns  (3 temporaries per expression eliminated)\n", name, 1e9*eager/Count, 1e9*lazy/Count);
+}
+
+int main() {
+	std::mt19937 random(13);
+	Run< Vector::Template<double,3> >("Dim3", 3, random);
+	Run< Vector::Template<double,4> >("Dim4", 4, random);
+	Run< Vector::Template<double,8> >("Dim8", 8, random);
+	Run< Matrix::Template<double,4,4> >("Matrix4", 16, random);
+	return 0;
+}
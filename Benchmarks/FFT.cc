@@ -0,0 +1,51 @@
+#include <Benchmarks/Timer.h>
+#include <Math/FFT.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// the O(n^2) transform FFT::Forward replaces, with the twiddles from a table so only the sum is timed //
+template<typename T>
+void Naive(const std::vector< Complex::Template<T> > & in, std::vector< Complex::Template<T> > & out, const std::vector< Complex::Template<T> > & roots) {
+	const size_t n = in.size();
+	for(size_t k=0;k<n;k++){
+		T re = 0, im = 0;
+		for(size_t j=0,t=0;j<n;j++,t=(t+k)%n){
+			re += in[j][0]*roots[t][0] - in[j][1]*roots[t][1];
+			im += in[j][0]*roots[t][1] + in[j][1]*roots[t][0];
+		}
+		out[k] = Complex::Template<T>(re, im);
+	}
+}
+
+template<typename T>
+void Run(const char * type, size_t n) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<T> u(-1, 1);
+	std::vector< Complex::Template<T> > x(n), y(n), roots(n);
+	for(size_t i=0;i<n;i++){
+		x[i] = Complex::Template<T>(u(random), u(random));
+		roots[i] = Complex::Template<T>(T(std::cos(-2*Pi<double>()*double(i)/double(n))), T(std::sin(-2*Pi<double>()*double(i)/double(n))));
+	}
+
+	const double naive = Benchmarks::Measure([&]() { Naive(x, y, roots); Benchmarks::Keep(y[n/2][0]); });
+	FFT::Forward(y.data(), n);
+	const double fast = Benchmarks::Measure([&]() { y = x; FFT::Forward(y.data(), n); Benchmarks::Keep(y[n/2][0]); });
+
+	std::vector<T> real(n);
+	for(size_t i=0;i<n;i++) real[i] = x[i][0];
+	const double half = Benchmarks::Measure([&]() { FFT::ForwardReal(real.data(), y.data(), n); Benchmarks::Keep(y[n/4][0]); });
+
+	std::printf("%-6s %7zu  naive %12.1f us  fft %10.2f us  real fft %10.2f us  speedup %8.1fx\n", type, n, 1e6*naive, 1e6*fast, 1e6*half, naive/fast);
+}
+
+int main() {
+	// powers of two, mixed radix, a prime small enough for the generic butterfly and primes that go through Bluestein //
+	const size_t sizes[] = {64, 256, 1000, 1024, 4096, 4093, 6000, 16384};
+	for(size_t n : sizes) Run<double>("double", n);
+	for(size_t n : sizes) Run<float>("float", n);
+	return 0;
+}
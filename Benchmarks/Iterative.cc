@@ -0,0 +1,69 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Iterative.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace Math;
+
+// 5 point Laplacian on a k x k grid, plus a first order term of strength c that makes it non symmetric when c is not 0 //
+Matrix::Sparse<double> Grid(int k, double c) {
+	std::vector< Matrix::Triplet<double> > triplets;
+	for(int i=0;i<k;i++)
+		for(int j=0;j<k;j++){
+			const int r = i*k+j;
+			triplets.push_back(Matrix::Triplet<double>{r, r, 4.0});
+			if( i > 0 ) triplets.push_back(Matrix::Triplet<double>{r, r-k, -1.0 - c});
+			if( i+1 < k ) triplets.push_back(Matrix::Triplet<double>{r, r+k, -1.0 + c});
+			if( j > 0 ) triplets.push_back(Matrix::Triplet<double>{r, r-1, -1.0});
+			if( j+1 < k ) triplets.push_back(Matrix::Triplet<double>{r, r+1, -1.0});
+		}
+	return Matrix::Sparse<double>(k*k, k*k, triplets);
+}
+
+// |b - A x|/|b| recomputed from scratch, to set next to what the method tracked //
+double Residual(const Matrix::Sparse<double> & A, const Vector::Dynamic<double> & b, const Vector::Dynamic<double> & x) {
+	Vector::Dynamic<double> r = b;
+	Matrix::Multiply(A, &x, &r, -1.0, 1.0);
+	double rr = 0, bb = 0;
+	for(int i=0;i<b.GetSize();i++) rr += r[i]*r[i], bb += b[i]*b[i];
+	return std::sqrt(rr/bb);
+}
+
+// one solve from x = 0, a solve is long enough that a single run is the measurement //
+template<typename Solve>
+void Run(const char * name, const Matrix::Sparse<double> & A, const Vector::Dynamic<double> & b, Solve solve) {
+	Vector::Dynamic<double> x;
+	Iterative::Report<double> report;
+	const double seconds = Benchmarks::Best(1, [&]() { x = Vector::Dynamic<double>(b.GetSize(), 0.0); report = solve(x); });
+	std::printf("%-36s %8d unknowns  %5zu iterations  %9.1f ms  residual %.2e (true %.2e)%s\n", name, A.Rows(), report.iterations, 1e3*seconds,
+		report.residual, Residual(A, b, x), report.converged ? "" : "  not converged");
+}
+
+void Poisson(int k, bool plain) {
+	const Matrix::Sparse<double> A = Grid(k, 0.0);
+	const Vector::Dynamic<double> b(k*k, 1.0);
+	const Iterative::Settings<double> settings(1e-8, 5000, 30, false);
+	if( plain ) Run("CG", A, b, [&](Vector::Dynamic<double> & x) { return Iterative::CG(A, Iterative::Identity<double>(size_t(k)*k), b, x, settings); });
+	const auto start = std::chrono::steady_clock::now();
+	const Iterative::IncompleteCholesky<double> ichol(A);
+	const double setup = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::printf("%-36s %8d unknowns  setup %9.1f ms\n", "incomplete Cholesky", A.Rows(), 1e3*setup);
+	Run("CG with incomplete Cholesky", A, b, [&](Vector::Dynamic<double> & x) { return Iterative::CG(A, ichol, b, x, settings); });
+}
+
+void Convection(int k, double c) {
+	const Matrix::Sparse<double> A = Grid(k, c);
+	const Vector::Dynamic<double> b(k*k, 1.0);
+	const Iterative::Settings<double> settings(1e-8, 5000, 30, false);
+	Run("convection BiCGSTAB with Jacobi", A, b, [&](Vector::Dynamic<double> & x) { return Iterative::BiCGSTAB(A, Iterative::Jacobi<double>(A), b, x, settings); });
+	Run("convection GMRES(30) with Jacobi", A, b, [&](Vector::Dynamic<double> & x) { return Iterative::GMRES(A, Iterative::Jacobi<double>(A), b, x, settings); });
+}
+
+int main() {
+	Poisson(300, true);
+	Convection(300, 0.4);
+	// 10^6 unknowns, tens of seconds //
+	Poisson(1000, false);
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Geometry/KDTree.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+typedef Geometry::KDTree<double,2> Tree;
+
+const size_t Count = 1000000, Queries = 4096;
+
+// uniform over a 100 by 100 square, so a radius of 0.5 holds about 78 points //
+std::vector< Geometry::Point<double,2> > Points(size_t count, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(0, 100);
+	std::vector< Geometry::Point<double,2> > points(count);
+	for(auto & p : points) p[0] = u(random), p[1] = u(random);
+	return points;
+}
+
+// the nearest point by a scan of all of them, what a single query against the tree replaces //
+uint32_t Scan(const std::vector< Geometry::Point<double,2> > & points, const Geometry::Point<double,2> & q) {
+	uint32_t best = 0;
+	double distance = points[0].GetDistanceSquared(q);
+	for(size_t i=1;i<points.size();i++){
+		const double d = points[i].GetDistanceSquared(q);
+		if( d < distance ) distance = d, best = uint32_t(i);
+	}
+	return best;
+}
+
+int main() {
+	std::mt19937 random(53);
+	const auto points = Points(Count, random), queries = Points(Queries, random);
+
+	Tree tree;
+	const double build = Benchmarks::Best(3, [&]() { tree = Tree(points); });
+	std::printf("build       %8zu points  %9.1f ms\n", Count, 1e3*build);
+
+	const size_t scanned = 64;
+	const double scan = Benchmarks::Best(1, [&]() { for(size_t i=0;i<scanned;i++) Benchmarks::Keep(Scan(points, queries[i])); })/scanned;
+	const double nearest = Benchmarks::Measure([&]() { for(const auto & q : queries) Benchmarks::Keep(tree.Nearest(q).index); })/Queries;
+	std::printf("1 nearest   tree %8.2f us  scan %9.1f us  (per query)\n", 1e6*nearest, 1e6*scan);
+
+	const size_t k = 8;
+	std::vector<Tree::Neighbour> rows(Queries*k);
+	const double batch = Benchmarks::Measure([&]() { tree.Nearest(queries.data(), Queries, k, rows.data()); Benchmarks::Keep(rows[k].index); })/Queries;
+	std::printf("8 nearest   batch %7.2f us  (per query)\n", 1e6*batch);
+
+	std::vector<Tree::Neighbour> found;
+	size_t hits = 0;
+	const double radius = Benchmarks::Measure([&]() {
+		hits = 0;
+		for(const auto & q : queries) found.clear(), tree.Radius(q, 0.5, found), hits += found.size();
+		Benchmarks::Keep(hits);
+	})/Queries;
+	std::printf("radius 0.5  %6.2f us  (per query, %.0f hits on average)\n", 1e6*radius, double(hits)/Queries);
+	return 0;
+}
@@ -0,0 +1,52 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+const int Count = 4096;
+
+// the same libm call finished under each policy, per call //
+template<typename P>
+double Scalar(const std::vector<double> & x) {
+	return Benchmarks::Measure([&]() {
+		double s = 0;
+		for(double v : x) s += Sin<double,P>(v) + Log<double,P>(v + 2);
+		Benchmarks::Keep(s);
+	})/(2*Count);
+}
+
+template<typename P, int N>
+double Product(const Matrix::Template<double,N,N> & A, const Matrix::Template<double,N,N> & B) {
+	Matrix::Template<double,N,N> C;
+	return Benchmarks::Measure([&]() { Matrix::TransformInto<P>(C, A, B); Benchmarks::Keep(C[N/2][N/2]); });
+}
+
+template<int N>
+void Run(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Template<double,N,N> A, B;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) A[i][j] = u(random), B[i][j] = u(random);
+	std::printf("Transform %2dx%-2d  exact %9.3f us  snapped %9.3f us  fast %9.3f us\n", N, N,
+		1e6*Product<Policy::Exact>(A,B), 1e6*Product<Policy::Snapped>(A,B), 1e6*Product<Policy::Fast>(A,B));
+}
+
+int main() {
+	std::mt19937 random(19);
+	std::uniform_real_distribution<double> u(-3, 3);
+	std::vector<double> x(Count);
+	for(double & v : x) v = u(random);
+	std::printf("Sin, Log         exact %9.3f ns  snapped %9.3f ns  fast %9.3f ns\n",
+		1e9*Scalar<Policy::Exact>(x), 1e9*Scalar<Policy::Snapped>(x), 1e9*Scalar<Policy::Fast>(x));
+
+	// below Matrix::TransformKernelThreshold each element is finished as it is summed, from there in a pass after Gemm //
+	Run<4>(random);
+	Run<8>(random);
+	Run<16>(random);
+	Run<32>(random);
+	Run<64>(random);
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Quaternion.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+const size_t Count = 4096;
+
+template<typename T>
+Quaternion::Template<T> Random(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1), angle(-Pi<double>(), Pi<double>());
+	const double x = u(random), y = u(random), z = u(random), length = std::sqrt(x*x + y*y + z*z) + 1e-12;
+	return Quaternion::AxisAngle(Vector::Template<T,3>{T(x/length), T(y/length), T(z/length)}, T(angle(random)));
+}
+
+// a chain of rotations accumulated step by step, each step depends on the one before //
+template<typename T>
+void Chain(const char * type, std::mt19937 & random) {
+	const Quaternion::Template<T> step = Random<T>(random);
+	const Matrix::Template<T,3,3> S = Quaternion::ToMatrix(step);
+	const double quaternion = Benchmarks::Measure([&]() {
+		Quaternion::Template<T> q;
+		for(size_t i=0;i<Count;i++) q = q*step;
+		Benchmarks::Keep(q[0]);
+	});
+	const double matrix = Benchmarks::Measure([&]() {
+		Matrix::Template<T,3,3> R = Matrix::Identity<T,3>();
+		for(size_t i=0;i<Count;i++) R = Matrix::Transform(R, S);
+		Benchmarks::Keep(R[0][0]);
+	});
+	std::printf("%-6s chain      quaternion %7.2f ns  3x3 Transform %7.2f ns  (per step)\n", type, 1e9*quaternion/Count, 1e9*matrix/Count);
+}
+
+// each vector turned by its own rotation, as a quaternion, as its matrix, and through the structure of arrays batch //
+template<typename T>
+void Rotation(const char * type, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::vector< Quaternion::Template<T> > q(Count), p(Count);
+	std::vector< Matrix::Template<T,3,3> > R(Count);
+	std::vector< Vector::Template<T,3> > v(Count), out(Count);
+	for(size_t i=0;i<Count;i++){
+		q[i] = Random<T>(random), p[i] = Random<T>(random), R[i] = Quaternion::ToMatrix(q[i]);
+		v[i] = Vector::Template<T,3>{T(u(random)), T(u(random)), T(u(random))};
+	}
+	const Quaternion::Batch<T> Q(q.data(), Count), P(p.data(), Count);
+	const Vector::Batch<T,3> V(v.data(), Count);
+	Vector::Batch<T,3> W(Count);
+	Quaternion::Batch<T> C(Count);
+
+	const double scalar = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) out[i] = q[i].Rotate(v[i]); Benchmarks::Keep(out[Count/2][0]); });
+	const double matrix = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) out[i] = R[i]*v[i]; Benchmarks::Keep(out[Count/2][0]); });
+	const double batch = Benchmarks::Measure([&]() { Quaternion::Rotate(Q, V, W); Benchmarks::Keep(W.Component(0)[Count/2]); });
+	const double compose = Benchmarks::Measure([&]() { Quaternion::Compose(Q, P, C); Benchmarks::Keep(C.Component(0)[Count/2]); });
+	std::printf("%-6s rotate     quaternion %7.2f ns  3x3 matrix %7.2f ns  batch %7.2f ns  (per vector)\n", type, 1e9*scalar/Count, 1e9*matrix/Count, 1e9*batch/Count);
+	std::printf("%-6s compose    batch %7.2f ns  (per pair)\n", type, 1e9*compose/Count);
+}
+
+int main() {
+	std::mt19937 random(37);
+	Chain<float>("float", random);
+	Chain<double>("double", random);
+	Rotation<float>("float", random);
+	Rotation<double>("double", random);
+	return 0;
+}
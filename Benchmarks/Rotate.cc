@@ -0,0 +1,50 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+const size_t Count = 1 << 20;
+
+// Z*Y*X through two matrix products against the closed forms, one matrix at a time and through the batch forms //
+template<typename T>
+void Run(const char * type, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-Pi<double>(), Pi<double>()), w(-1, 1);
+	std::vector<T> yaw(Count), pitch(Count), roll(Count), angle(Count);
+	std::vector< Vector::Template<T,3> > axis(Count);
+	for(size_t i=0;i<Count;i++){
+		yaw[i] = T(u(random)), pitch[i] = T(u(random)), roll[i] = T(u(random)), angle[i] = T(u(random));
+		const double x = w(random), y = w(random), z = w(random), length = std::sqrt(x*x + y*y + z*z) + 1e-12;
+		axis[i] = Vector::Template<T,3>{T(x/length), T(y/length), T(z/length)};
+	}
+	std::vector< Matrix::Template<T,3,3> > R(Count);
+	std::vector< Matrix::Template<T,4,4> > H(Count);
+	using namespace Matrix::Rotate;
+
+	const double product = Benchmarks::Measure([&]() {
+		for(size_t i=0;i<Count;i++) R[i] = Matrix::Transform(Z(yaw[i]), Matrix::Transform(Y(pitch[i]), X(roll[i])));
+		Benchmarks::Keep(R[Count/2][0][0]);
+	});
+	const double snapped = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) R[i] = Euler(yaw[i], pitch[i], roll[i]); Benchmarks::Keep(R[Count/2][0][0]); });
+	const double exact = Benchmarks::Measure([&]() { for(size_t i=0;i<Count;i++) R[i] = Euler<T,Policy::Exact>(yaw[i], pitch[i], roll[i]); Benchmarks::Keep(R[Count/2][0][0]); });
+	const double batch3 = Benchmarks::Measure([&]() { Euler(yaw.data(), pitch.data(), roll.data(), R.data(), Count); Benchmarks::Keep(R[Count/2][0][0]); });
+	const double batch4 = Benchmarks::Measure([&]() { Euler(yaw.data(), pitch.data(), roll.data(), H.data(), Count); Benchmarks::Keep(H[Count/2][0][0]); });
+	const double axes = Benchmarks::Measure([&]() { AxisAngle(axis.data(), angle.data(), R.data(), Count); Benchmarks::Keep(R[Count/2][0][0]); });
+
+	std::printf("%-6s Z*Y*X via two Transforms   %7.1f ns\n", type, 1e9*product/Count);
+	std::printf("%-6s Rotate::Euler (Snapped)    %7.1f ns\n", type, 1e9*snapped/Count);
+	std::printf("%-6s Rotate::Euler (Exact)      %7.1f ns\n", type, 1e9*exact/Count);
+	std::printf("%-6s Euler batch 3x3            %7.1f ns\n", type, 1e9*batch3/Count);
+	std::printf("%-6s Euler batch 4x4            %7.1f ns\n", type, 1e9*batch4/Count);
+	std::printf("%-6s AxisAngle batch 3x3        %7.1f ns  (per matrix)\n", type, 1e9*axes/Count);
+}
+
+int main() {
+	std::mt19937 random(31);
+	Run<float>("float", random);
+	Run<double>("double", random);
+	return 0;
+}
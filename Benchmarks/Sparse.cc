@@ -0,0 +1,86 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Sparse.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// the 5 point Laplacian on a side by side grid, with each entry widened to a B by B block when B > 1 //
+template<int B>
+Matrix::Sparse<double> Laplacian(int side, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	const int n = side*side;
+	std::vector< Matrix::Triplet<double> > triplets;
+	auto block = [&](int r, int c, double value) {
+		for(int i=0;i<B;i++)
+			for(int j=0;j<B;j++) triplets.push_back(Matrix::Triplet<double>{r*B+i, c*B+j, B == 1 ? value : value + 0.1*u(random)});
+	};
+	for(int y=0;y<side;y++)
+		for(int x=0;x<side;x++){
+			const int r = y*side + x;
+			block(r, r, 4);
+			if( x > 0 ) block(r, r-1, -1);
+			if( x+1 < side ) block(r, r+1, -1);
+			if( y > 0 ) block(r, r-side, -1);
+			if( y+1 < side ) block(r, r+side, -1);
+		}
+	return Matrix::Sparse<double>(n*B, n*B, triplets);
+}
+
+// the row loop over the compressed arrays written out, what Multiply replaces //
+void Loop(const Matrix::Sparse<double> & A, const double * x, double * y) {
+	const size_t * offset = A.Offsets();
+	const int * index = A.Indices();
+	const double * value = A.Values();
+	for(int r=0;r<A.Rows();r++){
+		double s = 0;
+		for(size_t k=offset[r];k<offset[r+1];k++) s += value[k]*x[index[k]];
+		y[r] = s;
+	}
+}
+
+template<int B>
+void Run(const char * name, int side, std::mt19937 & random) {
+	const Matrix::Sparse<double> A = Laplacian<B>(side, random);
+	std::vector<double> x(A.Columns(), 1.0), y(A.Rows());
+	const double nonzeros = double(A.NonZeros());
+	const double loop = Benchmarks::Measure([&]() { Loop(A, x.data(), y.data()); Benchmarks::Keep(y[y.size()/2]); });
+	const double csr = Benchmarks::Measure([&]() { Matrix::Multiply(A, x.data(), y.data()); Benchmarks::Keep(y[y.size()/2]); });
+	std::printf("%-11s %8d rows  loop %6.2f  csr %6.2f", name, A.Rows(), 1e9*loop/nonzeros, 1e9*csr/nonzeros);
+	if( B > 1 ){
+		const Matrix::Blocked<double,B> K(A);
+		const double blocked = Benchmarks::Measure([&]() { Matrix::Multiply(K, x.data(), y.data()); Benchmarks::Keep(y[y.size()/2]); });
+		std::printf("  blocked %6.2f", 1e9*blocked/nonzeros);
+	}
+	std::printf(" ns per nonzero\n");
+}
+
+// the same 4096 by 4096 Laplacian stored dense, time and bytes //
+void Dense(std::mt19937 & random) {
+	const Matrix::Sparse<double> A = Laplacian<1>(64, random);
+	const Matrix::Dynamic<double> M = A.Dense();
+	const int n = A.Rows();
+	std::vector<double> x(n, 1.0), y(n);
+	const double dense = Benchmarks::Measure([&]() {
+		for(int r=0;r<n;r++){
+			double s = 0;
+			for(int c=0;c<n;c++) s += M(r,c)*x[c];
+			y[r] = s;
+		}
+		Benchmarks::Keep(y[n/2]);
+	}, 1.0);
+	const double csr = Benchmarks::Measure([&]() { Matrix::Multiply(A, x.data(), y.data()); Benchmarks::Keep(y[n/2]); });
+	const double bytes = double(n)*n*sizeof(double), compressed = double(A.NonZeros())*(sizeof(double) + sizeof(int)) + double(n+1)*sizeof(size_t);
+	std::printf("4096^2 laplacian  dense %8.2f ms %8.2f MB  csr %8.2f us %6.2f MB\n", 1e3*dense, 1e-6*bytes, 1e6*csr, 1e-6*compressed);
+}
+
+int main() {
+	std::mt19937 random(43);
+	Run<1>("laplacian", 64, random);
+	Run<1>("laplacian", 1000, random);
+	Run<4>("4x4 blocks", 32, random);
+	Run<4>("4x4 blocks", 500, random);
+	Dense(random);
+	return 0;
+}
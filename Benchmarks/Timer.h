@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef MATH_BENCHMARKS_TIMER
+#define MATH_BENCHMARKS_TIMER
+
+#include <Math/Prefix.h>
+
+#include <chrono>
+#include <cstdio>
+
+// every file under Benchmarks is a program of its own, built optimized with the repository root on the include path //
+// and Source/*.cc linked in, it prints one table row per case //
+namespace Math {
+	namespace Benchmarks {
+		// fastest of repeats runs of body in seconds, the minimum filters out scheduling noise //
+		template<typename Body>
+		double Best(int repeats, Body body) {
+			double best = 0;
+			for(int r=0;r<repeats;r++){
+				const auto start = std::chrono::steady_clock::now();
+				body();
+				const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				if( r == 0 or seconds < best ) best = seconds;
+			}
+			return best;
+		}
+
+		// repeats chosen so the whole measurement takes about budget seconds, from one timed warm up run //
+		template<typename Body>
+		double Measure(Body body, double budget =0.2) {
+			const double once = Best(1, body);
+			const int repeats = once > 0 ? int(budget/once) : 1000;
+			return Best(repeats < 3 ? 3 : repeats > 1000 ? 1000 : repeats, body);
+		}
+
+		// keeps a scalar result alive so the optimizer cannot drop the work that produced it //
+		template<typename T>
+		void Keep(T const & x) {
+			static volatile T sink;
+			sink = x;
+			(void)sink;
+		}
+	}
+}
+
+#endif // ending MATH_BENCHMARKS_TIMER //
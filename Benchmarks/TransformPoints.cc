@@ -0,0 +1,56 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// out[i] = M*in[i] one operator* at a time against Matrix::TransformPoints, in L2 and past Kernel::StreamBytes //
+template<typename T, int N>
+void Run(const char * type, size_t count, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Template<T,N,N> M;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) M[i][j] = T(u(random));
+	std::vector< Vector::Template<T,N> > in(count), out(count);
+	for(auto & p : in)
+		for(int j=0;j<N;j++) p[j] = T(u(random));
+
+	const double loop = Benchmarks::Measure([&]() { for(size_t i=0;i<count;i++) out[i] = M*in[i]; Benchmarks::Keep(out[count/2][0]); });
+	const double points = Benchmarks::Measure([&]() { Matrix::TransformPoints(M, in.data(), out.data(), count); Benchmarks::Keep(out[count/2][0]); });
+	std::printf("%-6s %dx%d      %8zu  operator* %7.2f ns  TransformPoints %7.2f ns  (per point%s)\n", type, N, N, count,
+		1e9*loop/count, 1e9*points/count, count*sizeof(Vector::Template<T,N>) >= Matrix::Kernel::StreamBytes ? ", streamed" : "");
+}
+
+// the [R t; 0 1] form on 3 component points against R*p + t written out //
+template<typename T>
+void Affine(const char * type, size_t count, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Template<T,4,4> M(T(0));
+	Matrix::Template<T,3,3> R;
+	for(int i=0;i<3;i++){
+		for(int j=0;j<4;j++) M[i][j] = T(u(random));
+		for(int j=0;j<3;j++) R[i][j] = M[i][j];
+	}
+	M[3][3] = T(1);
+	const Vector::Template<T,3> t = {M[0][3], M[1][3], M[2][3]};
+	std::vector< Vector::Template<T,3> > in(count), out(count);
+	for(auto & p : in)
+		for(int j=0;j<3;j++) p[j] = T(u(random));
+
+	const double loop = Benchmarks::Measure([&]() { for(size_t i=0;i<count;i++) out[i] = R*in[i] + t; Benchmarks::Keep(out[count/2][0]); });
+	const double points = Benchmarks::Measure([&]() { Matrix::TransformPoints(M, in.data(), out.data(), count); Benchmarks::Keep(out[count/2][0]); });
+	std::printf("%-6s 4x4 on 3 %8zu  R*p + t   %7.2f ns  TransformPoints %7.2f ns  (per point)\n", type, count, 1e9*loop/count, 1e9*points/count);
+}
+
+int main() {
+	std::mt19937 random(23);
+	for(size_t count : {size_t(10000), size_t(4000000)}){
+		Run<float,4>("float", count, random);
+		Run<float,3>("float", count, random);
+		Run<double,4>("double", count, random);
+		Affine<float>("float", count, random);
+	}
+	return 0;
+}
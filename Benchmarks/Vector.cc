@@ -0,0 +1,60 @@
+#include <Benchmarks/Timer.h>
+#include <Math/Algebra/Vector.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// a batch large enough to time, small enough to stay in L1 so the kernels rather than memory are measured //
+const int Count = 1024;
+
+template<typename T, int size>
+void Run(const char * type, std::mt19937 & random) {
+	typedef Vector::Template<T,size> V;
+	typedef Vector::Lanes<T,size,false> Scalar;
+	typedef Vector::Lanes<T,size> Packed;
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::vector<V> a(Count), b(Count);
+	for(int i=0;i<Count;i++)
+		for(int j=0;j<size;j++) a[i][j] = T(u(random)), b[i][j] = T(u(random));
+	const T r = T(1.0001);
+
+	// scalar loops against the Simd::Pack kernels over the same storage //
+	const double add[2] = {
+		Benchmarks::Measure([&]() { for(int i=0;i<Count;i++) Scalar::Add(&a[i], &b[i]); Benchmarks::Keep(a[0][0]); }),
+		Benchmarks::Measure([&]() { for(int i=0;i<Count;i++) Packed::Add(&a[i], &b[i]); Benchmarks::Keep(a[0][0]); })
+	};
+	const double scale[2] = {
+		Benchmarks::Measure([&]() { for(int i=0;i<Count;i++) Scalar::Scale(&a[i], r); Benchmarks::Keep(a[0][0]); }),
+		Benchmarks::Measure([&]() { for(int i=0;i<Count;i++) Packed::Scale(&a[i], r); Benchmarks::Keep(a[0][0]); })
+	};
+	const double dot[2] = {
+		Benchmarks::Measure([&]() { T s = 0; for(int i=0;i<Count;i++) s += Scalar::Dot(&a[i], &b[i]); Benchmarks::Keep(s); }),
+		Benchmarks::Measure([&]() { T s = 0; for(int i=0;i<Count;i++) s += Packed::Dot(&a[i], &b[i]); Benchmarks::Keep(s); })
+	};
+	std::printf("%-6s %d  add %7.2f / %7.2f ns  scale %7.2f / %7.2f ns  dot %7.2f / %7.2f ns  (scalar / simd per vector)\n", type, size,
+		1e9*add[0]/Count, 1e9*add[1]/Count, 1e9*scale[0]/Count, 1e9*scale[1]/Count, 1e9*dot[0]/Count, 1e9*dot[1]/Count);
+}
+
+void Cross(std::mt19937 & random) {
+	std::uniform_real_distribution<float> u(-1, 1);
+	std::vector< Vector::Template<float,3> > a(Count), b(Count), c(Count);
+	for(int i=0;i<Count;i++)
+		for(int j=0;j<3;j++) a[i][j] = u(random), b[i][j] = u(random);
+	const double scalar = Benchmarks::Measure([&]() { for(int i=0;i<Count;i++) c[i] = Vector::Cross<float>(a[i], b[i]); Benchmarks::Keep(c[Count/2][0]); });
+	const double simd = Benchmarks::Measure([&]() { for(int i=0;i<Count;i++) c[i] = Vector::Cross(a[i], b[i]); Benchmarks::Keep(c[Count/2][0]); });
+	std::printf("float  3  cross %7.2f / %7.2f ns\n", 1e9*scalar/Count, 1e9*simd/Count);
+}
+
+int main() {
+	std::mt19937 random(11);
+	Run<float,2>("float", random);
+	Run<float,3>("float", random);
+	Run<float,4>("float", random);
+	Run<double,2>("double", random);
+	Run<double,3>("double", random);
+	Run<double,4>("double", random);
+	Cross(random);
+	return 0;
+}
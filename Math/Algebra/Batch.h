@@ -0,0 +1,269 @@
+#pragma once
+
+#ifndef MATH_BATCH
+#define MATH_BATCH
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Parallel.h>
+#include <Math/Algebra/Vector.h>
+
+#include <vector>
+
+namespace Math {
+	namespace Vector {
+		namespace Kernel {
+
+			// ranges longer than this are split across Parallel workers //
+			const size_t BatchGrain = 1 << 14;
+
+			// calls body(i, Pack<T,W>()) for every whole register of lanes in [first,last) and body(i, Pack<T,1>()) for the tail //
+			template<typename T, typename Body>
+			void Sweep(size_t first, size_t last, Body body) {
+				const size_t W = Simd::Width<T>::value;
+				size_t i = first;
+				for(;i+W<=last;i+=W) body(i, Simd::Pack<T,Simd::Width<T>::value>());
+				for(;i<last;i++) body(i, Simd::Pack<T,1>());
+			}
+
+			template<typename T, typename Body>
+			void Sweep(size_t count, Body body) {
+				if( count <= BatchGrain ) return Sweep<T>(0, count, body);
+				Parallel::For(0, count, BatchGrain, [&](size_t first, size_t last) { Sweep<T>(first, last, body); });
+			}
+		}
+
+		// structure of arrays: component c of element i lives at Component(c)[i], each component array 64 byte aligned //
+		template<typename T, int size>
+		class Batch {
+			static_assert(std::is_floating_point<T>::value, "Vector::Batch holds float or double components");
+		public:
+			Batch(size_t count =0): e(nullptr), count(0), stride(0) { Resize(count); }
+
+			Batch(const Template<T,size> * v, size_t count): e(nullptr), count(0), stride(0) { Assign(v, count); }
+			Batch(const std::vector< Template<T,size> > & v): e(nullptr), count(0), stride(0) { Assign(v.data(), v.size()); }
+
+			Batch(const Batch<T,size> & u): e(nullptr), count(0), stride(0) { operator=(u); }
+
+			Batch(Batch<T,size> && u) noexcept : e(u.e), count(u.count), stride(u.stride) {
+				u.e = nullptr;
+				u.count = u.stride = 0;
+			}
+
+			~Batch() { AlignedFree(e); }
+
+			int GetSize() const { return size; }
+			size_t GetCount() const { return count; }
+
+			// contents are discarded when the count changes //
+			void Resize(size_t n) {
+				if( n == count ) return;
+				const size_t s = (n + 15)/16*16;
+				if( s != stride ){
+					AlignedFree(e);
+					e = AlignedAlloc<T>(s*size);
+					stride = s;
+				}
+				count = n;
+				for(size_t i=0;i<stride*size;i++) e[i] = T(0);
+			}
+
+			T * Component(int c) { return e + c*stride; }
+			const T * Component(int c) const { return e + c*stride; }
+
+			Template<T,size> operator [] (size_t i) const {
+				Template<T,size> v;
+				for(int c=0;c<size;c++) v[c] = e[c*stride+i];
+				return v;
+			}
+
+			void Set(size_t i, const Template<T,size> & v) {
+				for(int c=0;c<size;c++) e[c*stride+i] = v[c];
+			}
+
+			// transposes count array of structs vectors in, one pass over the input //
+			void Assign(const Template<T,size> * v, size_t n) {
+				Resize(n);
+				size_t i = Transpose(v, n);
+				for(;i<n;i++) Set(i, v[i]);
+			}
+
+			// writes the vectors back out in array of structs order, out must hold GetCount() elements //
+			void Extract(Template<T,size> * out) const {
+				size_t i = Transpose(out);
+				for(;i<count;i++) out[i] = operator[](i);
+			}
+
+			// reuses the storage of out when it already has the right length //
+			void Extract(std::vector< Template<T,size> > & out) const {
+				out.resize(count);
+				Extract(out.data());
+			}
+
+			std::vector< Template<T,size> > ToVector() const {
+				std::vector< Template<T,size> > out;
+				Extract(out);
+				return out;
+			}
+
+			Batch<T,size> & operator = (const Batch<T,size> & u) {
+				if( this == &u ) return *this;
+				Resize(u.count);
+				for(size_t i=0;i<stride*size;i++) e[i] = u.e[i];
+				return *this;
+			}
+
+			Batch<T,size> & operator = (Batch<T,size> && u) noexcept {
+				std::swap(e,u.e);
+				std::swap(count,u.count);
+				std::swap(stride,u.stride);
+				return *this;
+			}
+
+			void GetLength(T * out) const {
+				const T * s = e;
+				const size_t n = stride;
+				Kernel::Sweep<T>(count, [=](size_t i, auto p) {
+					typedef decltype(p) P;
+					P sum = P::Load(s+i)*P::Load(s+i);
+					for(int c=1;c<size;c++) sum = Simd::MultiplyAdd(P::Load(s+c*n+i), P::Load(s+c*n+i), sum);
+					Simd::Sqrt(sum).Store(out+i);
+				});
+			}
+
+			// angle between element i of this and of u, 0 where either is zero //
+			void GetAngle(const Batch<T,size> & u, T * out) const {
+				assert(count == u.count);
+				const T * s = e, * t = u.e;
+				const size_t n = stride;
+				Kernel::Sweep<T>(count, [=](size_t i, auto p) {
+					typedef decltype(p) P;
+					P dot = P::Load(s+i)*P::Load(t+i), ss = P::Load(s+i)*P::Load(s+i), tt = P::Load(t+i)*P::Load(t+i);
+					for(int c=1;c<size;c++){
+						const P a = P::Load(s+c*n+i), b = P::Load(t+c*n+i);
+						dot = Simd::MultiplyAdd(a,b,dot), ss = Simd::MultiplyAdd(a,a,ss), tt = Simd::MultiplyAdd(b,b,tt);
+					}
+					(dot/Simd::Sqrt(ss*tt)).Store(out+i);
+					for(int l=0;l<P::Lanes();l++) out[i+l] = ss[l] == T(0) or tt[l] == T(0) ? T(0) : std::acos(Max(Min(out[i+l], T(1)), T(-1)));
+				});
+			}
+
+			// scales every element to unit length, zero elements stay zero //
+			void Normalize() {
+				T * s = e;
+				const size_t n = stride;
+				Kernel::Sweep<T>(count, [=](size_t i, auto p) {
+					typedef decltype(p) P;
+					P sum = P::Load(s+i)*P::Load(s+i);
+					for(int c=1;c<size;c++) sum = Simd::MultiplyAdd(P::Load(s+c*n+i), P::Load(s+c*n+i), sum);
+					const P inverse = P(T(1))/Simd::Max(Simd::Sqrt(sum), P(std::numeric_limits<T>::min()));
+					for(int c=0;c<size;c++) (P::Load(s+c*n+i)*inverse).Store(s+c*n+i);
+				});
+			}
+
+		protected:
+			// 4 lane float vectors go through an SSE 4x4 transpose, returns how many elements were handled //
+			size_t Transpose(const Template<T,size> * v, size_t n) { return TransposeIn(v, n, std::integral_constant<bool, Packed>()); }
+			size_t Transpose(Template<T,size> * out) const { return TransposeOut(out, std::integral_constant<bool, Packed>()); }
+
+			size_t TransposeIn(const Template<T,size> *, size_t, std::false_type) { return 0; }
+			size_t TransposeOut(Template<T,size> *, std::false_type) const { return 0; }
+
+#ifdef MATH_SIMD_SSE
+			enum { Packed = std::is_same<T,float>::value and Storage<T,size>::lanes == 4 and sizeof(Template<T,size>) == 4*sizeof(T) };
+
+			size_t TransposeIn(const Template<T,size> * v, size_t n, std::true_type) {
+				const float * in = reinterpret_cast<const float *>(v);
+				size_t i = 0;
+				for(;i+4<=n;i+=4){
+					__m128 r0 = _mm_loadu_ps(in+4*i), r1 = _mm_loadu_ps(in+4*i+4), r2 = _mm_loadu_ps(in+4*i+8), r3 = _mm_loadu_ps(in+4*i+12);
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+					const __m128 rows[4] = { r0, r1, r2, r3 };
+					for(int c=0;c<size;c++) _mm_storeu_ps(reinterpret_cast<float *>(e) + c*stride + i, rows[c]);
+				}
+				return i;
+			}
+
+			size_t TransposeOut(Template<T,size> * v, std::true_type) const {
+				float * out = reinterpret_cast<float *>(v);
+				const float * s = reinterpret_cast<const float *>(e);
+				size_t i = 0;
+				for(;i+4<=count;i+=4){
+					__m128 r0 = _mm_loadu_ps(s+i), r1 = _mm_loadu_ps(s+stride+i), r2 = _mm_loadu_ps(s+2*stride+i);
+					__m128 r3 = size == 4 ? _mm_loadu_ps(s+3*stride+i) : _mm_setzero_ps();
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+					_mm_storeu_ps(out+4*i, r0), _mm_storeu_ps(out+4*i+4, r1), _mm_storeu_ps(out+4*i+8, r2), _mm_storeu_ps(out+4*i+12, r3);
+				}
+				return i;
+			}
+#else
+			enum { Packed = false };
+#endif
+
+			T * e;
+			size_t count, stride;
+		};
+
+		typedef Batch<float,2> Batch2f;
+		typedef Batch<float,3> Batch3f;
+		typedef Batch<float,4> Batch4f;
+
+		typedef Batch<double,2> Batch2;
+		typedef Batch<double,3> Batch3;
+		typedef Batch<double,4> Batch4;
+
+		// out[i] = u[i]*v[i] //
+		template<typename T, int size>
+		void Dot(const Batch<T,size> & u, const Batch<T,size> & v, T * out) {
+			assert(u.GetCount() == v.GetCount());
+			Kernel::Sweep<T>(u.GetCount(), [&](size_t i, auto p) {
+				typedef decltype(p) P;
+				P sum = P::Load(u.Component(0)+i)*P::Load(v.Component(0)+i);
+				for(int c=1;c<size;c++) sum = Simd::MultiplyAdd(P::Load(u.Component(c)+i), P::Load(v.Component(c)+i), sum);
+				sum.Store(out+i);
+			});
+		}
+
+		// out[i] = Cross(A[i],B[i]), out may be A or B //
+		template<typename T>
+		void Cross(const Batch<T,3> & A, const Batch<T,3> & B, Batch<T,3> & out) {
+			assert(A.GetCount() == B.GetCount());
+			if( &out != &A and &out != &B ) out.Resize(A.GetCount());
+			const T * ax = A.Component(0), * ay = A.Component(1), * az = A.Component(2);
+			const T * bx = B.Component(0), * by = B.Component(1), * bz = B.Component(2);
+			T * cx = out.Component(0), * cy = out.Component(1), * cz = out.Component(2);
+			Kernel::Sweep<T>(A.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				const P x0 = P::Load(ax+i), y0 = P::Load(ay+i), z0 = P::Load(az+i);
+				const P x1 = P::Load(bx+i), y1 = P::Load(by+i), z1 = P::Load(bz+i);
+				(y0*z1 - z0*y1).Store(cx+i);
+				(z0*x1 - x0*z1).Store(cy+i);
+				(x0*y1 - y0*x1).Store(cz+i);
+			});
+		}
+
+		// out[i] = IsOrtho(u[i],v[i]) //
+		template<typename P =Policy::Default, typename T, int size>
+		void IsOrtho(const Batch<T,size> & u, const Batch<T,size> & v, bool * out) {
+			Kernel::Sweep<T>(u.GetCount(), [&](size_t i, auto p) {
+				typedef decltype(p) Pack;
+				Pack sum = Pack::Load(u.Component(0)+i)*Pack::Load(v.Component(0)+i);
+				for(int c=1;c<size;c++) sum = Simd::MultiplyAdd(Pack::Load(u.Component(c)+i), Pack::Load(v.Component(c)+i), sum);
+				for(int l=0;l<Pack::Lanes();l++) out[i+l] = Equals<T,P>(sum[l], T());
+			});
+		}
+
+		// y[i] += a*x[i] //
+		template<typename T, int size>
+		void Axpy(T a, const Batch<T,size> & x, Batch<T,size> & y) {
+			assert(x.GetCount() == y.GetCount());
+			Kernel::Sweep<T>(x.GetCount(), [&](size_t i, auto p) {
+				typedef decltype(p) P;
+				const P alpha(a);
+				for(int c=0;c<size;c++) Simd::MultiplyAdd(alpha, P::Load(x.Component(c)+i), P::Load(y.Component(c)+i)).Store(y.Component(c)+i);
+			});
+		}
+	}
+}
+
+#endif // ending MATH_BATCH //
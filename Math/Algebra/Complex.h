@@ -4,80 +4,305 @@
 #define MATH_COMPLEX
 
 #include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Elementary.h>
+#include <Math/Algebra/Batch.h>
+
+#include <limits>
 
 namespace Math {
 	namespace Complex {
 		template<typename T>
 		class Template {
 		public:
-			Template(T const & x=T(), T const & y=T()) {
-				e[0] = x;
-				e[1] = y;
-			}
-			~Template() {}
+			constexpr Template(T const & x=T(), T const & y=T()): e{x,y} {}
 
-			T Real() const { return e[0]; }
-			T Complex() const { return e[1]; }
-			typename Template<T> Conjugate() const { return Template<T>(e[0],-e[1]); }
-			float Magnitude() const { return sqrtf( operator*(Conjugate()) ); }
+			constexpr T Real() const { return e[0]; }
+			constexpr T Complex() const { return e[1]; }
+			constexpr Template<T> Conjugate() const { return Template<T>(e[0],-e[1]); }
+			constexpr T Norm() const { return e[0]*e[0] + e[1]*e[1]; }
+			typename Math::Real<T>::Type Magnitude() const {
+				typedef typename Math::Real<T>::Type Type;
+				return std::sqrt( Type(e[0])*Type(e[0]) + Type(e[1])*Type(e[1]) );
+			}
 			std::string ToString() const { return std::to_string(e[0]) + " + " + std::to_string(e[1]) + "i"; }
 
-			T & operator [] (uint32_t i) { return e[i]; }
-			const T & operator [] (uint32_t i) const { return e[i]; }
+			constexpr T & operator [] (uint32_t i) { return e[i]; }
+			constexpr const T & operator [] (uint32_t i) const { return e[i]; }
 
-			T * operator & () { return e; }
-			const T * operator & () const { return e; }
+			constexpr T * operator & () { return e; }
+			constexpr const T * operator & () const { return e; }
 
-			bool operator == (const Template<T> & c) const {
+			constexpr bool operator == (const Template<T> & c) const {
 				return	e[0] == c.e[0]
 				and	e[1] == c.e[1];
 			}
 
-			bool operator != (const Template<T> & c) const { return !operator==(c); }
+			constexpr bool operator != (const Template<T> & c) const { return !operator==(c); }
 
-			typename Template<T> & operator = (const Template<T> & c) {
-				e[0] = c.e[0];
-				e[1] = c.e[1];
-				return *this;
-			}
-
-			typename Template<T> & operator += (const Template<T> & c) {
+			constexpr Template<T> & operator += (const Template<T> & c) {
 				e[0] += c.e[0];
 				e[1] += c.e[1];
 				return *this;
 			}
 
-			typename Template<T> & operator -= (const Template<T> & c) {
+			constexpr Template<T> & operator -= (const Template<T> & c) {
 				e[0] -= c.e[0];
 				e[1] -= c.e[1];
 				return *this;
 			}
 
-			typename Template<T> & operator *= (const Template<T> & c) {
-				Template<T> u = *this;
-				e[0] = u[0]*c.e[0] - u[1]*c.e[1];
-				e[1] = u[1]*c.e[0] + u[0]*c.e[1];
+			constexpr Template<T> & operator *= (const Template<T> & c) {
+				const T re = e[0]*c.e[0] - e[1]*c.e[1];
+				e[1] = e[1]*c.e[0] + e[0]*c.e[1];
+				e[0] = re;
 				return *this;
 			}
 
-			typename Template<T> & operator + (const Template<T> & c) const {
-				Template<T> u = *this;
-				return u += c;
+			constexpr Template<T> operator + (const Template<T> & c) const { return Template<T>(e[0] + c.e[0], e[1] + c.e[1]); }
+			constexpr Template<T> operator - (const Template<T> & c) const { return Template<T>(e[0] - c.e[0], e[1] - c.e[1]); }
+			constexpr Template<T> operator * (const Template<T> & c) const { return Template<T>(e[0]*c.e[0] - e[1]*c.e[1], e[1]*c.e[0] + e[0]*c.e[1]); }
+		protected:
+			T e[2];
+		};
+
+		// Interleaved keeps real and imaginary parts side by side as in Complex::Template, Split keeps them in two planes //
+		enum class Layout {
+			Interleaved,
+			Split
+		};
+
+		// count complex values over one 64 byte aligned block, part c of value i is at Part(c)[i*Step()] in either layout //
+		// the bulk kernels below run whole Simd::Pack registers of values in every layout, Split parts load straight into //
+		// registers and Interleaved ones are split apart and put back together by Simd::Deinterleave and Simd::Interleave //
+		template<typename T>
+		class Buffer {
+			static_assert(std::is_floating_point<T>::value, "Complex::Buffer holds float or double parts");
+		public:
+			Buffer(size_t count =0, Layout layout =Layout::Split): e(nullptr), count(0), stride(0), layout(layout) { Resize(count); }
+
+			Buffer(const Template<T> * values, size_t count, Layout layout =Layout::Split): e(nullptr), count(0), stride(0), layout(layout) {
+				Resize(count);
+				for(size_t i=0;i<count;i++) Set(i, values[i]);
+			}
+
+			Buffer(const Buffer<T> & u): e(nullptr), count(0), stride(0), layout(u.layout) { operator=(u); }
+
+			Buffer(Buffer<T> && u) noexcept : e(u.e), count(u.count), stride(u.stride), layout(u.layout) {
+				u.e = nullptr;
+				u.count = u.stride = 0;
+			}
+
+			~Buffer() { AlignedFree(e); }
+
+			size_t GetCount() const { return count; }
+			Layout GetLayout() const { return layout; }
+			size_t Step() const { return layout == Layout::Split ? 1 : 2; }
+
+			// contents are zeroed when the count changes //
+			void Resize(size_t n) {
+				if( n == count and e ) return;
+				const size_t s = (n + 15)/16*16;
+				if( s != stride or !e ){
+					AlignedFree(e);
+					e = AlignedAlloc<T>(2*s);
+					stride = s;
+				}
+				count = n;
+				for(size_t i=0;i<2*stride;i++) e[i] = T(0);
+			}
+
+			// rearranges the values into the other layout, one pass through a second block //
+			void Convert(Layout to) {
+				if( to == layout ) return;
+				Buffer<T> converted(count, to);
+				for(size_t i=0;i<count;i++) converted.Set(i, operator[](i));
+				std::swap(e, converted.e);
+				layout = to;
+			}
+
+			T * Part(int c) { return layout == Layout::Split ? e + c*stride : e + c; }
+			const T * Part(int c) const { return layout == Layout::Split ? e + c*stride : e + c; }
+
+			// the values as Complex::Template, for the FFT and other array of structs code, Interleaved only //
+			Template<T> * Data() {
+				assert(layout == Layout::Interleaved);
+				return reinterpret_cast<Template<T> *>(e);
+			}
+
+			const Template<T> * Data() const {
+				assert(layout == Layout::Interleaved);
+				return reinterpret_cast<const Template<T> *>(e);
 			}
 
-			typename Template<T> & operator - (const Template<T> & c) const {
-				Template<T> u = *this;
-				return u -= c;
+			Template<T> operator [] (size_t i) const { return Template<T>(Part(0)[i*Step()], Part(1)[i*Step()]); }
+
+			void Set(size_t i, const Template<T> & c) {
+				Part(0)[i*Step()] = c[0];
+				Part(1)[i*Step()] = c[1];
 			}
 
-			typename Template<T> & operator * (const Template<T> & c) const {
-				Template<T> u = *this;
-				return u *= c;
+			Buffer<T> & operator = (const Buffer<T> & u) {
+				if( this == &u ) return *this;
+				if( layout != u.layout ) AlignedFree(e), e = nullptr, layout = u.layout;
+				Resize(u.count);
+				for(size_t i=0;i<2*stride;i++) e[i] = u.e[i];
+				return *this;
 			}
+
+			Buffer<T> & operator = (Buffer<T> && u) noexcept {
+				std::swap(e,u.e);
+				std::swap(count,u.count);
+				std::swap(stride,u.stride);
+				std::swap(layout,u.layout);
+				return *this;
+			}
+
 		protected:
-			T e[2];
+			T * e;
+			size_t count, stride;
+			Layout layout;
 		};
 
+		namespace Kernel {
+			// real and imaginary parts of the values from i on as registers of P, step is Buffer::Step() of the parts //
+			template<typename P, typename T>
+			void Load(const T * re, const T * im, size_t step, size_t i, P & r, P & m) {
+				if( step == 1 ) r = P::Load(re+i), m = P::Load(im+i);
+				else Simd::Deinterleave(re+2*i, r, m);
+			}
+
+			template<typename P, typename T>
+			void Store(T * re, T * im, size_t step, size_t i, const P & r, const P & m) {
+				if( step == 1 ) r.Store(re+i), m.Store(im+i);
+				else Simd::Interleave(re+2*i, r, m);
+			}
+		}
+
+		// out[i] = a[i]*b[i], out may be a or b, the three may differ in layout //
+		template<typename T>
+		void Multiply(const Buffer<T> & a, const Buffer<T> & b, Buffer<T> & out) {
+			assert(a.GetCount() == b.GetCount());
+			out.Resize(a.GetCount());
+			const T * ar = a.Part(0), * ai = a.Part(1), * br = b.Part(0), * bi = b.Part(1);
+			T * orr = out.Part(0), * oi = out.Part(1);
+			const size_t sa = a.Step(), sb = b.Step(), so = out.Step();
+			Vector::Kernel::Sweep<T>(a.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				P xr, xi, yr, yi;
+				Kernel::Load(ar, ai, sa, i, xr, xi);
+				Kernel::Load(br, bi, sb, i, yr, yi);
+				Kernel::Store(orr, oi, so, i, Simd::MultiplyAdd(xr, yr, -(xi*yi)), Simd::MultiplyAdd(xi, yr, xr*yi));
+			});
+		}
+
+		// out[i] = a[i]*conj(b[i]), the cross spectrum of a correlation //
+		template<typename T>
+		void MultiplyConjugate(const Buffer<T> & a, const Buffer<T> & b, Buffer<T> & out) {
+			assert(a.GetCount() == b.GetCount());
+			out.Resize(a.GetCount());
+			const T * ar = a.Part(0), * ai = a.Part(1), * br = b.Part(0), * bi = b.Part(1);
+			T * orr = out.Part(0), * oi = out.Part(1);
+			const size_t sa = a.Step(), sb = b.Step(), so = out.Step();
+			Vector::Kernel::Sweep<T>(a.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				P xr, xi, yr, yi;
+				Kernel::Load(ar, ai, sa, i, xr, xi);
+				Kernel::Load(br, bi, sb, i, yr, yi);
+				Kernel::Store(orr, oi, so, i, Simd::MultiplyAdd(xr, yr, xi*yi), Simd::MultiplyAdd(xi, yr, -(xr*yi)));
+			});
+		}
+
+		// out[i] = |a[i]| //
+		template<typename T>
+		void Magnitude(const Buffer<T> & a, T * out) {
+			const T * ar = a.Part(0), * ai = a.Part(1);
+			const size_t sa = a.Step();
+			Vector::Kernel::Sweep<T>(a.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				P xr, xi;
+				Kernel::Load(ar, ai, sa, i, xr, xi);
+				Simd::Sqrt(Simd::MultiplyAdd(xr, xr, xi*xi)).Store(out+i);
+			});
+		}
+
+		// out[i] = arg a[i] in [-pi,pi] as std::atan2 gives it, through the Precise Batch::ArcTan polynomial //
+		template<typename T>
+		void Phase(const Buffer<T> & a, T * out) {
+			const T * ar = a.Part(0), * ai = a.Part(1);
+			const size_t sa = a.Step();
+			const T infinity = std::numeric_limits<T>::infinity();
+			Vector::Kernel::Sweep<T>(a.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				P xr, xi;
+				Kernel::Load(ar, ai, sa, i, xr, xi);
+				const P ratio = xi/xr;
+				P angle;
+				Batch::Kernel::ArcTan<T,false>(ratio, angle);
+				// the left half plane is a half turn away, towards the sign of the imaginary part //
+				const P turn = Simd::Select(Simd::Less(xi, P(T(0))), P(-Pi<T>()), P(Pi<T>()));
+				angle = Simd::Select(Simd::Less(xr, P(T(0))), angle + turn, angle);
+				// zeros and infinities are left to libm, a -0 imaginary part on the negative real axis gives pi rather than -pi //
+				if( Simd::Any(Simd::Outside(ratio, P(-infinity), P(infinity))) or Simd::Any(Simd::Outside(xr, P(-infinity), P(infinity))) )
+					for(int l=0;l<P::Lanes();l++) angle[l] = std::atan2(xi[l], xr[l]);
+				angle.Store(out+i);
+			});
+		}
+
+		// y[i] += alpha*x[i] //
+		template<typename T>
+		void Axpy(const Template<T> & alpha, const Buffer<T> & x, Buffer<T> & y) {
+			assert(x.GetCount() == y.GetCount());
+			const T * xr = x.Part(0), * xi = x.Part(1);
+			T * yr = y.Part(0), * yi = y.Part(1);
+			const size_t sx = x.Step(), sy = y.Step();
+			const T cr = alpha[0], ci = alpha[1];
+			Vector::Kernel::Sweep<T>(x.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				P ur, ui, vr, vi;
+				Kernel::Load(xr, xi, sx, i, ur, ui);
+				Kernel::Load(yr, yi, sy, i, vr, vi);
+				Kernel::Store(yr, yi, sy, i, Simd::MultiplyAdd(P(cr), ur, Simd::MultiplyAdd(P(-ci), ui, vr)), Simd::MultiplyAdd(P(cr), ui, Simd::MultiplyAdd(P(ci), ur, vi)));
+			});
+		}
+
+		namespace Kernel {
+			// sum of a[i]*b[i], or of conj(a[i])*b[i] with conjugate set, lane sums kept apart until the end //
+			template<typename T>
+			Template<T> Dot(const Buffer<T> & a, const Buffer<T> & b, bool conjugate) {
+				assert(a.GetCount() == b.GetCount());
+				typedef Simd::Pack<T> P;
+				const T * ar = a.Part(0), * ai = a.Part(1), * br = b.Part(0), * bi = b.Part(1);
+				const size_t sa = a.Step(), sb = b.Step(), n = a.GetCount(), W = Simd::Width<T>::value;
+				const T sign = conjugate ? T(-1) : T(1);
+				P re(T(0)), im(T(0));
+				size_t i = 0;
+				for(;i+W<=n;i+=W){
+					P xr, xi, yr, yi;
+					Load(ar, ai, sa, i, xr, xi);
+					Load(br, bi, sb, i, yr, yi);
+					xi *= P(sign);
+					re = Simd::MultiplyAdd(xr, yr, Simd::MultiplyAdd(-xi, yi, re));
+					im = Simd::MultiplyAdd(xr, yi, Simd::MultiplyAdd(xi, yr, im));
+				}
+				T sr = Simd::Sum(re), si = Simd::Sum(im);
+				for(;i<n;i++){
+					const T xr = ar[i*sa], xi = sign*ai[i*sa], yr = br[i*sb], yi = bi[i*sb];
+					sr += xr*yr - xi*yi;
+					si += xr*yi + xi*yr;
+				}
+				return Template<T>(sr, si);
+			}
+		}
+
+		// sum of a[i]*b[i] //
+		template<typename T>
+		Template<T> Dot(const Buffer<T> & a, const Buffer<T> & b) { return Kernel::Dot(a, b, false); }
+
+		// sum of conj(a[i])*b[i], the inner product //
+		template<typename T>
+		Template<T> DotConjugate(const Buffer<T> & a, const Buffer<T> & b) { return Kernel::Dot(a, b, true); }
+
 		typedef Template<float> Float;
 		typedef Template<double> Double;
 		typedef Template<long double> LDouble;
@@ -92,4 +317,4 @@ namespace Math {
 	}
 }
 
-#endif // ending MATH_COMPLEX //
\ No newline at end of file
+#endif // ending MATH_COMPLEX //
@@ -0,0 +1,253 @@
+#pragma once
+
+#ifndef MATH_EIGEN
+#define MATH_EIGEN
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Parallel.h>
+#include <Math/Elementary.h>
+#include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Matrix.h>
+#include <Math/Algebra/Batch.h>
+
+#include <algorithm>
+#include <limits>
+
+// eigen decompositions of real symmetric matrices //
+namespace Math {
+	namespace Eigen {
+
+		// values in increasing order, vectors[i] is the unit eigenvector of values[i] and the rows are orthonormal //
+		template<typename T, int N>
+		struct Decomposition {
+			Vector::Template<T,N> values;
+			Matrix::Template<T,N,N> vectors;
+		};
+
+		namespace Kernel {
+			// cyclic sweeps before Jacobi gives up, convergence is quadratic and a handful is the norm //
+			const int JacobiSweeps = 64;
+
+			// row major symmetric n x n block a is diagonalized in place by cyclic Jacobi rotations, //
+			// the columns of the n x n block v collect the eigenvectors //
+			template<typename T>
+			void Jacobi(T * a, T * v, int n) {
+				for(int i=0;i<n;i++)
+					for(int j=0;j<n;j++) v[i*n+j] = i == j ? T(1) : T(0);
+
+				for(int sweep=0;sweep<JacobiSweeps;sweep++){
+					T off = T(0);
+					for(int p=0;p<n;p++)
+						for(int q=p+1;q<n;q++) off += Abs(a[p*n+q]);
+					if( off == T(0) ) return;
+
+					for(int p=0;p<n;p++){
+						for(int q=p+1;q<n;q++){
+							const T apq = a[p*n+q], app = a[p*n+p], aqq = a[q*n+q];
+							if( apq == T(0) ) continue;
+
+							// once the sweeps have settled, an entry too small to move either diagonal is dropped //
+							if( sweep > 3 and Abs(app) + T(100)*Abs(apq) == Abs(app) and Abs(aqq) + T(100)*Abs(apq) == Abs(aqq) ){
+								a[p*n+q] = a[q*n+p] = T(0);
+								continue;
+							}
+
+							// t = tan of the angle that zeroes a[p][q], the smaller root so the rotation stays below pi/4 //
+							const T theta = (aqq - app)/(T(2)*apq);
+							T t = T(1)/(Abs(theta) + std::sqrt(theta*theta + T(1)));
+							if( Abs(theta) > T(1)/std::numeric_limits<T>::epsilon() ) t = T(0.5)/Abs(theta);
+							if( theta < T(0) ) t = -t;
+							const T c = T(1)/std::sqrt(t*t + T(1)), s = t*c;
+
+							for(int k=0;k<n;k++){
+								const T kp = a[k*n+p], kq = a[k*n+q];
+								a[k*n+p] = c*kp - s*kq;
+								a[k*n+q] = s*kp + c*kq;
+							}
+							for(int k=0;k<n;k++){
+								const T pk = a[p*n+k], qk = a[q*n+k];
+								a[p*n+k] = c*pk - s*qk;
+								a[q*n+k] = s*pk + c*qk;
+							}
+							a[p*n+p] = app - t*apq;
+							a[q*n+q] = aqq + t*apq;
+							a[p*n+q] = a[q*n+p] = T(0);
+
+							for(int k=0;k<n;k++){
+								const T kp = v[k*n+p], kq = v[k*n+q];
+								v[k*n+p] = c*kp - s*kq;
+								v[k*n+q] = s*kp + c*kq;
+							}
+						}
+					}
+				}
+			}
+
+			// eigenvalue gap, relative to the largest entry, below which the cross products lose too many digits, //
+			// their error grows as epsilon over the gap //
+			template<typename T>
+			T Separation() { return std::cbrt(std::numeric_limits<T>::epsilon()); }
+
+			// the unit vector along the longest of the three cross products of rows of A - lambda I //
+			template<typename T, typename P>
+			void NullVector(const P * a, const P & lambda, P * out) {
+				const P r0[3] = {a[0] - lambda, a[1], a[2]}, r1[3] = {a[1], a[3] - lambda, a[4]}, r2[3] = {a[2], a[4], a[5] - lambda};
+				const P c01[3] = {r0[1]*r1[2] - r0[2]*r1[1], r0[2]*r1[0] - r0[0]*r1[2], r0[0]*r1[1] - r0[1]*r1[0]};
+				const P c02[3] = {r0[1]*r2[2] - r0[2]*r2[1], r0[2]*r2[0] - r0[0]*r2[2], r0[0]*r2[1] - r0[1]*r2[0]};
+				const P c12[3] = {r1[1]*r2[2] - r1[2]*r2[1], r1[2]*r2[0] - r1[0]*r2[2], r1[0]*r2[1] - r1[1]*r2[0]};
+				const P n01 = c01[0]*c01[0] + c01[1]*c01[1] + c01[2]*c01[2];
+				const P n02 = c02[0]*c02[0] + c02[1]*c02[1] + c02[2]*c02[2];
+				const P n12 = c12[0]*c12[0] + c12[1]*c12[1] + c12[2]*c12[2];
+
+				const P take02 = Simd::Less(n01, n02);
+				P best = Simd::Select(take02, n02, n01);
+				for(int i=0;i<3;i++) out[i] = Simd::Select(take02, c02[i], c01[i]);
+				const P take12 = Simd::Less(best, n12);
+				best = Simd::Select(take12, n12, best);
+				for(int i=0;i<3;i++) out[i] = Simd::Select(take12, c12[i], out[i]);
+
+				const P inverse = P(T(1))/Simd::Sqrt(Simd::Select(Simd::Less(best, P(std::numeric_limits<T>::min())), P(T(1)), best));
+				for(int i=0;i<3;i++) out[i] = out[i]*inverse;
+			}
+
+			// closed form over P lanes of symmetric 3x3 matrices given by a = (a00, a01, a02, a11, a12, a22) //
+			// eigenvalues from the trigonometric solution of the characteristic cubic (Smith 1961), the extreme eigenvectors //
+			// from cross products and the middle one as their cross product, degenerate marks the lanes with a repeated //
+			// or an eigenvalue gap below Separation, whose vectors the caller must find another way //
+			template<typename T, typename P>
+			void Symmetric(const P * m, P * values, P * vectors, P & degenerate) {
+				// scaled to unit largest entry so the cubes below neither overflow nor underflow //
+				P scale = Simd::Abs(m[0]);
+				for(int i=1;i<6;i++) scale = Simd::Max(scale, Simd::Abs(m[i]));
+				const P zero = Simd::Less(scale, P(std::numeric_limits<T>::min()));
+				scale = Simd::Select(zero, P(T(1)), scale);
+				const P inverse = P(T(1))/scale;
+				P a[6];
+				for(int i=0;i<6;i++) a[i] = m[i]*inverse;
+
+				const P q = (a[0] + a[3] + a[5])*P(T(1)/T(3));
+				const P b0 = a[0] - q, b3 = a[3] - q, b5 = a[5] - q;
+				const P p2 = (b0*b0 + b3*b3 + b5*b5 + P(T(2))*(a[1]*a[1] + a[2]*a[2] + a[4]*a[4]))*P(T(1)/T(6));
+				const P p = Simd::Sqrt(p2);
+				const P flat = Simd::Less(p, P(std::numeric_limits<T>::min()));
+				const P pinverse = Simd::Select(flat, P(T(0)), P(T(1))/Simd::Select(flat, P(T(1)), p));
+
+				// r = det(B/p)/2 = cos(3 phi) //
+				const P det = b0*(b3*b5 - a[4]*a[4]) - a[1]*(a[1]*b5 - a[4]*a[2]) + a[2]*(a[1]*a[4] - b3*a[2]);
+				const P r = Simd::Min(Simd::Max(P(T(0.5))*det*pinverse*pinverse*pinverse, P(T(-1))), P(T(1)));
+
+				// acos r = atan(sqrt(1 - r^2)/|r|) folded by the sign of r, the ratio is +inf at r = 0 which atan takes //
+				P angle, sine, cosine;
+				Math::Batch::Kernel::ArcTan<T,false>(Simd::Sqrt(Simd::Max(P(T(1)) - r*r, P(T(0))))/Simd::Abs(r), angle);
+				angle = Simd::Select(Simd::Less(r, P(T(0))), P(Pi<T>()) - angle, angle);
+				Math::Batch::Kernel::SinCos<T,false>(angle*P(T(1)/T(3)), sine, cosine);
+
+				const P twop = P(T(2))*p;
+				const P high = Simd::MultiplyAdd(twop, cosine, q);
+				const P low = Simd::MultiplyAdd(twop, P(T(-0.5))*cosine - P(T(0.86602540378443864676))*sine, q);
+				const P middle = P(T(3))*q - high - low;
+
+				// a gap too small for either extreme eigenvalue, flat included, is left to the caller //
+				const P separation = P(Separation<T>());
+				degenerate = Simd::Less(middle - low, separation);
+				degenerate = Simd::Select(degenerate, degenerate, Simd::Less(high - middle, separation));
+
+				P u[3], w[3];
+				NullVector<T>(a, low, u);
+				NullVector<T>(a, high, w);
+				P v[3] = {w[1]*u[2] - w[2]*u[1], w[2]*u[0] - w[0]*u[2], w[0]*u[1] - w[1]*u[0]};
+				const P length = Simd::Sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+				const P vinverse = P(T(1))/Simd::Select(Simd::Less(length, P(std::numeric_limits<T>::min())), P(T(1)), length);
+
+				for(int i=0;i<3;i++){
+					vectors[i] = u[i];
+					vectors[3+i] = v[i]*vinverse;
+					vectors[6+i] = w[i];
+				}
+
+				// acos is ill conditioned near r = +-1, the Rayleigh quotients x^T A x of the vectors are good to epsilon squared //
+				for(int i=0;i<3;i++){
+					const P * x = vectors + 3*i;
+					const P ax = a[0]*x[0]*x[0] + a[3]*x[1]*x[1] + a[5]*x[2]*x[2] + P(T(2))*(a[1]*x[0]*x[1] + a[2]*x[0]*x[2] + a[4]*x[1]*x[2]);
+					values[i] = ax*scale;
+				}
+			}
+		}
+
+		// cyclic Jacobi for any symmetric N x N and any floating T, both triangles are read and assumed equal //
+		template<typename T, int N>
+		Decomposition<T,N> Jacobi(const Matrix::Template<T,N,N> & M) {
+			T a[N*N], v[N*N];
+			for(int i=0;i<N;i++)
+				for(int j=0;j<N;j++) a[i*N+j] = M[i][j];
+			Kernel::Jacobi(a, v, N);
+
+			int order[N];
+			for(int i=0;i<N;i++) order[i] = i;
+			std::sort(order, order+N, [&](int x, int y) { return a[x*N+x] < a[y*N+y]; });
+
+			Decomposition<T,N> d;
+			for(int i=0;i<N;i++){
+				d.values[i] = a[order[i]*N+order[i]];
+				for(int k=0;k<N;k++) d.vectors[i][k] = v[k*N+order[i]];
+			}
+			return d;
+		}
+
+		// closed form for symmetric 3x3, matrices with a repeated eigenvalue fall back to Jacobi //
+		template<typename T>
+		Decomposition<T,3> Symmetric(const Matrix::Template<T,3,3> & M) {
+			static_assert(std::is_same<T,float>::value or std::is_same<T,double>::value, "Eigen::Symmetric takes float or double, Eigen::Jacobi any floating type");
+			typedef Simd::Pack<T,1> P;
+			const P m[6] = {P(M[0][0]), P(M[0][1]), P(M[0][2]), P(M[1][1]), P(M[1][2]), P(M[2][2])};
+			P values[3], vectors[9], degenerate;
+			Kernel::Symmetric<T>(m, values, vectors, degenerate);
+			if( Simd::Any(degenerate) ) return Jacobi(M);
+
+			Decomposition<T,3> d;
+			for(int i=0;i<3;i++){
+				d.values[i] = values[i][0];
+				for(int k=0;k<3;k++) d.vectors[i][k] = vectors[3*i+k][0];
+			}
+			return d;
+		}
+
+		// out[i] = Symmetric(in[i]) a register of matrices at a time, shared across Parallel workers for long arrays //
+		template<typename T>
+		void Symmetric(const Matrix::Template<T,3,3> * in, Decomposition<T,3> * out, size_t count) {
+			static_assert(std::is_same<T,float>::value or std::is_same<T,double>::value, "Eigen::Symmetric takes float or double, Eigen::Jacobi any floating type");
+			Vector::Kernel::Sweep<T>(count, [=](size_t base, auto pack) {
+				typedef decltype(pack) P;
+				T lanes[6][Simd::Width<T>::value];
+				for(int l=0;l<P::Lanes();l++){
+					const Matrix::Template<T,3,3> & M = in[base+l];
+					lanes[0][l] = M[0][0], lanes[1][l] = M[0][1], lanes[2][l] = M[0][2];
+					lanes[3][l] = M[1][1], lanes[4][l] = M[1][2], lanes[5][l] = M[2][2];
+				}
+				P m[6], values[3], vectors[9], degenerate;
+				for(int i=0;i<6;i++) m[i] = P::Load(lanes[i]);
+				Kernel::Symmetric<T>(m, values, vectors, degenerate);
+
+				T result[13][Simd::Width<T>::value];
+				for(int i=0;i<3;i++) values[i].Store(result[i]);
+				for(int i=0;i<9;i++) vectors[i].Store(result[3+i]);
+				degenerate.Store(result[12]);
+				for(int l=0;l<P::Lanes();l++){
+					Decomposition<T,3> & d = out[base+l];
+					if( result[12][l] != T(0) ){
+						d = Jacobi(in[base+l]);
+						continue;
+					}
+					for(int i=0;i<3;i++){
+						d.values[i] = result[i][l];
+						for(int k=0;k<3;k++) d.vectors[i][k] = result[3+3*i+k][l];
+					}
+				}
+			});
+		}
+
+	}
+}
+
+#endif // ending MATH_EIGEN //
@@ -0,0 +1,133 @@
+#pragma once
+
+#ifndef MATH_EXACT
+#define MATH_EXACT
+
+#include <Math/Prefix.h>
+#include <Math/BigInteger.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <vector>
+
+namespace Math {
+	namespace Matrix {
+		namespace Kernel {
+			// BigInteger never overflows //
+			template<>
+			struct Checked<BigInteger> {
+				static bool IsZero(const BigInteger & a) { return a.IsZero(); }
+
+				static bool MultiplySubtract(const BigInteger & a, const BigInteger & b, const BigInteger & c, const BigInteger & d, BigInteger & out) {
+					out = a*b;
+					out -= c*d;
+					return true;
+				}
+
+				static void DivideExact(BigInteger & a, const BigInteger & d) { a.DivideExact(d); }
+			};
+
+			// the m x n block of T copied into W, row major without padding //
+			template<typename W, typename T>
+			std::vector<W> Widen(const T * a, int m, int n, int stride) {
+				std::vector<W> b(size_t(m)*n);
+				for(int i=0;i<m;i++)
+					for(int j=0;j<n;j++) b[size_t(i)*n+j] = W(a[size_t(i)*stride+j]);
+				return b;
+			}
+
+			template<typename T, int rows, int columns>
+			constexpr int Stride(const Template<T,rows,columns> &) { return int(sizeof(Vector::Template<T,columns>)/sizeof(T)); }
+
+			template<typename W, typename T>
+			int ExactRank(const T * a, int m, int n, int stride, Status * status) {
+				std::vector<W> b = Widen<W>(a, m, n, stride);
+				std::vector<int> pivots(size_t(m < n ? m : n) + 1);
+				int rank = 0, sign = 1;
+				const Status result = Bareiss(b.data(), m, n, n, false, pivots.data(), rank, sign);
+				if( status ) *status = result;
+				return result == Status::Success ? rank : -1;
+			}
+
+			// after the reduced elimination pivot row i reads D at pivots[i] and R[i][f] at each free column f, so //
+			// x[f] = D, x[pivots[i]] = -R[i][f] and zero elsewhere solves A x = 0 for every free column //
+			template<typename W, typename T>
+			std::vector< std::vector<W> > ExactNullspace(const T * a, int m, int n, int stride, Status * status) {
+				std::vector<W> b = Widen<W>(a, m, n, stride);
+				std::vector<int> pivots(size_t(m < n ? m : n) + 1);
+				int rank = 0, sign = 1;
+				const Status result = Bareiss(b.data(), m, n, n, true, pivots.data(), rank, sign);
+				if( status ) *status = result;
+				std::vector< std::vector<W> > basis;
+				if( result != Status::Success ) return basis;
+
+				const W D = rank ? b[size_t(pivots[0])] : W(1);
+				std::vector<bool> pivot(size_t(n), false);
+				for(int i=0;i<rank;i++) pivot[pivots[i]] = true;
+				for(int f=0;f<n;f++){
+					if( pivot[f] ) continue;
+					std::vector<W> x(size_t(n), W(0));
+					x[f] = D;
+					for(int i=0;i<rank;i++) x[pivots[i]] = W(0) - b[size_t(i)*n+f];
+					basis.push_back(std::move(x));
+				}
+				return basis;
+			}
+		}
+
+		// exact integer linear algebra by fraction free (Bareiss) elimination in O(n^3) operations on an accumulator W //
+		// W is Kernel::Wide (__int128 where the compiler has it, int64_t otherwise) or BigInteger, built in accumulators //
+		// stop with Status::Overflow when an intermediate minor does not fit, BigInteger always succeeds //
+		namespace Exact {
+
+			// 0 with Status::Overflow when W is too narrow //
+			template<typename W =Kernel::Wide, typename T, int N>
+			W Determinant(const Template<T,N,N> & M, Status * status =nullptr) {
+				static_assert(std::is_integral<T>::value, "Exact::Determinant takes integral entries");
+				W det = W(0);
+				const Status result = Kernel::ExactDeterminant(&M[0][0], N, Kernel::Stride(M), det);
+				if( status ) *status = result;
+				return result == Status::Success ? det : W(0);
+			}
+
+			template<typename W =Kernel::Wide, typename T>
+			W Determinant(const Dynamic<T> & M, Status * status =nullptr) {
+				static_assert(std::is_integral<T>::value, "Exact::Determinant takes integral entries");
+				assert(M.HasDeterminant());
+				W det = W(0);
+				const Status result = Kernel::ExactDeterminant(&M, M.Rows(), M.Columns(), det);
+				if( status ) *status = result;
+				return result == Status::Success ? det : W(0);
+			}
+
+			// -1 with Status::Overflow when W is too narrow //
+			template<typename W =Kernel::Wide, typename T, int rows, int columns>
+			int Rank(const Template<T,rows,columns> & M, Status * status =nullptr) {
+				static_assert(std::is_integral<T>::value, "Exact::Rank takes integral entries");
+				return Kernel::ExactRank<W>(&M[0][0], rows, columns, Kernel::Stride(M), status);
+			}
+
+			template<typename W =Kernel::Wide, typename T>
+			int Rank(const Dynamic<T> & M, Status * status =nullptr) {
+				static_assert(std::is_integral<T>::value, "Exact::Rank takes integral entries");
+				return Kernel::ExactRank<W>(&M, M.Rows(), M.Columns(), M.Columns(), status);
+			}
+
+			// integer vectors spanning { x : M x = 0 }, one per column without a pivot, not reduced by their gcd //
+			// empty with Status::Overflow when W is too narrow //
+			template<typename W =Kernel::Wide, typename T, int rows, int columns>
+			std::vector< std::vector<W> > Nullspace(const Template<T,rows,columns> & M, Status * status =nullptr) {
+				static_assert(std::is_integral<T>::value, "Exact::Nullspace takes integral entries");
+				return Kernel::ExactNullspace<W>(&M[0][0], rows, columns, Kernel::Stride(M), status);
+			}
+
+			template<typename W =Kernel::Wide, typename T>
+			std::vector< std::vector<W> > Nullspace(const Dynamic<T> & M, Status * status =nullptr) {
+				static_assert(std::is_integral<T>::value, "Exact::Nullspace takes integral entries");
+				return Kernel::ExactNullspace<W>(&M, M.Rows(), M.Columns(), M.Columns(), status);
+			}
+		}
+
+	}
+}
+
+#endif // ending MATH_EXACT //
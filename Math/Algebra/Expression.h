@@ -0,0 +1,23 @@
+#pragma once
+
+#ifndef MATH_EXPRESSION
+#define MATH_EXPRESSION
+
+#include <Math/Prefix.h>
+
+namespace Math {
+	namespace Expression {
+
+		// element wise operations carried by the lazy Vector and Matrix nodes, X is a scalar or a Simd::Pack //
+		struct Add { template<typename X> static constexpr X Apply(X const & a, X const & b) { return a + b; } };
+		struct Subtract { template<typename X> static constexpr X Apply(X const & a, X const & b) { return a - b; } };
+		struct Multiply { template<typename X> static constexpr X Apply(X const & a, X const & b) { return a * b; } };
+		struct Divide { template<typename X> static constexpr X Apply(X const & a, X const & b) { return a / b; } };
+
+		// stored operands are held by reference, intermediate nodes are small and held by value //
+		template<typename X, bool node>
+		struct Hold { typedef typename std::conditional<node, X, X const &>::type Type; };
+	}
+}
+
+#endif // ending MATH_EXPRESSION //
@@ -0,0 +1,210 @@
+#pragma once
+
+#ifndef MATH_GEMM
+#define MATH_GEMM
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Parallel.h>
+
+namespace Math {
+	namespace Matrix {
+		namespace Kernel {
+
+			// MR x NR register tile two registers wide, KC deep panels sized for L1, MC x KC block of A for L2, KC x NC block of B for L3 //
+			template<typename T>
+			struct Blocking {
+				enum {
+					W = Simd::Width<T>::value,
+					MR = MATH_SIMD_BYTES == 32 ? 6 : 4,
+					NR = 2*W,
+					KC = 256,
+					MC = 96,
+					NC = 4096
+				};
+			};
+
+			// products with at least this many multiply-adds are split into macro tiles across Parallel workers //
+			const double ParallelThreshold = 128.0*128.0*128.0;
+
+			// per thread packing storage, grown on demand and reused across calls //
+			template<typename T>
+			class Scratch {
+			public:
+				Scratch(): p(nullptr), n(0) {}
+				~Scratch() { AlignedFree(p); }
+
+				T * Reserve(size_t count) {
+					if( count > n ){
+						AlignedFree(p);
+						p = AlignedAlloc<T>(count);
+						n = count;
+					}
+					return p;
+				}
+
+				static T * Get(int which, size_t count) {
+					static thread_local Scratch<T> scratch[2];
+					return scratch[which].Reserve(count);
+				}
+
+			private:
+				T * p;
+				size_t n;
+			};
+
+			// copies an mc x kc block of A into MR row panels, each stored column by column, short panels are zero padded //
+			template<typename T>
+			void PackA(int mc, int kc, const T * A, int lda, T * Ap) {
+				const int MR = Blocking<T>::MR;
+				for(int ir=0;ir<mc;ir+=MR){
+					const int mr = mc-ir < MR ? mc-ir : MR;
+					const T * a = A + size_t(ir)*lda;
+					for(int p=0;p<kc;p++){
+						for(int i=0;i<mr;i++) Ap[i] = a[size_t(i)*lda+p];
+						for(int i=mr;i<MR;i++) Ap[i] = T(0);
+						Ap += MR;
+					}
+				}
+			}
+
+			// copies a kc x nc block of B into NR column panels, each stored row by row, short panels are zero padded //
+			template<typename T>
+			void PackB(int kc, int nc, const T * B, int ldb, T * Bp) {
+				const int NR = Blocking<T>::NR;
+				for(int jr=0;jr<nc;jr+=NR){
+					const int nr = nc-jr < NR ? nc-jr : NR;
+					for(int p=0;p<kc;p++){
+						const T * b = B + size_t(p)*ldb + jr;
+						for(int j=0;j<nr;j++) Bp[j] = b[j];
+						for(int j=nr;j<NR;j++) Bp[j] = T(0);
+						Bp += NR;
+					}
+				}
+			}
+
+			// C[mr x nr] = alpha*Ap*Bp + beta*C, the accumulator tile stays in registers across the kc loop //
+			template<typename T>
+			void MicroKernel(int kc, const T * Ap, const T * Bp, T alpha, T beta, T * C, int ldc, int mr, int nr) {
+				typedef Simd::Pack<T,Blocking<T>::W> Row;
+				const int MR = Blocking<T>::MR, NR = Blocking<T>::NR, W = Blocking<T>::W;
+				Row acc[MR][2];
+				for(int i=0;i<MR;i++) acc[i][0] = acc[i][1] = Row(T(0));
+
+				for(int p=0;p<kc;p++){
+					const Row b0 = Row::Load(Bp), b1 = Row::Load(Bp+W);
+					for(int i=0;i<MR;i++){
+						const Row a(Ap[i]);
+						acc[i][0] = Simd::MultiplyAdd(a,b0,acc[i][0]);
+						acc[i][1] = Simd::MultiplyAdd(a,b1,acc[i][1]);
+					}
+					Ap += MR, Bp += NR;
+				}
+
+				T tile[NR];
+				for(int i=0;i<mr;i++){
+					T * c = C + size_t(i)*ldc;
+					acc[i][0].Store(tile), acc[i][1].Store(tile+W);
+					if( beta == T(0) ) for(int j=0;j<nr;j++) c[j] = alpha*tile[j];
+					else for(int j=0;j<nr;j++) c[j] = alpha*tile[j] + beta*c[j];
+				}
+			}
+
+			// sweeps the register tiles of one packed mc x nc block //
+			template<typename T>
+			void MacroKernel(int mc, int nc, int kc, const T * Ap, const T * Bp, T alpha, T beta, T * C, int ldc) {
+				const int MR = Blocking<T>::MR, NR = Blocking<T>::NR;
+				for(int jr=0;jr<nc;jr+=NR){
+					const int nr = nc-jr < NR ? nc-jr : NR;
+					for(int ir=0;ir<mc;ir+=MR){
+						const int mr = mc-ir < MR ? mc-ir : MR;
+						MicroKernel(kc, Ap + size_t(ir)*kc, Bp + size_t(jr)*kc, alpha, beta, C + size_t(ir)*ldc + jr, ldc, mr, nr);
+					}
+				}
+			}
+
+			template<typename T>
+			void Scale(int m, int n, T beta, T * C, int ldc) {
+				for(int i=0;i<m;i++){
+					T * c = C + size_t(i)*ldc;
+					for(int j=0;j<n;j++) c[j] = beta == T(0) ? T(0) : beta*c[j];
+				}
+			}
+		}
+
+		// C = alpha*A*B + beta*C over row major blocks with leading dimensions lda, ldb and ldc, C must not alias A or B //
+		// every element of C is accumulated in the same order however the work is split, so results do not depend on Parallel::Threads //
+		template<typename T>
+		void Gemm(int m, int n, int k, T alpha, const T * A, int lda, const T * B, int ldb, T beta, T * C, int ldc) {
+			typedef Kernel::Blocking<T> Blocking;
+			if( m <= 0 or n <= 0 ) return;
+			if( k <= 0 or alpha == T(0) ) return Kernel::Scale(m, n, beta, C, ldc);
+
+			const int KC = k < int(Blocking::KC) ? k : int(Blocking::KC);
+			const int NC = n < int(Blocking::NC) ? n : int(Blocking::NC);
+			const int NR = Blocking::NR, MR = Blocking::MR;
+			const int threads = double(m)*n*k >= Kernel::ParallelThreshold ? int(Parallel::Threads()) : 1;
+
+			// with several threads the A blocks shrink until every thread has at least two macro tiles //
+			int MC = Blocking::MC;
+			if( threads > 1 ){
+				const int split = ((m + 2*threads - 1)/(2*threads) + MR - 1)/MR*MR;
+				MC = split < MC ? (split > MR ? split : MR) : MC;
+			}
+			const int mblocks = (m + MC - 1)/MC;
+
+			// the calling thread may pick up other Gemm tasks while it waits, so a parallel call owns its packed B //
+			const size_t bsize = size_t(KC)*((NC+NR-1)/NR)*NR;
+			T * Bp = threads == 1 ? Kernel::Scratch<T>::Get(0, bsize) : AlignedAlloc<T>(bsize);
+			for(int jc=0;jc<n;jc+=Blocking::NC){
+				const int nc = n-jc < NC ? n-jc : NC;
+				const int npanels = (nc + NR - 1)/NR;
+				int nslabs = 1;
+				if( threads > 1 and mblocks < 2*threads ){
+					nslabs = (2*threads + mblocks - 1)/mblocks;
+					if( nslabs > npanels/8 ) nslabs = npanels/8 > 1 ? npanels/8 : 1;
+				}
+				const int slab = (npanels + nslabs - 1)/nslabs*NR;
+
+				for(int pc=0;pc<k;pc+=Blocking::KC){
+					const int kc = k-pc < KC ? k-pc : KC;
+					const T b = pc == 0 ? beta : T(1);
+					const T * Bk = B + size_t(pc)*ldb + jc;
+					T * Cj = C + jc;
+
+					if( threads == 1 ){
+						Kernel::PackB(kc, nc, Bk, ldb, Bp);
+						T * Ap = Kernel::Scratch<T>::Get(1, size_t(KC)*((MC+MR-1)/MR)*MR);
+						for(int ic=0;ic<m;ic+=MC){
+							const int mc = m-ic < MC ? m-ic : MC;
+							Kernel::PackA(mc, kc, A + size_t(ic)*lda + pc, lda, Ap);
+							Kernel::MacroKernel(mc, nc, kc, Ap, Bp, alpha, b, Cj + size_t(ic)*ldc, ldc);
+						}
+						continue;
+					}
+
+					Parallel::For(0, npanels, 4, [&](size_t first, size_t last) {
+						const int jr = int(first)*NR, cols = int(last)*NR < nc ? int(last)*NR - jr : nc - jr;
+						Kernel::PackB(kc, cols, Bk + jr, ldb, Bp + size_t(jr)*kc);
+					});
+
+					Parallel::For(0, size_t(mblocks)*nslabs, 1, [&](size_t first, size_t last) {
+						T * Ap = Kernel::Scratch<T>::Get(1, size_t(KC)*((MC+MR-1)/MR)*MR);
+						int packed = -1;
+						for(size_t t=first;t<last;t++){
+							const int ic = int(t/nslabs)*MC, jr = int(t%nslabs)*slab;
+							const int mc = m-ic < MC ? m-ic : MC;
+							if( jr >= nc ) continue;
+							const int cols = nc-jr < slab ? nc-jr : slab;
+							if( packed != ic ) Kernel::PackA(mc, kc, A + size_t(ic)*lda + pc, lda, Ap), packed = ic;
+							Kernel::MacroKernel(mc, cols, kc, Ap, Bp + size_t(jr)*kc, alpha, b, Cj + size_t(ic)*ldc + jr, ldc);
+						}
+					});
+				}
+			}
+			if( threads > 1 ) AlignedFree(Bp);
+		}
+	}
+}
+
+#endif // ending MATH_GEMM //
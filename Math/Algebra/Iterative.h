@@ -0,0 +1,489 @@
+#pragma once
+
+#ifndef MATH_ITERATIVE
+#define MATH_ITERATIVE
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Parallel.h>
+#include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Batch.h>
+#include <Math/Algebra/Sparse.h>
+
+#include <algorithm>
+#include <vector>
+
+// Krylov solvers for systems too large to factor. The operator is anything callable as A(x, y) that writes //
+// y = A x for vectors of n values, preconditioners are callable as M(r, z) and write an approximation of z = A^-1 r //
+namespace Math {
+	namespace Iterative {
+
+		template<typename T>
+		struct Settings {
+			Settings(T tolerance =T(1e-8), size_t iterations =1000, int restart =30, bool history =true): tolerance(tolerance), iterations(iterations), restart(restart), history(history) {}
+
+			// stop once |b - A x| <= tolerance*|b| //
+			T tolerance;
+			size_t iterations;
+			// Krylov basis size of GMRES between restarts //
+			int restart;
+			// keep the relative residual of every iteration //
+			bool history;
+		};
+
+		template<typename T>
+		struct Report {
+			Report(): iterations(0), residual(T(0)), converged(false) {}
+
+			size_t iterations;
+			// final |b - A x|/|b| as tracked by the method //
+			T residual;
+			bool converged;
+			// relative residual before the first iteration and after each one //
+			std::vector<T> history;
+		};
+
+		// solver vectors live in one 64 byte aligned block that is grown on demand and kept across solves //
+		// a solver handed none allocates its own for the call: its vectors stay live while it waits on Parallel loops, //
+		// and a waiting thread runs other queued jobs, so a workspace shared per thread could be taken by a nested solve //
+		// one workspace serves one solve at a time //
+		template<typename T>
+		class Workspace {
+		public:
+			Workspace(): e(nullptr), size(0) {}
+			~Workspace() { AlignedFree(e); }
+
+			Workspace(const Workspace<T> &) =delete;
+			Workspace<T> & operator = (const Workspace<T> &) =delete;
+
+			// values between the starts of two consecutive vectors of n values //
+			static size_t Stride(size_t n) {
+				const size_t line = 64/sizeof(T) ? 64/sizeof(T) : 1;
+				return (n + line - 1)/line*line;
+			}
+
+			// count vectors of n values, vector i starts at Stride(n)*i, contents are left from earlier use //
+			T * Reserve(size_t count, size_t n) {
+				const size_t needed = count*Stride(n);
+				if( needed > size ){
+					AlignedFree(e);
+					e = AlignedAlloc<T>(needed);
+					size = needed;
+				}
+				return e;
+			}
+
+		protected:
+			T * e;
+			size_t size;
+		};
+
+		namespace Kernel {
+			template<typename T>
+			T Dot(const T * x, const T * y, size_t n) {
+				auto dot = [=](size_t first, size_t last) {
+					typedef Simd::Pack<T> Pack;
+					const size_t W = Simd::Width<T>::value;
+					Pack acc(T(0));
+					size_t i = first;
+					for(;i+W<=last;i+=W) acc = Simd::MultiplyAdd(Pack::Load(x+i), Pack::Load(y+i), acc);
+					T sum = Simd::Sum(acc);
+					for(;i<last;i++) sum += x[i]*y[i];
+					return sum;
+				};
+				if( n <= Vector::Kernel::BatchGrain ) return dot(0, n);
+				return Parallel::Reduce(size_t(0), n, Vector::Kernel::BatchGrain, T(0), dot, [](T a, T b) { return a + b; });
+			}
+
+			template<typename T>
+			T Norm(const T * x, size_t n) { return std::sqrt(Dot(x, x, n)); }
+
+			// y += a*x //
+			template<typename T>
+			void Axpy(T a, const T * x, T * y, size_t n) {
+				Vector::Kernel::Sweep<T>(n, [=](size_t i, auto p) {
+					typedef decltype(p) Pack;
+					Simd::MultiplyAdd(Pack(a), Pack::Load(x+i), Pack::Load(y+i)).Store(y+i);
+				});
+			}
+
+			// y = x + a*y //
+			template<typename T>
+			void Xpay(const T * x, T a, T * y, size_t n) {
+				Vector::Kernel::Sweep<T>(n, [=](size_t i, auto p) {
+					typedef decltype(p) Pack;
+					Simd::MultiplyAdd(Pack(a), Pack::Load(y+i), Pack::Load(x+i)).Store(y+i);
+				});
+			}
+
+			// z = x + a*y //
+			template<typename T>
+			void Waxpy(const T * x, T a, const T * y, T * z, size_t n) {
+				Vector::Kernel::Sweep<T>(n, [=](size_t i, auto p) {
+					typedef decltype(p) Pack;
+					Simd::MultiplyAdd(Pack(a), Pack::Load(y+i), Pack::Load(x+i)).Store(z+i);
+				});
+			}
+
+			template<typename T>
+			void Scale(T a, const T * x, T * y, size_t n) {
+				Vector::Kernel::Sweep<T>(n, [=](size_t i, auto p) {
+					typedef decltype(p) Pack;
+					(Pack(a)*Pack::Load(x+i)).Store(y+i);
+				});
+			}
+
+			// r = b - A x //
+			template<typename T, typename Operator>
+			void Residual(Operator & A, const T * b, const T * x, T * r, size_t n) {
+				A(x, r);
+				Waxpy(b, T(-1), r, r, n);
+			}
+
+			template<typename T>
+			bool Record(Report<T> & report, const Settings<T> & settings, T residual) {
+				report.residual = residual;
+				if( settings.history ) report.history.push_back(residual);
+				return report.converged = residual <= settings.tolerance;
+			}
+		}
+
+		// y = A x for a compressed sparse row matrix //
+		template<typename T>
+		auto Product(const Matrix::Sparse<T> & A) {
+			return [&A](const T * x, T * y) { Matrix::Multiply(A, x, y); };
+		}
+
+		template<typename T, int B>
+		auto Product(const Matrix::Blocked<T,B> & A) {
+			return [&A](const T * x, T * y) { Matrix::Multiply(A, x, y); };
+		}
+
+		// no preconditioning //
+		template<typename T>
+		class Identity {
+		public:
+			Identity(size_t n): n(n) {}
+			void operator () (const T * r, T * z) const { std::copy(r, r+n, z); }
+
+		protected:
+			size_t n;
+		};
+
+		// z = D^-1 r for the diagonal D of A, zero diagonal entries pass r through //
+		template<typename T>
+		class Jacobi {
+		public:
+			Jacobi(const Matrix::Sparse<T> & A): inverse(size_t(A.Rows()), T(1)) {
+				for(int r=0;r<A.Rows();r++){
+					const T d = A(r,r);
+					if( d != T(0) ) inverse[r] = T(1)/d;
+				}
+			}
+
+			void operator () (const T * r, T * z) const {
+				const T * d = inverse.data();
+				Vector::Kernel::Sweep<T>(inverse.size(), [=](size_t i, auto p) {
+					typedef decltype(p) Pack;
+					(Pack::Load(d+i)*Pack::Load(r+i)).Store(z+i);
+				});
+			}
+
+		protected:
+			std::vector<T> inverse;
+		};
+
+		// zero fill incomplete Cholesky A ~ L L^T on the pattern of the lower triangle of a symmetric positive definite A //
+		// a pivot that comes out non positive is replaced by the square root of |A(i,i)| and GetStatus() reports Singular, //
+		// the factor is still a usable preconditioner then but a weaker one //
+		template<typename T>
+		class IncompleteCholesky {
+		public:
+			IncompleteCholesky(const Matrix::Sparse<T> & A): breakdowns(0) {
+				const size_t * offset = A.Offsets();
+				const int * index = A.Indices();
+				std::vector< Matrix::Triplet<T> > triplets;
+				triplets.reserve(A.NonZeros()/2 + size_t(A.Rows()));
+				for(int r=0;r<A.Rows();r++){
+					for(size_t k=offset[r];k<offset[r+1] and index[k]<r;k++) triplets.push_back(Matrix::Triplet<T>{r, index[k], A.Values()[k]});
+					triplets.push_back(Matrix::Triplet<T>{r, r, A(r,r)});
+				}
+				lower = Matrix::Sparse<T>(A.Rows(), A.Columns(), triplets);
+
+				// row i against each earlier row j it touches, the shared columns below j found by merging the sorted rows //
+				const size_t * lo = lower.Offsets();
+				const int * li = lower.Indices();
+				T * lv = lower.Values();
+				for(int i=0;i<lower.Rows();i++){
+					const size_t diagonal = lo[i+1]-1;
+					for(size_t k=lo[i];k<=diagonal;k++){
+						const int j = li[k];
+						T sum = lv[k];
+						size_t p = lo[i], q = lo[j];
+						while( p < k and q < lo[j+1]-1 ){
+							if( li[p] < li[q] ) p++;
+							else if( li[p] > li[q] ) q++;
+							else sum -= lv[p++]*lv[q++];
+						}
+						if( k < diagonal ){
+							lv[k] = sum/lv[lo[j+1]-1];
+							continue;
+						}
+						if( sum > T(0) ) lv[k] = std::sqrt(sum);
+						else lv[k] = std::sqrt(Abs(lv[k]) > T(0) ? Abs(lv[k]) : T(1)), breakdowns++;
+					}
+				}
+				upper = Matrix::Transpose(lower);
+			}
+
+			Status GetStatus() const { return breakdowns ? Status::Singular : Status::Success; }
+			const Matrix::Sparse<T> & Lower() const { return lower; }
+
+			// z = L^-T L^-1 r, two sparse triangular sweeps //
+			void operator () (const T * r, T * z) const {
+				const size_t * lo = lower.Offsets(), * uo = upper.Offsets();
+				const int * li = lower.Indices(), * ui = upper.Indices();
+				const T * lv = lower.Values(), * uv = upper.Values();
+				const int n = lower.Rows();
+				for(int i=0;i<n;i++){
+					T sum = r[i];
+					const size_t diagonal = lo[i+1]-1;
+					for(size_t k=lo[i];k<diagonal;k++) sum -= lv[k]*z[li[k]];
+					z[i] = sum/lv[diagonal];
+				}
+				for(int i=n-1;i>=0;i--){
+					T sum = z[i];
+					const size_t diagonal = uo[i];
+					for(size_t k=diagonal+1;k<uo[i+1];k++) sum -= uv[k]*z[ui[k]];
+					z[i] = sum/uv[diagonal];
+				}
+			}
+
+		protected:
+			Matrix::Sparse<T> lower, upper;
+			size_t breakdowns;
+		};
+
+		// preconditioned conjugate gradients for symmetric positive definite A and M, x holds the initial guess //
+		template<typename T, typename Operator, typename Preconditioner>
+		Report<T> CG(Operator A, const Preconditioner & M, const T * b, T * x, size_t n, const Settings<T> & settings =Settings<T>(), Workspace<T> * workspace =nullptr) {
+			Workspace<T> own;
+			Workspace<T> & work = workspace ? *workspace : own;
+			const size_t stride = Workspace<T>::Stride(n);
+			T * r = work.Reserve(4, n), * z = r + stride, * p = z + stride, * q = p + stride;
+
+			Report<T> report;
+			const T bnorm = Kernel::Norm(b, n);
+			if( bnorm == T(0) ){
+				std::fill(x, x+n, T(0));
+				Kernel::Record(report, settings, T(0));
+				return report;
+			}
+
+			Kernel::Residual(A, b, x, r, n);
+			if( Kernel::Record(report, settings, Kernel::Norm(r, n)/bnorm) ) return report;
+			M(r, z);
+			std::copy(z, z+n, p);
+			T rz = Kernel::Dot(r, z, n);
+
+			while( report.iterations < settings.iterations ){
+				A(p, q);
+				const T pq = Kernel::Dot(p, q, n);
+				if( pq == T(0) ) break;
+				const T alpha = rz/pq;
+				Kernel::Axpy(alpha, p, x, n);
+				Kernel::Axpy(-alpha, q, r, n);
+				report.iterations++;
+				if( Kernel::Record(report, settings, Kernel::Norm(r, n)/bnorm) ) break;
+
+				M(r, z);
+				const T next = Kernel::Dot(r, z, n);
+				Kernel::Xpay(z, next/rz, p, n);
+				rz = next;
+			}
+			return report;
+		}
+
+		// preconditioned BiCGSTAB for general square A, M is applied on the right //
+		template<typename T, typename Operator, typename Preconditioner>
+		Report<T> BiCGSTAB(Operator A, const Preconditioner & M, const T * b, T * x, size_t n, const Settings<T> & settings =Settings<T>(), Workspace<T> * workspace =nullptr) {
+			Workspace<T> own;
+			Workspace<T> & work = workspace ? *workspace : own;
+			const size_t stride = Workspace<T>::Stride(n);
+			T * r = work.Reserve(7, n), * shadow = r + stride, * p = shadow + stride, * v = p + stride;
+			T * y = v + stride, * s = y + stride, * t = s + stride;
+
+			Report<T> report;
+			const T bnorm = Kernel::Norm(b, n);
+			if( bnorm == T(0) ){
+				std::fill(x, x+n, T(0));
+				Kernel::Record(report, settings, T(0));
+				return report;
+			}
+
+			Kernel::Residual(A, b, x, r, n);
+			if( Kernel::Record(report, settings, Kernel::Norm(r, n)/bnorm) ) return report;
+			std::copy(r, r+n, shadow);
+			std::fill(p, p+n, T(0));
+			std::fill(v, v+n, T(0));
+			T rho = T(1), alpha = T(1), omega = T(1);
+
+			// the recurred residual drifts away from b - A x over many steps, so a small one is only trusted once recomputed //
+			// when the true residual is still too large the method restarts from it //
+			auto settle = [&]() {
+				Kernel::Residual(A, b, x, r, n);
+				if( Kernel::Record(report, settings, Kernel::Norm(r, n)/bnorm) ) return true;
+				std::copy(r, r+n, shadow);
+				std::fill(p, p+n, T(0));
+				std::fill(v, v+n, T(0));
+				rho = alpha = omega = T(1);
+				return false;
+			};
+
+			while( report.iterations < settings.iterations ){
+				const T next = Kernel::Dot(shadow, r, n);
+				if( next == T(0) ) break;
+
+				// p = r + beta*(p - omega*v) //
+				Kernel::Axpy(-omega, v, p, n);
+				Kernel::Xpay(r, (next/rho)*(alpha/omega), p, n);
+				rho = next;
+
+				M(p, y);
+				A(y, v);
+				const T sv = Kernel::Dot(shadow, v, n);
+				if( sv == T(0) ) break;
+				alpha = rho/sv;
+				Kernel::Waxpy(r, -alpha, v, s, n);
+				Kernel::Axpy(alpha, y, x, n);
+				report.iterations++;
+				if( Kernel::Norm(s, n)/bnorm <= settings.tolerance ){
+					if( settle() ) break;
+					continue;
+				}
+
+				M(s, y);
+				A(y, t);
+				const T tt = Kernel::Dot(t, t, n);
+				omega = tt == T(0) ? T(0) : Kernel::Dot(t, s, n)/tt;
+				Kernel::Axpy(omega, y, x, n);
+				Kernel::Waxpy(s, -omega, t, r, n);
+				const T rnorm = Kernel::Norm(r, n)/bnorm;
+				if( rnorm <= settings.tolerance ){
+					if( settle() ) break;
+				}
+				else if( Kernel::Record(report, settings, rnorm) or omega == T(0) ) break;
+			}
+			return report;
+		}
+
+		// restarted GMRES for general square A, M is applied on the right so the tracked residual is the true one //
+		// the basis is orthogonalized by modified Gram-Schmidt and the least squares problem kept triangular by Givens rotations //
+		template<typename T, typename Operator, typename Preconditioner>
+		Report<T> GMRES(Operator A, const Preconditioner & M, const T * b, T * x, size_t n, const Settings<T> & settings =Settings<T>(), Workspace<T> * workspace =nullptr) {
+			const int m = settings.restart > 0 ? settings.restart : 1;
+			Workspace<T> own;
+			Workspace<T> & work = workspace ? *workspace : own;
+			const size_t stride = Workspace<T>::Stride(n);
+			T * basis = work.Reserve(size_t(m)+3, n), * z = basis + (size_t(m)+1)*stride, * w = z + stride;
+
+			// the small dense problem is m by m, not worth a workspace slot //
+			std::vector<T> h(size_t(m+1)*m), cs(m), sn(m), g(m+1), y(m);
+
+			Report<T> report;
+			const T bnorm = Kernel::Norm(b, n);
+			if( bnorm == T(0) ){
+				std::fill(x, x+n, T(0));
+				Kernel::Record(report, settings, T(0));
+				return report;
+			}
+
+			Kernel::Residual(A, b, x, basis, n);
+			T beta = Kernel::Norm(basis, n);
+			if( Kernel::Record(report, settings, beta/bnorm) ) return report;
+
+			while( report.iterations < settings.iterations ){
+				Kernel::Scale(T(1)/beta, basis, basis, n);
+				std::fill(g.begin(), g.end(), T(0));
+				g[0] = beta;
+
+				int k = 0;
+				while( k < m and report.iterations < settings.iterations ){
+					T * vk = basis + size_t(k)*stride, * next = vk + stride;
+					M(vk, z);
+					A(z, w);
+					for(int i=0;i<=k;i++){
+						const T * vi = basis + size_t(i)*stride;
+						const T hik = h[size_t(i)*m+k] = Kernel::Dot(w, vi, n);
+						Kernel::Axpy(-hik, vi, w, n);
+					}
+					const T norm = Kernel::Norm(w, n);
+					h[size_t(k+1)*m+k] = norm;
+					if( norm != T(0) ) Kernel::Scale(T(1)/norm, w, next, n);
+
+					for(int i=0;i<k;i++){
+						T & a = h[size_t(i)*m+k], & c = h[size_t(i+1)*m+k];
+						const T t = cs[i]*a + sn[i]*c;
+						c = -sn[i]*a + cs[i]*c;
+						a = t;
+					}
+					T & a = h[size_t(k)*m+k], & c = h[size_t(k+1)*m+k];
+					const T r = std::sqrt(a*a + c*c);
+					cs[k] = r == T(0) ? T(1) : a/r;
+					sn[k] = r == T(0) ? T(0) : c/r;
+					a = r, c = T(0);
+					g[k+1] = -sn[k]*g[k];
+					g[k] = cs[k]*g[k];
+
+					k++;
+					report.iterations++;
+					if( Kernel::Record(report, settings, Abs(g[k])/bnorm) or norm == T(0) ) break;
+				}
+
+				// x += M^-1 V y with R y = g //
+				for(int i=k-1;i>=0;i--){
+					T sum = g[i];
+					for(int j=i+1;j<k;j++) sum -= h[size_t(i)*m+j]*y[j];
+					y[i] = sum/h[size_t(i)*m+i];
+				}
+				std::fill(w, w+n, T(0));
+				for(int i=0;i<k;i++) Kernel::Axpy(y[i], basis + size_t(i)*stride, w, n);
+				M(w, z);
+				Kernel::Axpy(T(1), z, x, n);
+				if( report.converged ) break;
+
+				// the recurrence drifts from the true residual, restart from the real one //
+				Kernel::Residual(A, b, x, basis, n);
+				beta = Kernel::Norm(basis, n);
+				report.residual = beta/bnorm;
+				if( (report.converged = report.residual <= settings.tolerance) or beta == T(0) ) break;
+			}
+			return report;
+		}
+
+		// the same solvers over a sparse matrix and dynamic vectors, x is resized to zero when its size does not match //
+		template<typename T, typename Preconditioner>
+		Report<T> CG(const Matrix::Sparse<T> & A, const Preconditioner & M, const Vector::Dynamic<T> & b, Vector::Dynamic<T> & x, const Settings<T> & settings =Settings<T>()) {
+			assert(A.Rows() == A.Columns() and b.GetSize() == A.Rows());
+			if( x.GetSize() != b.GetSize() ) x.Resize(b.GetSize());
+			return CG(Product(A), M, &b, &x, size_t(b.GetSize()), settings);
+		}
+
+		template<typename T, typename Preconditioner>
+		Report<T> BiCGSTAB(const Matrix::Sparse<T> & A, const Preconditioner & M, const Vector::Dynamic<T> & b, Vector::Dynamic<T> & x, const Settings<T> & settings =Settings<T>()) {
+			assert(A.Rows() == A.Columns() and b.GetSize() == A.Rows());
+			if( x.GetSize() != b.GetSize() ) x.Resize(b.GetSize());
+			return BiCGSTAB(Product(A), M, &b, &x, size_t(b.GetSize()), settings);
+		}
+
+		template<typename T, typename Preconditioner>
+		Report<T> GMRES(const Matrix::Sparse<T> & A, const Preconditioner & M, const Vector::Dynamic<T> & b, Vector::Dynamic<T> & x, const Settings<T> & settings =Settings<T>()) {
+			assert(A.Rows() == A.Columns() and b.GetSize() == A.Rows());
+			if( x.GetSize() != b.GetSize() ) x.Resize(b.GetSize());
+			return GMRES(Product(A), M, &b, &x, size_t(b.GetSize()), settings);
+		}
+
+	}
+}
+
+#endif // ending MATH_ITERATIVE //
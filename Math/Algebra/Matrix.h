@@ -5,15 +5,37 @@
 
 #include <Math/Prefix.h>
 #include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Expression.h>
+#include <Math/SIMD.h>
+#include <Math/Parallel.h>
+#include <Math/Algebra/GEMM.h>
+#include <Math/Elementary.h>
 
 #include <Stringz/Utility.h>
 
+#include <limits>
+#include <vector>
+
 namespace Math {
 	namespace Matrix {
+		template<typename T, int rows, int columns>
+		class Template;
+
+		// element wise expression operands, Row is what operand[i] yields //
+		template<typename X>
+		struct Operand { enum { value = false, node = false, height = 0, width = 0 }; };
+
+		template<typename T, int rows, int columns>
+		struct Operand< Template<T,rows,columns> > {
+			enum { value = rows > 1 and columns > 1, node = false, height = rows, width = columns };
+			typedef T Type;
+			typedef Vector::Template<T,columns> Row;
+		};
+
 		template<typename T, int rows, int columns>
 		class Template {
 		public:
-			Template( const std::initializer_list< Vector::Template<T,columns> > & list ) {
+			constexpr Template( const std::initializer_list< Vector::Template<T,columns> > & list ): e() {
 				if( list.size() != rows )
 					throw std::exception("Invalid initializer list provided, size mismatch");
 
@@ -21,19 +43,23 @@ namespace Math {
 				for(const auto & item : list) e[i++] = item;
 			}
 
-			Template(T const & u =T(1)) {
+			constexpr Template(const Template<T,rows,columns> &) = default;
+
+			constexpr Template(T const & u =T(1)): e() {
 				for(int i=0;i<rows;i++){
 					for(int j=0;j<columns;j++)
 						e[i][j] = (i+j)%2 ? T(0) : u;
 				}
 			}
 
-			~Template() {}
+			// evaluates a lazy expression row by row, each row in a single pass //
+			template<typename X, typename =typename std::enable_if<Operand<X>::node>::type>
+			constexpr Template(const X & x): e() { operator=(x); }
 
-			int Rows() const { return rows; }
-			int Columns() const { return columns; }
+			constexpr int Rows() const { return rows; }
+			constexpr int Columns() const { return columns; }
 
-			bool HasDeterminant() const { return rows == columns; }
+			constexpr bool HasDeterminant() const { return rows == columns; }
 			std::string ToString() const {
 				std::string string = "[";
 				for(int i=0;i<rows;i++)
@@ -41,94 +67,165 @@ namespace Math {
 				return string.substr(0,string.length()-2) + "]";
 			}
 
-			typename Vector::Template<T,columns> Row(int r) const {
+			constexpr Vector::Template<T,columns> Row(int r) const {
 				Vector::Template<T,columns> row;
 				for(int i=0;i<columns;i++)
 					row[i] = e[r][i];
 				return row;
 			}
 
-			typename Vector::Template<T,rows> Column(int c) const {
+			constexpr Vector::Template<T,rows> Column(int c) const {
 				Vector::Template<T,rows> column;
 				for(int i=0;i<rows;i++)
 					column[i] = e[i][c];
 				return column;
 			}
 
-			typename Template<T,rows-1,columns-1> Reduced(int r, int c) const {
+			constexpr Template<T,rows-1,columns-1> Reduced(int r, int c) const {
 				Template<T,rows-1,columns-1> reduced;
-				int s=0,t=0;
+				int s=0;
 				for(int i=0;i<rows;i++){
 					if(i == r) continue;
-					for(int j=0;j<columns;j++){
+					for(int j=0,t=0;j<columns;j++){
 						if(j == c) continue;
 						else reduced[s][t++] = this->e[i][j];
 					}
+					s++;
 				}
 				return reduced;
 			}
 
-			typename Vector::Template<T,columns> & operator [] (int r) { return e[r]; }
-			typename const Vector::Template<T,columns> & operator [] (int r) const { return e[r]; }
+			constexpr Vector::Template<T,columns> & operator [] (int r) { return e[r]; }
+			constexpr const Vector::Template<T,columns> & operator [] (int r) const { return e[r]; }
 
-			typename Vector::Template<T,columns> * operator & () { return e; }
-			typename const Vector::Template<T,columns> * operator & () const { return e; }
+			constexpr Vector::Template<T,columns> * operator & () { return e; }
+			constexpr const Vector::Template<T,columns> * operator & () const { return e; }
 
-			typename Template<T,rows,columns> & operator = (const Template<T,rows,columns> & M) {
+			constexpr Template<T,rows,columns> & operator = (const Template<T,rows,columns> & M) {
 				for(int i=0;i<rows;i++) e[i] = M[i];
 				return *this;
 			}
 
-			typename Template<T,rows,columns> & operator += (const Template<T,rows,columns> & M) {
+			template<typename X, typename =typename std::enable_if<Operand<X>::node>::type>
+			constexpr Template<T,rows,columns> & operator = (const X & x) {
+				for(int i=0;i<rows;i++) e[i] = x[i];
+				return *this;
+			}
+
+			constexpr Template<T,rows,columns> & operator += (const Template<T,rows,columns> & M) {
 				for(int i=0;i<rows;i++) e[i] += M[i];
 				return *this;
 			}
 
-			typename Template<T,rows,columns> & operator -= (const Template<T,rows,columns> & M) {
+			constexpr Template<T,rows,columns> & operator -= (const Template<T,rows,columns> & M) {
 				for(int i=0;i<rows;i++) e[i] -= M[i];
 				return *this;
 			}
 
-			typename Template<T,rows,columns> & operator *= (T const & r) {
+			constexpr Template<T,rows,columns> & operator *= (T const & r) {
 				for(int i=0;i<rows;i++) e[i] *= r;
 				return *this;
 			}
 
-			typename Vector::Template<T,rows> operator * ( const Vector::Template<T,columns> & u ) const {
+			constexpr Vector::Template<T,rows> operator * ( const Vector::Template<T,columns> & u ) const {
 				Vector::Template<T,rows> v;
 				for(int i=0;i<rows;i++) v[i] = operator[](i)*u;
 				return v;
 			}
-			
-			typename Template<T,rows,columns> operator + (const Template<T,rows,columns> & M) const {
-				Template<T,rows,columns> A = *this;
-				return A += M;
-			}
 
-			typename Template<T,rows,columns> operator - (const Template<T,rows,columns> & M) const {
-				Template<T,rows,columns> A = *this;
-				return A -= M;
-			}
+		protected:
+			Vector::Template<T,columns> e[rows];
+		};
 
-			typename Template<T,rows,columns> operator * (T const & r) const {
-				Template<T,rows,columns> A = *this;
-				return A *= r;
+		// A + B*r - C over matrices builds these nodes, row i of a node is the matching Vector node over row i of the operands //
+		// leaves are held by reference, so keep a node only as long as the matrices it was built from //
+		template<typename X, typename T, int rows, int columns>
+		class Node {
+		public:
+			constexpr int Rows() const { return rows; }
+			constexpr int Columns() const { return columns; }
+			constexpr Template<T,rows,columns> Evaluate() const { return Template<T,rows,columns>(static_cast<const X &>(*this)); }
+			std::string ToString() const { return Evaluate().ToString(); }
+
+			constexpr Vector::Template<T,rows> operator * (const Vector::Template<T,columns> & u) const {
+				Vector::Template<T,rows> v;
+				for(int i=0;i<rows;i++) v[i] = static_cast<const X &>(*this)[i]*u;
+				return v;
 			}
+		};
+
+		template<typename T, int rows, int columns, typename Op, typename L, typename R>
+		class Binary : public Node<Binary<T,rows,columns,Op,L,R>,T,rows,columns> {
+		public:
+			typedef Vector::Binary<T,columns,Op,typename Operand<L>::Row,typename Operand<R>::Row> Row;
+
+			constexpr Binary(L const & l, R const & r): l(l), r(r) {}
+			constexpr Row operator [] (int i) const { return Row(l[i], r[i]); }
 
 		protected:
-			Vector::Template<T,columns> e[rows];
+			typename Expression::Hold<L,Operand<L>::node>::Type l;
+			typename Expression::Hold<R,Operand<R>::node>::Type r;
+		};
+
+		template<typename T, int rows, int columns, typename Op, typename L>
+		class Scaled : public Node<Scaled<T,rows,columns,Op,L>,T,rows,columns> {
+		public:
+			typedef Vector::Scaled<T,columns,Op,typename Operand<L>::Row> Row;
+
+			constexpr Scaled(L const & l, T const & r): l(l), r(r) {}
+			constexpr Row operator [] (int i) const { return Row(l[i], r); }
+
+		protected:
+			typename Expression::Hold<L,Operand<L>::node>::Type l;
+			T r;
+		};
+
+		template<typename T, int rows, int columns, typename Op, typename L, typename R>
+		struct Operand< Binary<T,rows,columns,Op,L,R> > {
+			enum { value = true, node = true, height = rows, width = columns };
+			typedef T Type;
+			typedef typename Binary<T,rows,columns,Op,L,R>::Row Row;
+		};
+
+		template<typename T, int rows, int columns, typename Op, typename L>
+		struct Operand< Scaled<T,rows,columns,Op,L> > {
+			enum { value = true, node = true, height = rows, width = columns };
+			typedef T Type;
+			typedef typename Scaled<T,rows,columns,Op,L>::Row Row;
+		};
+
+		template<typename L, typename R>
+		struct Pair {
+			enum { value = Operand<L>::value and Operand<R>::value and int(Operand<L>::height) == int(Operand<R>::height) and int(Operand<L>::width) == int(Operand<R>::width) };
 		};
 
+#define MATH_MATRIX_BINARY(OP,OPERATION) \
+		template<typename L, typename R, typename =typename std::enable_if<Pair<L,R>::value>::type> \
+		constexpr Binary<typename Operand<L>::Type,Operand<L>::height,Operand<L>::width,Expression::OPERATION,L,R> operator OP (const L & l, const R & r) { \
+			static_assert(std::is_same<typename Operand<L>::Type,typename Operand<R>::Type>::value, "Matrix expressions need a common element type"); \
+			return Binary<typename Operand<L>::Type,Operand<L>::height,Operand<L>::width,Expression::OPERATION,L,R>(l,r); \
+		}
+
+		MATH_MATRIX_BINARY(+,Add)
+		MATH_MATRIX_BINARY(-,Subtract)
+
+#undef MATH_MATRIX_BINARY
+
+		template<typename L, typename =typename std::enable_if<Operand<L>::value>::type>
+		constexpr Scaled<typename Operand<L>::Type,Operand<L>::height,Operand<L>::width,Expression::Multiply,L> operator * (const L & l, typename Operand<L>::Type const & r) {
+			return Scaled<typename Operand<L>::Type,Operand<L>::height,Operand<L>::width,Expression::Multiply,L>(l,r);
+		}
+
 		template<typename T>
 		class Template<T,1,1> {
 		public:
-			Template(const T & x=T(1)) { e[0][0] = x; }
-			Template(const std::initializer_list< Vector::Template<T,1> > & list){
+			constexpr Template(const T & x=T(1)): e() { e[0][0] = x; }
+			constexpr Template(const Template<T,1,1> &) = default;
+			constexpr Template(const std::initializer_list< Vector::Template<T,1> > & list): e() {
 				if( list.size() != 1 )
 					throw std::exception("Initializer list has invalid length");
 				e[0] = *list.begin();
 			}
-			~Template() {}
 			typename Vector::Template<T,1> & operator [] (int i) { return e[i]; }
 			typename const Vector::Template<T,1> & operator [] (int i) const { return e[i]; }
 			typename Vector::Template<T,1> * operator & () {return e;}
@@ -178,13 +275,13 @@ namespace Math {
 		template<typename T, int rows>
 		class Template<T,rows,1> {
 		public:
-			Template(const T & x=T(1)) { e[0][0] = x; }
-			Template(const std::initializer_list<Vector::Template<T,1>> & list){
+			constexpr Template(const T & x=T(1)): e() { e[0][0] = x; }
+			constexpr Template(const Template<T,rows,1> &) = default;
+			constexpr Template(const std::initializer_list<Vector::Template<T,1>> & list): e() {
 				if(list.size() != rows) throw std::exception("Invalid list size, must equal rows!");
 				int i=0;
 				for(const auto & item : list) e[i++] = item;
 			}
-			~Template() {}
 			typename Vector::Template<T,1> & operator [] (int i) { return e[i]; }
 			typename const Vector::Template<T,1> & operator [] (int i) const { return e[i]; }
 			typename Vector::Template<T,1> * operator & () {return e;}
@@ -217,12 +314,12 @@ namespace Math {
 		template<typename T, int columns>
 		class Template<T,1,columns> {
 		public:
-			Template(const T & x=T(1)): e() {}
-			Template(const std::initializer_list< Vector::Template<T,columns> > & list){
+			constexpr Template(const T & x=T(1)): e() {}
+			constexpr Template(const Template<T,1,columns> &) = default;
+			constexpr Template(const std::initializer_list< Vector::Template<T,columns> > & list): e() {
 				if( list.size() != 1 ) throw std::exception("Invalid initializer list size, must be 1");
 				e[0] = *list.begin();
 			}
-			~Template() {}
 			typename Vector::Template<T,columns> operator [] (int i) { return Vector::Template<T,columns>(); }
 			typename const Vector::Template<T,columns> operator [] (int i) const { return Vector::Template<T,columns>(); }
 			typename Vector::Template<T,columns> * operator & () {return e;}
@@ -273,31 +370,614 @@ namespace Math {
 		};
 
 		template<typename T, int N>
-		T Trace(const Template<T,N,N> & M){
+		constexpr T Trace(const Template<T,N,N> & M){
 			T trace = T();
 			for(int i=0;i<N;i++) trace += M[i][i];
 			return trace;
 		}
 
+		namespace Kernel {
+			// column panel width of the blocked factorization, used once a block spans at least two panels //
+			const int FactorizeBlock = 64;
+
+			// n machine epsilons of the largest |a_ij| of an n x n block, a pivot at most this counts as zero in Factorize and Invert //
+			// so the singular test follows the scale of the matrix //
+			template<typename T>
+			T PivotTolerance(const T * a, int n, int stride) {
+				T largest = T(0);
+				for(int i=0;i<n;i++)
+					for(int j=0;j<n;j++) largest = Max(largest, Abs(a[size_t(i)*stride+j]));
+				return T(n)*std::numeric_limits<T>::epsilon()*largest;
+			}
+
+			// factors columns [k0,k1) of a row major n x n block with partial pivoting, pivot rows are swapped across the full width //
+			// returns the parity of the swaps made (+1/-1) or 0 when no pivot above tolerance is left in a column //
+			template<typename T>
+			int FactorizePanel(T * a, int n, int stride, int k0, int k1, int * pivot, T tolerance) {
+				int sign = 1;
+				for(int k=k0;k<k1;k++){
+					int p = k;
+					T max = Abs(a[size_t(k)*stride+k]);
+					for(int i=k+1;i<n;i++){
+						T v = Abs(a[size_t(i)*stride+k]);
+						if( v > max ) max = v, p = i;
+					}
+
+					pivot[k] = p;
+					if( max <= tolerance ) return 0;
+					if( p != k ){
+						T * r = a + size_t(k)*stride, * s = a + size_t(p)*stride;
+						for(int j=0;j<n;j++) std::swap(r[j],s[j]);
+						sign = -sign;
+					}
+
+					const T * u = a + size_t(k)*stride;
+					T inv = T(1)/u[k];
+					for(int i=k+1;i<n;i++){
+						T * r = a + size_t(i)*stride;
+						T l = r[k] *= inv;
+						for(int j=k+1;j<k1;j++) r[j] -= l*u[j];
+					}
+				}
+				return sign;
+			}
+
+			// in place LU factorization with partial pivoting of a row major n x n block, L is unit lower //
+			// large blocks are factored a panel at a time, the trailing update is a Gemm shared across Parallel workers //
+			// returns the permutation parity (+1/-1) or 0 when a pivot is at most PivotTolerance of the block //
+			template<typename T>
+			int Factorize(T * a, int n, int stride, int * pivot) {
+				const T tolerance = PivotTolerance(a, n, stride);
+				if( n < 2*FactorizeBlock ) return FactorizePanel(a, n, stride, 0, n, pivot, tolerance);
+
+				int sign = 1;
+				for(int k0=0;k0<n;k0+=FactorizeBlock){
+					const int k1 = n-k0 < FactorizeBlock ? n : k0+FactorizeBlock;
+					int s = FactorizePanel(a, n, stride, k0, k1, pivot, tolerance);
+					if( s == 0 ) return 0;
+					sign *= s;
+					if( k1 == n ) break;
+
+					// U12 = L11^-1 A12 //
+					Parallel::For(k1, n, 256, [=](size_t first, size_t last) {
+						for(int i=k0;i<k1;i++){
+							T * r = a + size_t(i)*stride;
+							for(int q=k0;q<i;q++){
+								const T l = r[q], * u = a + size_t(q)*stride;
+								for(size_t j=first;j<last;j++) r[j] -= l*u[j];
+							}
+						}
+					});
+
+					// A22 -= L21 U12 //
+					Gemm(n-k1, n-k1, k1-k0, T(-1), a + size_t(k1)*stride + k0, stride, a + size_t(k0)*stride + k1, stride, T(1), a + size_t(k1)*stride + k1, stride);
+				}
+				return sign;
+			}
+
+			// diagonal block of the triangular solves, everything outside it is a Gemm update //
+			const int SolveBlock = 64;
+
+			// right hand side columns from which the diagonal block solves are shared across Parallel workers //
+			const int SolveParallelColumns = 256;
+
+			// x -= l*y over m values //
+			template<typename T>
+			inline void Subtract(T * x, const T * y, T const & l, int m) {
+				Vector::Kernel::Sweep<T>(0, size_t(m), [&](size_t j, auto p) {
+					typedef decltype(p) Pack;
+					Simd::MultiplyAdd(Pack(-l), Pack::Load(y+j), Pack::Load(x+j)).Store(x+j);
+				});
+			}
+
+			template<typename T>
+			inline void Scale(T * x, T const & r, int m) {
+				Vector::Kernel::Sweep<T>(0, size_t(m), [&](size_t j, auto p) {
+					typedef decltype(p) Pack;
+					(Pack::Load(x+j)*Pack(r)).Store(x+j);
+				});
+			}
+
+			// sum of x[j]*y[j] over m values //
+			template<typename T>
+			inline T Dot(const T * x, const T * y, int m) {
+				typedef Simd::Pack<T> Pack;
+				const int W = Simd::Width<T>::value;
+				Pack acc(T(0));
+				int j = 0;
+				for(;j+W<=m;j+=W) acc = Simd::MultiplyAdd(Pack::Load(x+j), Pack::Load(y+j), acc);
+				T sum = Simd::Sum(acc);
+				for(;j<m;j++) sum += x[j]*y[j];
+				return sum;
+			}
+
+			template<typename Body>
+			inline void ForColumns(int m, Body body) {
+				if( m < 2*SolveParallelColumns ) return body(size_t(0), size_t(m));
+				Parallel::For(0, size_t(m), SolveParallelColumns, body);
+			}
+
+			// B = L^-1 B in place, L is the lower triangle of the row major n x n block a, B is n x m //
+			// unit takes the diagonal of L as ones without reading it //
+			template<typename T>
+			void SolveLower(int n, int m, const T * a, int lda, T * b, int ldb, bool unit) {
+				// a single contiguous right hand side is a dot product per row //
+				if( m == 1 and ldb == 1 ){
+					for(int i=0;i<n;i++){
+						const T * l = a + size_t(i)*lda;
+						b[i] -= Dot(l, b, i);
+						if( !unit ) b[i] /= l[i];
+					}
+					return;
+				}
+				for(int k0=0;k0<n;k0+=SolveBlock){
+					const int k1 = n-k0 < SolveBlock ? n : k0+SolveBlock;
+					ForColumns(m, [=](size_t first, size_t last) {
+						const int width = int(last-first);
+						for(int i=k0;i<k1;i++){
+							const T * l = a + size_t(i)*lda;
+							T * x = b + size_t(i)*ldb + first;
+							for(int q=k0;q<i;q++) Subtract(x, b + size_t(q)*ldb + first, l[q], width);
+							if( !unit ) Scale(x, T(1)/l[i], width);
+						}
+					});
+					if( k1 < n ) Gemm(n-k1, m, k1-k0, T(-1), a + size_t(k1)*lda + k0, lda, b + size_t(k0)*ldb, ldb, T(1), b + size_t(k1)*ldb, ldb);
+				}
+			}
+
+			// B = U^-1 B in place, U is the upper triangle of the row major n x n block a, B is n x m //
+			template<typename T>
+			void SolveUpper(int n, int m, const T * a, int lda, T * b, int ldb, bool unit) {
+				if( m == 1 and ldb == 1 ){
+					for(int i=n-1;i>=0;i--){
+						const T * u = a + size_t(i)*lda;
+						b[i] -= Dot(u+i+1, b+i+1, n-i-1);
+						if( !unit ) b[i] /= u[i];
+					}
+					return;
+				}
+				for(int k1=n;k1>0;k1-=SolveBlock){
+					const int k0 = k1 < SolveBlock ? 0 : k1-SolveBlock;
+					ForColumns(m, [=](size_t first, size_t last) {
+						const int width = int(last-first);
+						for(int i=k1-1;i>=k0;i--){
+							const T * u = a + size_t(i)*lda;
+							T * x = b + size_t(i)*ldb + first;
+							for(int q=i+1;q<k1;q++) Subtract(x, b + size_t(q)*ldb + first, u[q], width);
+							if( !unit ) Scale(x, T(1)/u[i], width);
+						}
+					});
+					if( k0 > 0 ) Gemm(k0, m, k1-k0, T(-1), a + k0, lda, b + size_t(k0)*ldb, ldb, T(1), b, ldb);
+				}
+			}
+
+			// swaps row k of the n x m block B with row pivot[k], in the order Factorize made them //
+			template<typename T>
+			void Permute(int n, int m, const int * pivot, T * b, int ldb) {
+				for(int k=0;k<n;k++)
+					if( pivot[k] != k ){
+						T * r = b + size_t(k)*ldb, * s = b + size_t(pivot[k])*ldb;
+						for(int j=0;j<m;j++) std::swap(r[j],s[j]);
+					}
+			}
+
+			// B = A^-1 B in place from the factors and pivots Factorize left in the n x n block a //
+			template<typename T>
+			void SolveFactored(const T * a, int n, int stride, const int * pivot, T * b, int columns, int ldb) {
+				Permute(n, columns, pivot, b, ldb);
+				SolveLower(n, columns, a, stride, b, ldb, true);
+				SolveUpper(n, columns, a, stride, b, ldb, false);
+			}
+
+			// order from which the row sweeps of Invert are shared across Parallel workers //
+			const int InvertParallelOrder = 256;
+
+			// in place Gauss-Jordan inversion with partial pivoting, perm must hold n entries //
+			// Singular once a pivot is at most PivotTolerance of a, the same test Factorize makes //
+			template<typename T>
+			Status Invert(T * a, int n, int stride, int * perm) {
+				const T tolerance = PivotTolerance(a, n, stride);
+
+				for(int k=0;k<n;k++){
+					int p = k;
+					T max = Abs(a[k*stride+k]);
+					for(int i=k+1;i<n;i++){
+						T v = Abs(a[i*stride+k]);
+						if( v > max ) max = v, p = i;
+					}
+
+					perm[k] = p;
+					if( max <= tolerance ) return Status::Singular;
+					T * u = a + k*stride;
+					if( p != k ){
+						T * s = a + p*stride;
+						for(int j=0;j<n;j++) std::swap(u[j],s[j]);
+					}
+
+					T inv = T(1)/u[k];
+					u[k] = T(1);
+					for(int j=0;j<n;j++) u[j] *= inv;
+
+					auto eliminate = [=](size_t first, size_t last) {
+						for(size_t i=first;i<last;i++){
+							if( int(i) == k ) continue;
+							T * r = a + i*stride;
+							T f = r[k];
+							r[k] = T(0);
+							for(int j=0;j<n;j++) r[j] -= f*u[j];
+						}
+					};
+					if( n >= InvertParallelOrder ) Parallel::For(0, n, 32, eliminate);
+					else eliminate(0, n);
+				}
+
+				for(int k=n-1;k>=0;k--){
+					if( perm[k] == k ) continue;
+					for(int i=0;i<n;i++) std::swap(a[i*stride+k], a[i*stride+perm[k]]);
+				}
+				return Status::Success;
+			}
+
+			template<typename T>
+			T Determinant(const T * a, int n, int stride, int sign) {
+				T det = T(sign);
+				for(int i=0;i<n;i++) det *= a[i*stride+i];
+				return det;
+			}
+
+			template<typename T, typename U>
+			T Narrow(U const & x) { return std::is_integral<T>::value ? T(std::llround(x)) : T(x); }
+
+			// whether x survives conversion to an integral T, always true for floating T //
+			template<typename T, typename U>
+			bool Fits(U const & x) {
+				if( !std::is_integral<T>::value ) return true;
+				if( std::is_integral<U>::value ) return (std::is_signed<T>::value or !(x < U(0))) and U(T(x)) == x;
+				return x > U(std::numeric_limits<T>::min()) - U(0.5) and x < U(std::numeric_limits<T>::max()) + U(0.5);
+			}
+
+			// the widest built in signed integer, the default accumulator of the exact integer kernels //
+#ifdef __SIZEOF_INT128__
+			typedef __int128 Wide;
+#else
+			typedef int64_t Wide;
+#endif
+
+			// the arithmetic Bareiss needs on an accumulator W, built in integers report overflow rather than wrap //
+			template<typename W>
+			struct Checked {
+				static bool IsZero(W const & a) { return a == W(0); }
+
+				// out = a*b - c*d //
+				static bool MultiplySubtract(W const & a, W const & b, W const & c, W const & d, W & out) {
+					W x, y;
+#if defined(__GNUC__) or defined(__clang__)
+					return !__builtin_mul_overflow(a, b, &x) and !__builtin_mul_overflow(c, d, &y) and !__builtin_sub_overflow(x, y, &out);
+#else
+					const W max = std::numeric_limits<W>::max(), min = std::numeric_limits<W>::min();
+					if( !Multiply(a, b, x) or !Multiply(c, d, y) ) return false;
+					if( y < 0 ? x > max + y : x < min + y ) return false;
+					out = x - y;
+					return true;
+#endif
+				}
+
+				// a = a/d where d is known to divide a //
+				static void DivideExact(W & a, W const & d) { a /= d; }
+
+#if !defined(__GNUC__) and !defined(__clang__)
+				static bool Multiply(W const & a, W const & b, W & out) {
+					const W max = std::numeric_limits<W>::max(), min = std::numeric_limits<W>::min();
+					if( a > 0 ? (b > 0 ? a > max/b : b < min/a) : (b > 0 ? a < min/b : a != 0 and b < max/a) ) return false;
+					out = a*b;
+					return true;
+				}
+#endif
+			};
+
+			// fraction free elimination (Bareiss) of a row major m x n block over W, every entry stays a minor of the //
+			// input so each division is exact, pivots[i] is the column of pivot row i, sign the parity of the row swaps //
+			// reduce also clears above the pivots, every pivot then holds the same rank sized minor, det(A) when A is //
+			// square and regular, with sign applied. Status::Overflow when an intermediate leaves W, the block is then lost //
+			template<typename W>
+			Status Bareiss(W * a, int m, int n, int stride, bool reduce, int * pivots, int & rank, int & sign) {
+				typedef Checked<W> C;
+				W previous(1);
+				rank = 0, sign = 1;
+				for(int c=0;c<n and rank<m;c++){
+					int p = rank;
+					while( p < m and C::IsZero(a[size_t(p)*stride+c]) ) p++;
+					if( p == m ) continue;
+					if( p != rank ){
+						W * r = a + size_t(rank)*stride, * s = a + size_t(p)*stride;
+						for(int j=0;j<n;j++) std::swap(r[j],s[j]);
+						sign = -sign;
+					}
+
+					const W * r = a + size_t(rank)*stride;
+					for(int i=reduce ? 0 : rank+1;i<m;i++){
+						if( i == rank ) continue;
+						W * s = a + size_t(i)*stride;
+						// rows above the pivot still carry the earlier pivots and free columns left of c, rows below are zero there //
+						for(int j=i < rank ? 0 : c+1;j<n;j++){
+							if( j == c ) continue;
+							if( !C::MultiplySubtract(r[c], s[j], s[c], r[j], s[j]) ) return Status::Overflow;
+							C::DivideExact(s[j], previous);
+						}
+						s[c] = W(0);
+					}
+					previous = r[c];
+					pivots[rank++] = c;
+				}
+				return Status::Success;
+			}
+
+			// exact determinant of an n x n block of T with rows stride apart, accumulated in W //
+			template<typename W, typename T>
+			Status ExactDeterminant(const T * a, int n, int stride, W & det) {
+				std::vector<W> b(size_t(n)*n);
+				std::vector<int> pivots(static_cast<size_t>(n));
+				for(int i=0;i<n;i++)
+					for(int j=0;j<n;j++) b[size_t(i)*n+j] = W(a[size_t(i)*stride+j]);
+				int rank = 0, sign = 1;
+				const Status status = Bareiss(b.data(), n, n, n, false, pivots.data(), rank, sign);
+				if( status != Status::Success ) return status;
+				det = rank < n ? W(0) : n == 0 ? W(1) : sign > 0 ? b[size_t(n)*n-1] : W(0) - b[size_t(n)*n-1];
+				return Status::Success;
+			}
+
+			// det through ExactDeterminant in Wide for integral T, status is Status::Overflow and det 0 when the exact value //
+			// lies outside T, false for other T or when Wide itself overflows and LU has to take over //
+			template<typename T>
+			bool IntegralDeterminant(const T * a, int n, int stride, T & det, Status & status, std::true_type) {
+				Wide exact;
+				if( ExactDeterminant(a, n, stride, exact) != Status::Success ) return false;
+				status = Fits<T>(exact) ? Status::Success : Status::Overflow;
+				det = status == Status::Success ? T(exact) : T();
+				return true;
+			}
+
+			template<typename T>
+			bool IntegralDeterminant(const T *, int, int, T &, Status &, std::false_type) { return false; }
+
+			// unrolled closed forms over row major entries, V is either a scalar or a Simd::Pack of matrices //
+			template<int N>
+			struct Closed;
+
+			// a closed form inverse is Singular once |det| is at most N machine epsilons of largest|a_ij|^N, the scale of any //
+			// N x N determinant over those entries, which matches the PivotTolerance test of Invert, integral T needs |det| >= 1 //
+			template<typename T, int N, typename V>
+			V SingularDeterminant(V const & largest) {
+				typedef typename Real<T>::Type Type;
+				if( std::is_integral<T>::value ) return V(Type(0.5));
+				V power = largest;
+				for(int i=1;i<N;i++) power = power*largest;
+				return power*V(Type(N)*std::numeric_limits<Type>::epsilon());
+			}
+
+			template<>
+			struct Closed<2> {
+				template<typename V>
+				static V Determinant(const V * a) { return a[0]*a[3] - a[1]*a[2]; }
+
+				template<typename V>
+				static V Adjugate(const V * a, V * b) {
+					b[0] =  a[3], b[1] = -a[1];
+					b[2] = -a[2], b[3] =  a[0];
+					return Determinant(a);
+				}
+			};
+
+			template<>
+			struct Closed<3> {
+				template<typename V>
+				static V Determinant(const V * a) {
+					return a[0]*(a[4]*a[8] - a[5]*a[7])
+						+ a[1]*(a[5]*a[6] - a[3]*a[8])
+						+ a[2]*(a[3]*a[7] - a[4]*a[6]);
+				}
+
+				template<typename V>
+				static V Adjugate(const V * a, V * b) {
+					b[0] = a[4]*a[8] - a[5]*a[7];
+					b[3] = a[5]*a[6] - a[3]*a[8];
+					b[6] = a[3]*a[7] - a[4]*a[6];
+					b[1] = a[2]*a[7] - a[1]*a[8];
+					b[4] = a[0]*a[8] - a[2]*a[6];
+					b[7] = a[1]*a[6] - a[0]*a[7];
+					b[2] = a[1]*a[5] - a[2]*a[4];
+					b[5] = a[2]*a[3] - a[0]*a[5];
+					b[8] = a[0]*a[4] - a[1]*a[3];
+					return a[0]*b[0] + a[1]*b[3] + a[2]*b[6];
+				}
+			};
+
+			template<>
+			struct Closed<4> {
+				template<typename V>
+				static V Determinant(const V * a) {
+					V s0 = a[0]*a[5] - a[4]*a[1], s1 = a[0]*a[6] - a[4]*a[2], s2 = a[0]*a[7] - a[4]*a[3];
+					V s3 = a[1]*a[6] - a[5]*a[2], s4 = a[1]*a[7] - a[5]*a[3], s5 = a[2]*a[7] - a[6]*a[3];
+					V c0 = a[8]*a[13] - a[12]*a[9], c1 = a[8]*a[14] - a[12]*a[10], c2 = a[8]*a[15] - a[12]*a[11];
+					V c3 = a[9]*a[14] - a[13]*a[10], c4 = a[9]*a[15] - a[13]*a[11], c5 = a[10]*a[15] - a[14]*a[11];
+					return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+				}
+
+				// 2x2 minors of the top and bottom row pairs are shared between the determinant and every cofactor //
+				template<typename V>
+				static V Adjugate(const V * a, V * b) {
+					V s0 = a[0]*a[5] - a[4]*a[1], s1 = a[0]*a[6] - a[4]*a[2], s2 = a[0]*a[7] - a[4]*a[3];
+					V s3 = a[1]*a[6] - a[5]*a[2], s4 = a[1]*a[7] - a[5]*a[3], s5 = a[2]*a[7] - a[6]*a[3];
+					V c0 = a[8]*a[13] - a[12]*a[9], c1 = a[8]*a[14] - a[12]*a[10], c2 = a[8]*a[15] - a[12]*a[11];
+					V c3 = a[9]*a[14] - a[13]*a[10], c4 = a[9]*a[15] - a[13]*a[11], c5 = a[10]*a[15] - a[14]*a[11];
+
+					b[0]  =  a[5]*c5 - a[6]*c4 + a[7]*c3;
+					b[1]  = -a[1]*c5 + a[2]*c4 - a[3]*c3;
+					b[2]  =  a[13]*s5 - a[14]*s4 + a[15]*s3;
+					b[3]  = -a[9]*s5 + a[10]*s4 - a[11]*s3;
+					b[4]  = -a[4]*c5 + a[6]*c2 - a[7]*c1;
+					b[5]  =  a[0]*c5 - a[2]*c2 + a[3]*c1;
+					b[6]  = -a[12]*s5 + a[14]*s2 - a[15]*s1;
+					b[7]  =  a[8]*s5 - a[10]*s2 + a[11]*s1;
+					b[8]  =  a[4]*c4 - a[5]*c2 + a[7]*c0;
+					b[9]  = -a[0]*c4 + a[1]*c2 - a[3]*c0;
+					b[10] =  a[12]*s4 - a[13]*s2 + a[15]*s0;
+					b[11] = -a[8]*s4 + a[9]*s2 - a[11]*s0;
+					b[12] = -a[4]*c3 + a[5]*c1 - a[6]*c0;
+					b[13] =  a[0]*c3 - a[1]*c1 + a[2]*c0;
+					b[14] = -a[12]*s3 + a[13]*s1 - a[14]*s0;
+					b[15] =  a[8]*s3 - a[9]*s1 + a[10]*s0;
+					return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+				}
+			};
+
+			// integral entries are exact in Kernel::Wide, and past it the closed form is taken in double and checked against T //
+			template<typename T, int N>
+			T Determinant(const Template<T,N,N> & M, Status * status) {
+				if( status ) *status = Status::Success;
+				T exact;
+				Status result;
+				if( IntegralDeterminant(&M[0][0], N, int(sizeof(Vector::Template<T,N>)/sizeof(T)), exact, result, std::is_integral<T>()) ){
+					if( status ) *status = result;
+					return exact;
+				}
+
+				typedef typename Real<T>::Type Type;
+				Type a[N*N];
+				for(int i=0;i<N;i++)
+					for(int j=0;j<N;j++) a[i*N+j] = Type(M[i][j]);
+				Type det = Closed<N>::Determinant(a);
+				if( std::is_integral<T>::value ){
+					if( Fits<T>(det) ) return Narrow<T>(det);
+					if( status ) *status = Status::Overflow;
+					return T();
+				}
+				return Abs(det) <= Epsilon<Type>() ? T() : T(det);
+			}
+
+			template<typename T, int N>
+			Status Inverse(Template<T,N,N> & dst, const Template<T,N,N> & src) {
+				typedef typename Real<T>::Type Type;
+				Type a[N*N], b[N*N];
+				for(int i=0;i<N;i++)
+					for(int j=0;j<N;j++) a[i*N+j] = Type(src[i][j]);
+
+				Type largest = Type(0);
+				for(int k=0;k<N*N;k++) largest = Max(largest, Abs(a[k]));
+				Type det = Closed<N>::Adjugate(a,b);
+				bool singular = Abs(det) <= SingularDeterminant<T,N>(largest);
+				Type inv = singular ? Type(0) : Type(1)/(singular ? Type(1) : det);
+				for(int i=0;i<N;i++)
+					for(int j=0;j<N;j++) dst[i][j] = Narrow<T>(b[i*N+j]*inv);
+				return singular ? Status::Singular : Status::Success;
+			}
+
+			// runs the snap pass of P over an inverse, as the general sized path does, and hands status back //
+			template<typename P, typename T, int N>
+			Status Finished(Template<T,N,N> & M, Status status) {
+				if( Math::Kernel::Finish<P>::snaps )
+					for(int i=0;i<N;i++)
+						for(int j=0;j<N;j++) Snap<P>(M[i][j]);
+				return status;
+			}
+		}
+
 		template<typename T, int N>
-		T Determinant(const Template<T,N,N> & M) {
-			switch(N) {
-			case 0: return T();
-			case 1: return M[0][0];
-			default: break;
+		class LU {
+		public:
+			typedef typename Real<T>::Type Type;
+
+			LU(const Template<T,N,N> & M) {
+				for(int i=0;i<N;i++)
+					for(int j=0;j<N;j++) a[i*N+j] = Type(M[i][j]);
+				sign = Kernel::Factorize(a, N, N, pivot);
 			}
 
-			int k=0;
-			T det = T();
-			for(uint32_t i=0;i<N;i++){
-				k = i%2 ? -1 : 1;
-				det += k*M[0][i]*Determinant( M.Reduced(0,i) );
+			~LU() {}
+
+			int Size() const { return N; }
+			int Sign() const { return sign; }
+			int Pivot(int k) const { return pivot[k]; }
+			bool IsSingular() const { return sign == 0; }
+			Status GetStatus() const { return sign == 0 ? Status::Singular : Status::Success; }
+
+			// 0 with Status::Overflow when an integral T cannot hold the result //
+			T Determinant(Status * status =nullptr) const {
+				if( status ) *status = Status::Success;
+				if( IsSingular() ) return T();
+				Type det = Kernel::Determinant(a, N, N, sign);
+				if( std::is_integral<T>::value ){
+					if( Kernel::Fits<T>(det) ) return Kernel::Narrow<T>(det);
+					if( status ) *status = Status::Overflow;
+					return T();
+				}
+				return Abs(det) <= Epsilon<Type>() ? T() : T(det);
 			}
-			return Abs(det) <= Epsilon<T>() ? T() : det;
+
+			// B = A^-1 B in place, B is N x columns with rows stride apart //
+			void SolveInto(Type * b, int columns, int stride) const {
+				assert(!IsSingular());
+				Kernel::SolveFactored(a, N, N, pivot, b, columns, stride);
+			}
+
+			Vector::Template<Type,N> Solve(const Vector::Template<T,N> & b) const {
+				Vector::Template<Type,N> x;
+				for(int i=0;i<N;i++) x[i] = Type(b[i]);
+				SolveInto(&x, 1, 1);
+				return x;
+			}
+
+			const Type & operator () (int i, int j) const { return a[i*N+j]; }
+			const Type * operator & () const { return a; }
+
+			Template<Type,N,N> Lower() const {
+				Template<Type,N,N> L(Type(0));
+				for(int i=0;i<N;i++){
+					for(int j=0;j<i;j++) L[i][j] = a[i*N+j];
+					L[i][i] = Type(1);
+				}
+				return L;
+			}
+
+			Template<Type,N,N> Upper() const {
+				Template<Type,N,N> U(Type(0));
+				for(int i=0;i<N;i++)
+					for(int j=i;j<N;j++) U[i][j] = a[i*N+j];
+				return U;
+			}
+
+		protected:
+			Type a[N > 0 ? N*N : 1];
+			int pivot[N > 0 ? N : 1];
+			int sign;
+		};
+
+		// integral entries go through exact fraction free elimination, and through LU in double only when Kernel::Wide overflows //
+		// a determinant that does not fit an integral T comes back as 0 with Status::Overflow rather than wrapped //
+		template<typename T, int N>
+		T Determinant(const Template<T,N,N> & M, Status * status =nullptr) {
+			if( status ) *status = Status::Success;
+			if( N == 0 ) return T();
+			T det;
+			Status result;
+			if( Kernel::IntegralDeterminant(&M[0][0], N, int(sizeof(Vector::Template<T,N>)/sizeof(T)), det, result, std::is_integral<T>()) ){
+				if( status ) *status = result;
+				return det;
+			}
+			return LU<T,N>(M).Determinant(status);
 		}
 
+		template<typename T>
+		T Determinant(const Template<T,2,2> & M, Status * status =nullptr) { return Kernel::Determinant(M, status); }
+
+		template<typename T>
+		T Determinant(const Template<T,3,3> & M, Status * status =nullptr) { return Kernel::Determinant(M, status); }
+
+		template<typename T>
+		T Determinant(const Template<T,4,4> & M, Status * status =nullptr) { return Kernel::Determinant(M, status); }
+
 		template<typename T, int rows, int columns>
-		typename Template<T,columns,rows> Transpose(const Template<T,rows,columns> & M) {
+		constexpr Template<T,columns,rows> Transpose(const Template<T,rows,columns> & M) {
 			Template<T,columns,rows> transpose;
 			for(int i=0;i<rows;i++){
 				for(int j=0;j<columns;j++){
@@ -307,89 +987,647 @@ namespace Math {
 			return transpose;
 		}
 
-		template<typename T, int rows, int common, int columns>
-		typename Template<T,rows,columns> Transform(const Template<T,rows,common> & A, const Template<T,common,columns> & B){
-			Template<T,rows,columns> C;
-			Template<T,columns,common> Bt = Transpose(B);
+		// products at least this many multiply-adds go through the packed Gemm kernel //
+		const int TransformKernelThreshold = 16*16*16;
+
+		// C = alpha*A*B + beta*C, C must not alias A or B, every element is finished under policy P //
+		template<typename P =Policy::Default, typename T, int rows, int common, int columns>
+		void TransformInto(Template<T,rows,columns> & C, const Template<T,rows,common> & A, const Template<T,common,columns> & B, T const & alpha =T(1), T const & beta =T(0)) {
+			if( rows*common*columns >= TransformKernelThreshold ){
+				const Vector::Template<T,common> * a = &A;
+				const Vector::Template<T,columns> * b = &B;
+				Vector::Template<T,columns> * c = &C;
+				const int lda = sizeof(Vector::Template<T,common>)/sizeof(T), ldb = sizeof(Vector::Template<T,columns>)/sizeof(T);
+				Gemm(rows, columns, common, alpha, &a[0], lda, &b[0], ldb, beta, &c[0], ldb);
+
+				// Gemm keeps its sums in registers, so P finishes the elements in one pass over C afterwards //
+				if( Math::Kernel::Finish<P>::snaps ){
+					for(int i=0;i<rows;i++)
+						for(int j=0;j<columns;j++) Snap<P>(C[i][j]);
+				}
+				return;
+			}
+
 			for(int i=0;i<rows;i++){
+				T sum[columns];
+				for(int j=0;j<columns;j++) sum[j] = T(0);
+				for(int k=0;k<common;k++){
+					const T a = A[i][k];
+					for(int j=0;j<columns;j++) sum[j] += a*B[k][j];
+				}
 				for(int j=0;j<columns;j++){
-					C[i][j] = A[i]*Bt[j];
-					AutoCorrect(C[i][j]);
+					T & index = C[i][j];
+					index = beta == T(0) ? alpha*sum[j] : alpha*sum[j] + beta*index;
+					Snap<P>(index);
 				}
 			}
+		}
+
+		template<typename P =Policy::Default, typename T, int rows, int common, int columns>
+		constexpr Template<T,rows,columns> Transform(const Template<T,rows,common> & A, const Template<T,common,columns> & B){
+			Template<T,rows,columns> C;
+			if( MATH_CONSTANT_EVALUATED() ){
+				for(int i=0;i<rows;i++)
+					for(int j=0;j<columns;j++){
+						T sum = T(0);
+						for(int k=0;k<common;k++) sum += A[i][k]*B[k][j];
+						C[i][j] = sum;
+					}
+			}
+			else TransformInto<P>(C,A,B);
 			return C;
 		}
 
+		namespace Kernel {
+
+			// outputs larger than this are written with streaming stores, ranges longer than PointGrain are split across Parallel workers //
+			const size_t StreamBytes = size_t(1) << 22;
+			const size_t PointGrain = 1 << 14;
+
+			// out = column[0]*in[0] + ... + column[columns-1]*in[columns-1] (+ column[columns] when affine) for each point //
+			// the columns stay in registers, whole writes the full padded lanes of the output, stream bypasses the cache //
+			template<typename T, int rows, int columns, bool affine, bool whole, bool stream>
+			void TransformPoints(const Simd::Pack<T,Vector::Storage<T,rows>::lanes> * column, const T * in, size_t is, T * out, size_t os, size_t first, size_t last) {
+				typedef Simd::Pack<T,Vector::Storage<T,rows>::lanes> Column;
+				const Column c0 = column[0], c1 = column[columns > 1 ? 1 : 0], c2 = column[columns > 2 ? 2 : 0], c3 = column[columns > 3 ? 3 : 0];
+				const Column t = column[affine ? columns : 0];
+				for(size_t i=first;i<last;i++){
+					const T * u = in + i*is;
+					T * v = out + i*os;
+					Column r = affine ? Simd::MultiplyAdd(c0, Column(u[0]), t) : c0*Column(u[0]);
+					if( columns > 1 ) r = Simd::MultiplyAdd(c1, Column(u[1]), r);
+					if( columns > 2 ) r = Simd::MultiplyAdd(c2, Column(u[2]), r);
+					if( columns > 3 ) r = Simd::MultiplyAdd(c3, Column(u[3]), r);
+					for(int j=4;j<columns;j++) r = Simd::MultiplyAdd(column[j], Column(u[j]), r);
+
+					if( stream ) Simd::Stream(v, r);
+					else if( whole ) r.Store(v);
+					else for(int j=0;j<rows;j++) v[j] = r[j];
+				}
+			}
+
+			// splits the range across workers and picks streaming stores for large outputs written in whole registers //
+			template<typename T, int rows, int columns, bool affine, bool whole, typename Matrix>
+			void TransformPoints(const Matrix & M, const T * in, size_t is, T * out, size_t os, size_t count, bool stream) {
+				typedef Simd::Pack<T,Vector::Storage<T,rows>::lanes> Column;
+				Column column[columns+1];
+				for(int j=0;j<columns+affine;j++)
+					for(int i=0;i<Column::Lanes();i++) column[j][i] = i < rows ? M[i][j] : T(0);
+
+				stream = stream and whole and count*os*sizeof(T) >= StreamBytes and Vector::Storage<T,rows>::alignment >= 16;
+				auto body = [&](size_t first, size_t last) {
+					if( stream ) TransformPoints<T,rows,columns,affine,whole,true>(column, in, is, out, os, first, last);
+					else TransformPoints<T,rows,columns,affine,whole,false>(column, in, is, out, os, first, last);
+				};
+				if( count <= PointGrain ) body(0, count);
+				else Parallel::For(0, count, PointGrain, body);
+				if( stream ) Simd::Fence();
+			}
+		}
+
+		// out[i] = M*in[i] for count vectors, out must not overlap in unless it is in //
+		template<typename T, int rows, int columns>
+		void TransformPoints(const Template<T,rows,columns> & M, const Vector::Template<T,columns> * in, Vector::Template<T,rows> * out, size_t count) {
+			const size_t is = sizeof(Vector::Template<T,columns>)/sizeof(T), os = sizeof(Vector::Template<T,rows>)/sizeof(T);
+			Kernel::TransformPoints<T,rows,columns,false,true>(M, &in[0], is, &out[0], os, count, (void *)in != (void *)out);
+		}
+
+		// in place, points[i] = M*points[i] //
 		template<typename T, int N>
-		typename Template<T,N,N> Identity() {
+		void TransformPoints(const Template<T,N,N> & M, Vector::Template<T,N> * points, size_t count) { TransformPoints(M, points, points, count); }
+
+		// affine transform of 3 component points, the 4x4 is taken as [R t; 0 1] so out[i] = R*in[i] + t //
+		template<typename T>
+		void TransformPoints(const Template<T,4,4> & M, const Vector::Template<T,3> * in, Vector::Template<T,3> * out, size_t count) {
+			const size_t stride = sizeof(Vector::Template<T,3>)/sizeof(T);
+			Kernel::TransformPoints<T,3,3,true,true>(M, &in[0], stride, &out[0], stride, count, (void *)in != (void *)out);
+		}
+
+		template<typename T>
+		void TransformPoints(const Template<T,4,4> & M, Vector::Template<T,3> * points, size_t count) { TransformPoints(M, points, points, count); }
+
+		// components of point i start at in + i*inStride and out + i*outStride, for interleaved or externally laid out buffers //
+		template<typename T, int rows, int columns>
+		void TransformPoints(const Template<T,rows,columns> & M, const T * in, size_t inStride, T * out, size_t outStride, size_t count) {
+			Kernel::TransformPoints<T,rows,columns,false,false>(M, in, inStride, out, outStride, count, false);
+		}
+
+		template<typename T, int N>
+		constexpr Template<T,N,N> Identity() {
 			Template<T,N,N> ident;
 			for(int i=0;i<N;i++) for(int j=0;j<N;j++) ident[i][j] = i==j ? T(1) : T(0);
 			return ident;
 		}
 
 		template<typename T, int rows, int columns>
-		typename Template<T,rows,columns> Zero() { return Template<T,rows,columns>(T(0)); }
+		constexpr Template<T,rows,columns> Zero() { return Template<T,rows,columns>(T(0)); }
+
+		template<typename P =Policy::Default, typename T, int N>
+		Status InverseInto(Template<T,N,N> & dst, const Template<T,N,N> & src) {
+			int perm[N];
+			if( std::is_integral<T>::value ){
+				typedef typename Real<T>::Type Type;
+				Type a[N*N];
+				for(int i=0;i<N;i++)
+					for(int j=0;j<N;j++) a[i*N+j] = Type(src[i][j]);
+				Status status = Kernel::Invert(a, N, N, perm);
+				for(int i=0;i<N;i++)
+					for(int j=0;j<N;j++) dst[i][j] = Kernel::Narrow<T>(a[i*N+j]);
+				return status;
+			}
 
-		template<typename T, int N, int columns>
-		typename Template<T,N,N> Inverse(const Template<T,N,columns> & master) {
+			if( &dst != &src ) dst = src;
+			const int stride = sizeof(Vector::Template<T,N>)/sizeof(T);
+			Status status = Kernel::Invert(&dst[0], N, stride, perm);
+			for(int i=0;i<N;i++)
+				for(int j=0;j<N;j++) Snap<P>(dst[i][j]);
+			return status;
+		}
+
+		template<typename P =Policy::Default, typename T, int N>
+		Template<T,N,N> Inverse(const Template<T,N,N> & master, Status * status =nullptr) {
 			Template<T,N,N> inverse;
-			T det = Determinant(master);
-			int k=0;
-			if( Equals<T>(det,T()) ) throw std::exception("Unable to invert dependant matrix");
-			switch(N){
-			case 1: inverse[0][0] = 1/master[0][0];
-				break;
-			default:
-				for(int i=0;i<N;i++) {
-					for(int j=0;j<N;j++) {
-						k = (i+j)%2 ? -1 : 1;
-						auto & index = inverse[i][j];
-						index = k*Determinant(master.Reduced(i,j))/det;
-						AutoCorrect(index);
-					}
+			Status result = InverseInto<P>(inverse, master);
+			if( status ) *status = result;
+			return result == Status::Success ? inverse : Zero<T,N,N>();
+		}
+
+		template<typename P =Policy::Default, typename T>
+		Status InverseInto(Template<T,2,2> & dst, const Template<T,2,2> & src) { return Kernel::Finished<P>(dst, Kernel::Inverse(dst,src)); }
+
+		template<typename P =Policy::Default, typename T>
+		Status InverseInto(Template<T,3,3> & dst, const Template<T,3,3> & src) { return Kernel::Finished<P>(dst, Kernel::Inverse(dst,src)); }
+
+		template<typename P =Policy::Default, typename T>
+		Status InverseInto(Template<T,4,4> & dst, const Template<T,4,4> & src) { return Kernel::Finished<P>(dst, Kernel::Inverse(dst,src)); }
+
+		// inverts count 2x2, 3x3 or 4x4 matrices, a lane group of matrices is evaluated at once through Simd::Pack //
+		// singular entries are written as zero matrices, returns how many were singular //
+		template<typename T, int N>
+		size_t InverseBatch(Template<T,N,N> * dst, const Template<T,N,N> * src, size_t count, Status * status =nullptr) {
+			static_assert(N >= 2 and N <= 4, "InverseBatch is only available for 2x2, 3x3 and 4x4 matrices");
+			typedef typename Real<T>::Type Type;
+			typedef Simd::Pack<Type> Lane;
+			const int L = Simd::Width<Type>::value;
+
+			size_t singular = 0;
+			for(size_t base=0;base<count;base+=L){
+				int n = count-base < size_t(L) ? int(count-base) : L;
+				Lane a[N*N], b[N*N];
+				for(int l=0;l<L;l++){
+					for(int i=0;i<N;i++)
+						for(int j=0;j<N;j++) a[i*N+j][l] = l < n ? Type(src[base+l][i][j]) : Type(i == j);
+				}
+
+				Lane largest = Simd::Abs(a[0]);
+				for(int k=1;k<N*N;k++) largest = Simd::Max(largest, Simd::Abs(a[k]));
+				const Lane tolerance = Kernel::SingularDeterminant<T,N>(largest);
+				Lane det = Kernel::Closed<N>::Adjugate(a,b), inv;
+				bool zero[L];
+				for(int l=0;l<L;l++){
+					zero[l] = Abs(det[l]) <= tolerance[l];
+					inv[l] = zero[l] ? Type(0) : Type(1)/(zero[l] ? Type(1) : det[l]);
+				}
+				for(int k=0;k<N*N;k++) b[k] *= inv;
+
+				for(int l=0;l<n;l++){
+					for(int i=0;i<N;i++)
+						for(int j=0;j<N;j++) dst[base+l][i][j] = Kernel::Narrow<T>(b[i*N+j][l]);
+					singular += zero[l];
+					if( status ) status[base+l] = zero[l] ? Status::Singular : Status::Success;
 				}
-				break;
 			}
-			return Transpose(inverse);
+			return singular;
+		}
+
+		// runtime sized row major matrix over one 64 byte aligned heap block, M[i] is a pointer to row i //
+		template<typename T>
+		class Dynamic {
+		public:
+			Dynamic(int rows =0, int columns =0, T const & x =T()): e(AlignedAlloc<T>(size_t(rows)*columns)), rows(rows), columns(columns) {
+				for(size_t i=0;i<Size();i++) e[i] = x;
+			}
+
+			Dynamic(const std::initializer_list< std::initializer_list<T> > & list): e(nullptr), rows(int(list.size())), columns(0) {
+				if( rows ) columns = int(list.begin()->size());
+				e = AlignedAlloc<T>(Size());
+				int i=0;
+				for(const auto & row : list){
+					assert(int(row.size()) == columns);
+					for(const auto & item : row) e[i++] = item;
+				}
+			}
+
+			template<int r, int c>
+			Dynamic(const Template<T,r,c> & M): e(AlignedAlloc<T>(r*c)), rows(r), columns(c) {
+				for(int i=0;i<rows;i++)
+					for(int j=0;j<columns;j++) e[i*columns+j] = M[i][j];
+			}
+
+			Dynamic(const Dynamic<T> & M): e(AlignedAlloc<T>(M.Size())), rows(M.rows), columns(M.columns) {
+				for(size_t i=0;i<Size();i++) e[i] = M.e[i];
+			}
+
+			Dynamic(Dynamic<T> && M) noexcept : e(M.e), rows(M.rows), columns(M.columns) {
+				M.e = nullptr;
+				M.rows = M.columns = 0;
+			}
+
+			~Dynamic() { AlignedFree(e); }
+
+			int Rows() const { return rows; }
+			int Columns() const { return columns; }
+			size_t Size() const { return size_t(rows)*columns; }
+			bool HasDeterminant() const { return rows == columns; }
+
+			// contents are discarded when the shape changes //
+			void Resize(int r, int c) {
+				if( r == rows and c == columns ) return;
+				if( size_t(r)*c != Size() ){
+					AlignedFree(e);
+					e = AlignedAlloc<T>(size_t(r)*c);
+				}
+				rows = r, columns = c;
+				for(size_t i=0;i<Size();i++) e[i] = T();
+			}
+
+			std::string ToString() const {
+				if( Size() == 0 ) return "[]";
+				std::string string = "[";
+				for(int i=0;i<rows;i++)
+					string += Stringz::Strip(Row(i).ToString(), "<>") + "; ";
+				return string.substr(0,string.length()-2) + "]";
+			}
+
+			Vector::Dynamic<T> Row(int r) const {
+				Vector::Dynamic<T> row(columns);
+				for(int i=0;i<columns;i++) row[i] = e[r*columns+i];
+				return row;
+			}
+
+			Vector::Dynamic<T> Column(int c) const {
+				Vector::Dynamic<T> column(rows);
+				for(int i=0;i<rows;i++) column[i] = e[i*columns+c];
+				return column;
+			}
+
+			Dynamic<T> Reduced(int r, int c) const {
+				Dynamic<T> reduced(rows-1,columns-1);
+				T * d = &reduced;
+				for(int i=0;i<rows;i++){
+					if(i == r) continue;
+					for(int j=0;j<columns;j++)
+						if(j != c) *d++ = e[i*columns+j];
+				}
+				return reduced;
+			}
+
+			T * operator [] (int r) { return e + size_t(r)*columns; }
+			const T * operator [] (int r) const { return e + size_t(r)*columns; }
+
+			T & operator () (int r, int c) { return e[size_t(r)*columns+c]; }
+			const T & operator () (int r, int c) const { return e[size_t(r)*columns+c]; }
+
+			T * operator & () { return e; }
+			const T * operator & () const { return e; }
+
+			bool operator == (const Dynamic<T> & M) const {
+				if( rows != M.rows or columns != M.columns ) return false;
+				for(size_t i=0;i<Size();i++)
+					if( e[i] != M.e[i] ) return false;
+				return true;
+			}
+
+			bool operator != (const Dynamic<T> & M) const { return !operator==(M); }
+
+			Dynamic<T> & operator = (const Dynamic<T> & M) {
+				if( this == std::addressof(M) ) return *this;
+				Resize(M.rows,M.columns);
+				for(size_t i=0;i<Size();i++) e[i] = M.e[i];
+				return *this;
+			}
+
+			Dynamic<T> & operator = (Dynamic<T> && M) noexcept {
+				std::swap(e,M.e);
+				std::swap(rows,M.rows);
+				std::swap(columns,M.columns);
+				return *this;
+			}
+
+			Dynamic<T> & operator += (const Dynamic<T> & M) {
+				assert(rows == M.rows and columns == M.columns);
+				for(size_t i=0;i<Size();i++) e[i] += M.e[i];
+				return *this;
+			}
+
+			Dynamic<T> & operator -= (const Dynamic<T> & M) {
+				assert(rows == M.rows and columns == M.columns);
+				for(size_t i=0;i<Size();i++) e[i] -= M.e[i];
+				return *this;
+			}
+
+			Dynamic<T> & operator *= (T const & r) {
+				for(size_t i=0;i<Size();i++) e[i] *= r;
+				return *this;
+			}
+
+			Vector::Dynamic<T> operator * (const Vector::Dynamic<T> & u) const {
+				assert(columns == u.GetSize());
+				Vector::Dynamic<T> v(rows);
+				const T * x = &u;
+				for(int i=0;i<rows;i++){
+					const T * row = e + size_t(i)*columns;
+					T sum = T(0);
+					for(int j=0;j<columns;j++) sum += row[j]*x[j];
+					v[i] = sum;
+				}
+				return v;
+			}
+
+			Dynamic<T> operator + (const Dynamic<T> & M) const {
+				Dynamic<T> A = *this;
+				return std::move(A += M);
+			}
+
+			Dynamic<T> operator - (const Dynamic<T> & M) const {
+				Dynamic<T> A = *this;
+				return std::move(A -= M);
+			}
+
+			Dynamic<T> operator * (T const & r) const {
+				Dynamic<T> A = *this;
+				return std::move(A *= r);
+			}
+
+		protected:
+			T * e;
+			int rows, columns;
+		};
+
+		template<typename T>
+		T Trace(const Dynamic<T> & M) {
+			T trace = T();
+			for(int i=0;i<M.Rows() and i<M.Columns();i++) trace += M(i,i);
+			return trace;
+		}
+
+		template<typename T>
+		Dynamic<T> Transpose(const Dynamic<T> & M) {
+			Dynamic<T> transpose(M.Columns(),M.Rows());
+			for(int i=0;i<M.Rows();i++)
+				for(int j=0;j<M.Columns();j++) transpose(j,i) = M(i,j);
+			return transpose;
+		}
+
+		// C = alpha*A*B + beta*C, C is reshaped when its shape does not match, C must not alias A or B //
+		template<typename T>
+		void TransformInto(Dynamic<T> & C, const Dynamic<T> & A, const Dynamic<T> & B, T const & alpha =T(1), T const & beta =T(0)) {
+			assert(A.Columns() == B.Rows());
+			if( C.Rows() != A.Rows() or C.Columns() != B.Columns() ) C.Resize(A.Rows(),B.Columns());
+			Gemm(A.Rows(), B.Columns(), A.Columns(), alpha, &A, A.Columns(), &B, B.Columns(), beta, &C, C.Columns());
+		}
+
+		template<typename T>
+		Dynamic<T> Transform(const Dynamic<T> & A, const Dynamic<T> & B) {
+			Dynamic<T> C(A.Rows(),B.Columns());
+			TransformInto(C,A,B);
+			return C;
+		}
+
+		template<typename T>
+		Dynamic<T> Identity(int n) {
+			Dynamic<T> ident(n,n);
+			for(int i=0;i<n;i++) ident(i,i) = T(1);
+			return ident;
+		}
+
+		template<typename T>
+		Dynamic<T> Zero(int rows, int columns) { return Dynamic<T>(rows,columns); }
+
+		template<typename T>
+		T Determinant(const Dynamic<T> & M, Status * status =nullptr) {
+			assert(M.HasDeterminant());
+			typedef typename Real<T>::Type Type;
+			if( status ) *status = Status::Success;
+			const int n = M.Rows();
+			if( n == 0 ) return T();
+			T exact;
+			Status result;
+			if( Kernel::IntegralDeterminant(&M, n, n, exact, result, std::is_integral<T>()) ){
+				if( status ) *status = result;
+				return exact;
+			}
+
+			Type * a = AlignedAlloc<Type>(M.Size());
+			int * pivot = new int[n];
+			for(size_t i=0;i<M.Size();i++) a[i] = Type((&M)[i]);
+			int sign = Kernel::Factorize(a, n, n, pivot);
+			Type det = sign ? Kernel::Determinant(a, n, n, sign) : Type();
+			AlignedFree(a);
+			delete [] pivot;
+
+			if( std::is_integral<T>::value ){
+				if( Kernel::Fits<T>(det) ) return Kernel::Narrow<T>(det);
+				if( status ) *status = Status::Overflow;
+				return T();
+			}
+			return Abs(det) <= Epsilon<Type>() ? T() : T(det);
+		}
+
+		template<typename T>
+		Status InverseInto(Dynamic<T> & dst, const Dynamic<T> & src) {
+			assert(src.HasDeterminant());
+			typedef typename Real<T>::Type Type;
+			const int n = src.Rows();
+			int * perm = new int[n > 0 ? n : 1];
+			Status status;
+			if( std::is_integral<T>::value ){
+				Dynamic<Type> a(n,n);
+				for(size_t i=0;i<src.Size();i++) (&a)[i] = Type((&src)[i]);
+				status = Kernel::Invert(&a, n, n, perm);
+				dst.Resize(n,n);
+				for(size_t i=0;i<a.Size();i++) (&dst)[i] = Kernel::Narrow<T>((&a)[i]);
+			}
+			else {
+				if( &dst != &src ) dst = src;
+				status = Kernel::Invert(&dst, n, n, perm);
+			}
+			delete [] perm;
+			return status;
+		}
+
+		template<typename T>
+		Dynamic<T> Inverse(const Dynamic<T> & master, Status * status =nullptr) {
+			Dynamic<T> inverse;
+			Status result = InverseInto(inverse, master);
+			if( status ) *status = result;
+			if( result != Status::Success ) inverse = Zero<T>(master.Rows(),master.Columns());
+			return inverse;
 		}
 
 		namespace Rotate {
 
-			template<typename T>
-			typename Matrix::Template<T,2,2> Dim2 (T const & angle) {
+			// Sin and Cos fold to constants when the angle is known at compile time, either way they are finished under policy P //
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,2,2> Dim2 (T const & angle) {
+				T s = T(), c = T();
+				SinCos<T,P>(angle, s, c);
 				Matrix::Template<T,2,2> R;
-				R[0][0] = Cos(angle), R[0][1] = -Sin(angle);
-				R[1][0] = Sin(angle), R[1][1] = Cos(angle);
+				R[0][0] = c, R[0][1] = -s;
+				R[1][0] = s, R[1][1] = c;
 				return R;
 			}
 
-			template<typename T>
-			typename Matrix::Template<T,3,3> X(T const & angle){
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,3,3> X(T const & angle){
+				T s = T(), c = T();
+				SinCos<T,P>(angle, s, c);
 				Matrix::Template<T,3,3> R(T(0));
 				R[0][0] = T(1);
-				R[1][1] = Cos(angle), R[1][2] = -Sin(angle);
-				R[2][1] = Sin(angle), R[2][2] = Cos(angle);
+				R[1][1] = c, R[1][2] = -s;
+				R[2][1] = s, R[2][2] = c;
 				return R;
 			}
 
-			template<typename T>
-			typename Matrix::Template<T,3,3> Y(T const & angle){
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,3,3> Y(T const & angle){
+				T s = T(), c = T();
+				SinCos<T,P>(angle, s, c);
 				Matrix::Template<T,3,3> R(T(0));
-				R[0][0] = Cos(angle), R[0][2] = Sin(angle);
+				R[0][0] = c, R[0][2] = s;
 				R[1][1] = T(1);
-				R[2][0] = -Sin(angle), R[2][2] = Cos(angle);
+				R[2][0] = -s, R[2][2] = c;
 				return R;
 			}
 
-			template<typename T>
-			typename Matrix::Template<T,3,3> Z(T const & angle) {
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,3,3> Z(T const & angle) {
+				T s = T(), c = T();
+				SinCos<T,P>(angle, s, c);
 				Matrix::Template<T,3,3> R(T(0));
-				R[0][0] = Cos(angle), R[0][1] = -Sin(angle);
-				R[1][0] = Sin(angle), R[1][1] = Cos(angle);
+				R[0][0] = c, R[0][1] = -s;
+				R[1][0] = s, R[1][1] = c;
 				R[2][2] = T(1);
 				return R;
 			}
 
+			namespace Kernel {
+				// writes the rotation block of R, an N x N matrix with N of 3 or 4, the homogeneous row and column are left to the caller //
+				// Z(yaw)*Y(pitch)*X(roll) multiplied out, s and c hold the sines and cosines of yaw, pitch and roll //
+				template<typename M, typename T>
+				constexpr void Euler(M & R, const T * s, const T * c) {
+					const T spc = s[1]*c[2], sps = s[1]*s[2];
+					R[0][0] = c[0]*c[1], R[0][1] = c[0]*sps - s[0]*c[2], R[0][2] = c[0]*spc + s[0]*s[2];
+					R[1][0] = s[0]*c[1], R[1][1] = s[0]*sps + c[0]*c[2], R[1][2] = s[0]*spc - c[0]*s[2];
+					R[2][0] = -s[1], R[2][1] = c[1]*s[2], R[2][2] = c[1]*c[2];
+				}
+
+				// Rodrigues' formula about the unit axis (x,y,z) //
+				template<typename M, typename T>
+				constexpr void AxisAngle(M & R, T x, T y, T z, T s, T c) {
+					const T t = T(1) - c;
+					const T xy = x*y*t, xz = x*z*t, yz = y*z*t;
+					R[0][0] = c + x*x*t, R[0][1] = xy - z*s, R[0][2] = xz + y*s;
+					R[1][0] = xy + z*s, R[1][1] = c + y*y*t, R[1][2] = yz - x*s;
+					R[2][0] = xz - y*s, R[2][1] = yz + x*s, R[2][2] = c + z*z*t;
+				}
+
+				// the rest of a homogeneous transform around the rotation block, no translation //
+				template<typename T, int N>
+				constexpr void Homogeneous(Matrix::Template<T,N,N> & R) {
+					for(int i=0;i<N;i++)
+						for(int j=3;j<N;j++) R[i][j] = R[j][i] = T(i == j);
+				}
+			}
+
+			// Z(yaw)*Y(pitch)*X(roll) in closed form, one sine and cosine per angle and no matrix products //
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,3,3> Euler(T const & yaw, T const & pitch, T const & roll) {
+				T s[3] = {}, c[3] = {};
+				SinCos<T,P>(yaw, s[0], c[0]);
+				SinCos<T,P>(pitch, s[1], c[1]);
+				SinCos<T,P>(roll, s[2], c[2]);
+				Matrix::Template<T,3,3> R;
+				Kernel::Euler(R, s, c);
+				return R;
+			}
+
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,4,4> EulerDim4(T const & yaw, T const & pitch, T const & roll) {
+				T s[3] = {}, c[3] = {};
+				SinCos<T,P>(yaw, s[0], c[0]);
+				SinCos<T,P>(pitch, s[1], c[1]);
+				SinCos<T,P>(roll, s[2], c[2]);
+				Matrix::Template<T,4,4> R;
+				Kernel::Euler(R, s, c);
+				Kernel::Homogeneous(R);
+				return R;
+			}
+
+			// right handed rotation by angle about axis, which must be unit length //
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,3,3> AxisAngle(const Vector::Template<T,3> & axis, T const & angle) {
+				T s = T(), c = T();
+				SinCos<T,P>(angle, s, c);
+				Matrix::Template<T,3,3> R;
+				Kernel::AxisAngle(R, axis[0], axis[1], axis[2], s, c);
+				return R;
+			}
+
+			template<typename T, typename P =Policy::Default>
+			constexpr Matrix::Template<T,4,4> AxisAngleDim4(const Vector::Template<T,3> & axis, T const & angle) {
+				T s = T(), c = T();
+				SinCos<T,P>(angle, s, c);
+				Matrix::Template<T,4,4> R;
+				Kernel::AxisAngle(R, axis[0], axis[1], axis[2], s, c);
+				Kernel::Homogeneous(R);
+				return R;
+			}
+
+			// angles are converted this many at a time, small enough for the sines and cosines to stay in L1 //
+			const size_t BatchBlock = 256;
+
+			// out[i] = Euler(yaw[i], pitch[i], roll[i]) as 3x3 or homogeneous 4x4 matrices, the sines and cosines come from Batch::SinCos //
+			template<typename T, int N>
+			void Euler(const T * yaw, const T * pitch, const T * roll, Matrix::Template<T,N,N> * out, size_t count, Batch::Accuracy accuracy =Batch::Accuracy::Precise) {
+				static_assert(N == 3 or N == 4, "Rotate::Euler writes 3x3 or 4x4 matrices");
+				Parallel::For(0, count, Vector::Kernel::BatchGrain, [&](size_t first, size_t last) {
+					alignas(64) T s[3][BatchBlock], c[3][BatchBlock];
+					for(size_t base=first;base<last;base+=BatchBlock){
+						const size_t n = last-base < BatchBlock ? last-base : BatchBlock;
+						Batch::SinCos(yaw+base, s[0], c[0], n, accuracy);
+						Batch::SinCos(pitch+base, s[1], c[1], n, accuracy);
+						Batch::SinCos(roll+base, s[2], c[2], n, accuracy);
+						for(size_t i=0;i<n;i++){
+							const T si[3] = {s[0][i], s[1][i], s[2][i]}, ci[3] = {c[0][i], c[1][i], c[2][i]};
+							Matrix::Template<T,N,N> R;
+							Kernel::Euler(R, si, ci);
+							Kernel::Homogeneous(R);
+							out[base+i] = R;
+						}
+					}
+				});
+			}
+
+			// out[i] = AxisAngle(axis[i], angle[i]) as 3x3 or homogeneous 4x4 matrices //
+			template<typename T, int N>
+			void AxisAngle(const Vector::Template<T,3> * axis, const T * angle, Matrix::Template<T,N,N> * out, size_t count, Batch::Accuracy accuracy =Batch::Accuracy::Precise) {
+				static_assert(N == 3 or N == 4, "Rotate::AxisAngle writes 3x3 or 4x4 matrices");
+				Parallel::For(0, count, Vector::Kernel::BatchGrain, [&](size_t first, size_t last) {
+					alignas(64) T s[BatchBlock], c[BatchBlock];
+					for(size_t base=first;base<last;base+=BatchBlock){
+						const size_t n = last-base < BatchBlock ? last-base : BatchBlock;
+						Batch::SinCos(angle+base, s, c, n, accuracy);
+						for(size_t i=0;i<n;i++){
+							const Vector::Template<T,3> & u = axis[base+i];
+							Matrix::Template<T,N,N> R;
+							Kernel::AxisAngle(R, u[0], u[1], u[2], s[i], c[i]);
+							Kernel::Homogeneous(R);
+							out[base+i] = R;
+						}
+					}
+				});
+			}
 		}
 
 #define MatrixDefine(t,T) \
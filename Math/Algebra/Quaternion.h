@@ -0,0 +1,288 @@
+#pragma once
+
+#ifndef MATH_QUATERNION
+#define MATH_QUATERNION
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Matrix.h>
+#include <Math/Algebra/Batch.h>
+
+namespace Math {
+	namespace Quaternion {
+
+		// w + xi + yj + zk, unit quaternions stand for rotations and compose with 16 multiplies against 27 for 3x3 matrices //
+		template<typename T>
+		class Template {
+		public:
+			constexpr Template(T const & w =T(1), T const & x =T(), T const & y =T(), T const & z =T()): e{w,x,y,z} {}
+			constexpr Template(T const & w, const Vector::Template<T,3> & v): e{w,v[0],v[1],v[2]} {}
+
+			constexpr T W() const { return e[0]; }
+			constexpr T X() const { return e[1]; }
+			constexpr T Y() const { return e[2]; }
+			constexpr T Z() const { return e[3]; }
+			constexpr T Real() const { return e[0]; }
+			constexpr Vector::Template<T,3> Imaginary() const { return Vector::Template<T,3>{e[1],e[2],e[3]}; }
+
+			constexpr Template<T> Conjugate() const { return Template<T>(e[0],-e[1],-e[2],-e[3]); }
+			constexpr T Norm() const { return e[0]*e[0] + e[1]*e[1] + e[2]*e[2] + e[3]*e[3]; }
+			T GetLength() const { return std::sqrt(Norm()); }
+
+			Template<T> Normalized() const {
+				const T n = Norm();
+				return n > T(0) ? *this*(T(1)/std::sqrt(n)) : Template<T>();
+			}
+
+			// the conjugate for unit quaternions, zero has no inverse and gives zero //
+			constexpr Template<T> Inverse() const {
+				const T n = Norm();
+				return n > T(0) ? Conjugate()*(T(1)/n) : Template<T>(T(0));
+			}
+
+			// v rotated by this unit quaternion, q*v*q' expanded to two cross products //
+			constexpr Vector::Template<T,3> Rotate(const Vector::Template<T,3> & v) const {
+				const T tx = T(2)*(e[2]*v[2] - e[3]*v[1]), ty = T(2)*(e[3]*v[0] - e[1]*v[2]), tz = T(2)*(e[1]*v[1] - e[2]*v[0]);
+				return Vector::Template<T,3>{
+					v[0] + e[0]*tx + e[2]*tz - e[3]*ty,
+					v[1] + e[0]*ty + e[3]*tx - e[1]*tz,
+					v[2] + e[0]*tz + e[1]*ty - e[2]*tx
+				};
+			}
+
+			std::string ToString() const {
+				return std::to_string(e[0]) + " + " + std::to_string(e[1]) + "i + " + std::to_string(e[2]) + "j + " + std::to_string(e[3]) + "k";
+			}
+
+			constexpr T & operator [] (int i) { return e[i]; }
+			constexpr const T & operator [] (int i) const { return e[i]; }
+
+			constexpr T * operator & () { return e; }
+			constexpr const T * operator & () const { return e; }
+
+			constexpr bool operator == (const Template<T> & q) const {
+				return	e[0] == q.e[0]
+				and	e[1] == q.e[1]
+				and	e[2] == q.e[2]
+				and	e[3] == q.e[3];
+			}
+
+			constexpr bool operator != (const Template<T> & q) const { return !operator==(q); }
+
+			constexpr Template<T> & operator += (const Template<T> & q) {
+				for(int i=0;i<4;i++) e[i] += q.e[i];
+				return *this;
+			}
+
+			constexpr Template<T> & operator -= (const Template<T> & q) {
+				for(int i=0;i<4;i++) e[i] -= q.e[i];
+				return *this;
+			}
+
+			constexpr Template<T> & operator *= (T const & r) {
+				for(int i=0;i<4;i++) e[i] *= r;
+				return *this;
+			}
+
+			// Hamilton product, this*q applies q first and then this //
+			constexpr Template<T> & operator *= (const Template<T> & q) {
+				const T w = e[0], x = e[1], y = e[2], z = e[3];
+				e[0] = w*q.e[0] - x*q.e[1] - y*q.e[2] - z*q.e[3];
+				e[1] = w*q.e[1] + x*q.e[0] + y*q.e[3] - z*q.e[2];
+				e[2] = w*q.e[2] - x*q.e[3] + y*q.e[0] + z*q.e[1];
+				e[3] = w*q.e[3] + x*q.e[2] - y*q.e[1] + z*q.e[0];
+				return *this;
+			}
+
+			constexpr Template<T> operator - () const { return Template<T>(-e[0],-e[1],-e[2],-e[3]); }
+			constexpr Template<T> operator + (const Template<T> & q) const { Template<T> u = *this; return u += q; }
+			constexpr Template<T> operator - (const Template<T> & q) const { Template<T> u = *this; return u -= q; }
+			constexpr Template<T> operator * (const Template<T> & q) const { Template<T> u = *this; return u *= q; }
+			constexpr Template<T> operator * (T const & r) const { Template<T> u = *this; return u *= r; }
+
+		protected:
+			T e[4];
+		};
+
+		template<typename T>
+		constexpr T Dot(const Template<T> & a, const Template<T> & b) { return a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3]; }
+
+		// right handed rotation by angle about axis, which must be unit length //
+		template<typename T, typename P =Policy::Default>
+		constexpr Template<T> AxisAngle(const Vector::Template<T,3> & axis, T const & angle) {
+			T s = T(), c = T();
+			SinCos<T,P>(angle/T(2), s, c);
+			return Template<T>(c, axis[0]*s, axis[1]*s, axis[2]*s);
+		}
+
+		namespace Kernel {
+			// the rotation block of R from the unit quaternion q //
+			template<typename M, typename T>
+			constexpr void Rotation(M & R, const Template<T> & q) {
+				const T w = q[0], x = q[1], y = q[2], z = q[3];
+				const T xx = x*x, yy = y*y, zz = z*z, xy = x*y, xz = x*z, yz = y*z, wx = w*x, wy = w*y, wz = w*z;
+				R[0][0] = T(1) - T(2)*(yy + zz), R[0][1] = T(2)*(xy - wz), R[0][2] = T(2)*(xz + wy);
+				R[1][0] = T(2)*(xy + wz), R[1][1] = T(1) - T(2)*(xx + zz), R[1][2] = T(2)*(yz - wx);
+				R[2][0] = T(2)*(xz - wy), R[2][1] = T(2)*(yz + wx), R[2][2] = T(1) - T(2)*(xx + yy);
+			}
+		}
+
+		template<typename T>
+		constexpr Matrix::Template<T,3,3> ToMatrix(const Template<T> & q) {
+			Matrix::Template<T,3,3> R;
+			Kernel::Rotation(R, q);
+			return R;
+		}
+
+		template<typename T>
+		constexpr Matrix::Template<T,4,4> ToMatrixDim4(const Template<T> & q) {
+			Matrix::Template<T,4,4> R;
+			Kernel::Rotation(R, q);
+			Matrix::Rotate::Kernel::Homogeneous(R);
+			return R;
+		}
+
+		// unit quaternion of the rotation block of R, the largest of w, x, y and z is recovered first so no division goes near zero //
+		template<typename T, int N>
+		Template<T> FromMatrix(const Matrix::Template<T,N,N> & R) {
+			static_assert(N == 3 or N == 4, "FromMatrix reads 3x3 or 4x4 matrices");
+			const T trace = R[0][0] + R[1][1] + R[2][2];
+			if( trace > T(0) ){
+				const T s = T(2)*std::sqrt(trace + T(1));
+				return Template<T>(s/T(4), (R[2][1] - R[1][2])/s, (R[0][2] - R[2][0])/s, (R[1][0] - R[0][1])/s);
+			}
+			if( R[0][0] > R[1][1] and R[0][0] > R[2][2] ){
+				const T s = T(2)*std::sqrt(T(1) + R[0][0] - R[1][1] - R[2][2]);
+				return Template<T>((R[2][1] - R[1][2])/s, s/T(4), (R[0][1] + R[1][0])/s, (R[0][2] + R[2][0])/s);
+			}
+			if( R[1][1] > R[2][2] ){
+				const T s = T(2)*std::sqrt(T(1) + R[1][1] - R[0][0] - R[2][2]);
+				return Template<T>((R[0][2] - R[2][0])/s, (R[0][1] + R[1][0])/s, s/T(4), (R[1][2] + R[2][1])/s);
+			}
+			const T s = T(2)*std::sqrt(T(1) + R[2][2] - R[0][0] - R[1][1]);
+			return Template<T>((R[1][0] - R[0][1])/s, (R[0][2] + R[2][0])/s, (R[1][2] + R[2][1])/s, s/T(4));
+		}
+
+		// normalized linear blend along the shorter arc, cheap and close to Slerp for nearby rotations //
+		template<typename T>
+		Template<T> Nlerp(const Template<T> & a, const Template<T> & b, T const & t) {
+			const T sign = Dot(a,b) < T(0) ? T(-1) : T(1);
+			return (a*(T(1) - t) + b*(sign*t)).Normalized();
+		}
+
+		// constant angular velocity between unit quaternions along the shorter arc //
+		template<typename T>
+		Template<T> Slerp(const Template<T> & a, const Template<T> & b, T const & t) {
+			T d = Dot(a,b);
+			const T sign = d < T(0) ? T(-1) : T(1);
+			d *= sign;
+			// sin(theta) loses its digits as the quaternions meet, the chord is straight enough there //
+			if( d > T(0.9995) ) return Nlerp(a, b, t);
+			const T theta = std::acos(d), s = T(1)/std::sin(theta);
+			return a*(std::sin((T(1) - t)*theta)*s) + b*(sign*std::sin(t*theta)*s);
+		}
+
+		// structure of arrays quaternions, Component(0) to Component(3) hold w, x, y and z //
+		template<typename T>
+		class Batch : public Vector::Batch<T,4> {
+		public:
+			Batch(size_t count =0): Vector::Batch<T,4>(count) {}
+
+			Batch(const Template<T> * q, size_t count): Vector::Batch<T,4>(count) {
+				for(size_t i=0;i<count;i++) Set(i, q[i]);
+			}
+
+			Template<T> operator [] (size_t i) const {
+				return Template<T>(this->Component(0)[i], this->Component(1)[i], this->Component(2)[i], this->Component(3)[i]);
+			}
+
+			void Set(size_t i, const Template<T> & q) {
+				for(int c=0;c<4;c++) this->Component(c)[i] = q[c];
+			}
+		};
+
+		namespace Kernel {
+			// (w,x,y,z) rotating (vx,vy,vz) lane by lane, the same expansion as Template::Rotate //
+			template<typename T, typename P>
+			void Rotate(const P & w, const P & x, const P & y, const P & z, P & vx, P & vy, P & vz) {
+				const P two(T(2));
+				const P tx = two*(y*vz - z*vy), ty = two*(z*vx - x*vz), tz = two*(x*vy - y*vx);
+				vx = vx + w*tx + y*tz - z*ty;
+				vy = vy + w*ty + z*tx - x*tz;
+				vz = vz + w*tz + x*ty - y*tx;
+			}
+		}
+
+		// out[i] = q[i] rotating v[i], out may be v //
+		template<typename T>
+		void Rotate(const Batch<T> & q, const Vector::Batch<T,3> & v, Vector::Batch<T,3> & out) {
+			assert(q.GetCount() == v.GetCount());
+			out.Resize(v.GetCount());
+			const T * w = q.Component(0), * x = q.Component(1), * y = q.Component(2), * z = q.Component(3);
+			const T * ix = v.Component(0), * iy = v.Component(1), * iz = v.Component(2);
+			T * ox = out.Component(0), * oy = out.Component(1), * oz = out.Component(2);
+			Vector::Kernel::Sweep<T>(v.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				P vx = P::Load(ix+i), vy = P::Load(iy+i), vz = P::Load(iz+i);
+				Kernel::Rotate<T>(P::Load(w+i), P::Load(x+i), P::Load(y+i), P::Load(z+i), vx, vy, vz);
+				vx.Store(ox+i), vy.Store(oy+i), vz.Store(oz+i);
+			});
+		}
+
+		// out[i] = q rotating v[i], out may be v //
+		template<typename T>
+		void Rotate(const Template<T> & q, const Vector::Batch<T,3> & v, Vector::Batch<T,3> & out) {
+			out.Resize(v.GetCount());
+			const T qw = q[0], qx = q[1], qy = q[2], qz = q[3];
+			const T * ix = v.Component(0), * iy = v.Component(1), * iz = v.Component(2);
+			T * ox = out.Component(0), * oy = out.Component(1), * oz = out.Component(2);
+			Vector::Kernel::Sweep<T>(v.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				P vx = P::Load(ix+i), vy = P::Load(iy+i), vz = P::Load(iz+i);
+				Kernel::Rotate<T>(P(qw), P(qx), P(qy), P(qz), vx, vy, vz);
+				vx.Store(ox+i), vy.Store(oy+i), vz.Store(oz+i);
+			});
+		}
+
+		// out[i] = a[i]*b[i], out may be a or b //
+		template<typename T>
+		void Compose(const Batch<T> & a, const Batch<T> & b, Batch<T> & out) {
+			assert(a.GetCount() == b.GetCount());
+			out.Resize(a.GetCount());
+			const T * aw = a.Component(0), * ax = a.Component(1), * ay = a.Component(2), * az = a.Component(3);
+			const T * bw = b.Component(0), * bx = b.Component(1), * by = b.Component(2), * bz = b.Component(3);
+			T * ow = out.Component(0), * ox = out.Component(1), * oy = out.Component(2), * oz = out.Component(3);
+			Vector::Kernel::Sweep<T>(a.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				const P w0 = P::Load(aw+i), x0 = P::Load(ax+i), y0 = P::Load(ay+i), z0 = P::Load(az+i);
+				const P w1 = P::Load(bw+i), x1 = P::Load(bx+i), y1 = P::Load(by+i), z1 = P::Load(bz+i);
+				(w0*w1 - x0*x1 - y0*y1 - z0*z1).Store(ow+i);
+				(w0*x1 + x0*w1 + y0*z1 - z0*y1).Store(ox+i);
+				(w0*y1 - x0*z1 + y0*w1 + z0*x1).Store(oy+i);
+				(w0*z1 + x0*y1 - y0*x1 + z0*w1).Store(oz+i);
+			});
+		}
+
+		// rescales every quaternion to unit length, zero quaternions become the identity //
+		template<typename T>
+		void Normalize(Batch<T> & q) {
+			T * w = q.Component(0), * x = q.Component(1), * y = q.Component(2), * z = q.Component(3);
+			Vector::Kernel::Sweep<T>(q.GetCount(), [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				const P qw = P::Load(w+i), qx = P::Load(x+i), qy = P::Load(y+i), qz = P::Load(z+i);
+				const P n = qw*qw + qx*qx + qy*qy + qz*qz;
+				const P zero = Simd::Less(n, P(std::numeric_limits<T>::min()));
+				const P r = P(T(1))/Simd::Sqrt(Simd::Select(zero, P(T(1)), n));
+				Simd::Select(zero, P(T(1)), qw*r).Store(w+i);
+				(qx*r).Store(x+i), (qy*r).Store(y+i), (qz*r).Store(z+i);
+			});
+		}
+
+		typedef Template<float> Float;
+		typedef Template<double> Double;
+		typedef Template<long double> LDouble;
+	}
+}
+
+#endif // ending MATH_QUATERNION //
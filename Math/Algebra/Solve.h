@@ -0,0 +1,364 @@
+#pragma once
+
+#ifndef MATH_SOLVE
+#define MATH_SOLVE
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Parallel.h>
+#include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Matrix.h>
+#include <Math/Algebra/Batch.h>
+#include <Math/Algebra/GEMM.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Math {
+	namespace Matrix {
+
+		namespace Kernel {
+			// in place Cholesky factorization A = L L^T of a row major n x n block, only the lower triangle of A is read //
+			// L ends up in the lower triangle and L^T in the upper one, so both triangular solves read rows and the //
+			// trailing update of each panel is a plain Gemm of L21 by the L21^T just written above the diagonal //
+			// returns false when a pivot is not positive //
+			template<typename T>
+			bool Cholesky(T * a, int n, int stride) {
+				for(int k0=0;k0<n;k0+=SolveBlock){
+					const int k1 = n-k0 < SolveBlock ? n : k0+SolveBlock;
+
+					// L11 and L21 a column at a time, the update from earlier panels is already in //
+					for(int k=k0;k<k1;k++){
+						T * r = a + size_t(k)*stride;
+						T d = r[k];
+						for(int q=k0;q<k;q++) d -= r[q]*r[q];
+						if( !(d > T(0)) ) return false;
+						d = std::sqrt(d);
+						r[k] = d;
+						const T inv = T(1)/d;
+						for(int i=k+1;i<n;i++){
+							T * s = a + size_t(i)*stride;
+							T v = s[k];
+							for(int q=k0;q<k;q++) v -= s[q]*r[q];
+							s[k] = v *= inv;
+							r[i] = v;
+						}
+					}
+
+					// A22 -= L21 L21^T //
+					if( k1 < n ) Gemm(n-k1, n-k1, k1-k0, T(-1), a + size_t(k1)*stride + k0, stride, a + size_t(k0)*stride + k1, stride, T(1), a + size_t(k1)*stride + k1, stride);
+				}
+				return true;
+			}
+
+			template<typename Type, typename T, int rows, int columns>
+			void Copy(Dynamic<Type> & dst, const Template<T,rows,columns> & src) {
+				for(int i=0;i<rows;i++)
+					for(int j=0;j<columns;j++) dst(i,j) = Type(src[i][j]);
+			}
+
+			// columns past which the Householder updates of QR are shared across Parallel workers //
+			const int QRParallelColumns = 256;
+
+			// in place Householder QR of a row major m x n block with m >= n //
+			// R ends up on and above the diagonal, reflector k is (1, a[k+1..m)[k]) with scale tau[k] //
+			// returns the number of columns that are numerically dependent on the ones before them, //
+			// those whose |R_kk| is at most m machine epsilons of the largest |R_jj| before it //
+			template<typename T>
+			int QR(T * a, int m, int n, int stride, T * tau) {
+				const T tolerance = T(m)*std::numeric_limits<T>::epsilon();
+				T largest = T(0);
+				int deficient = 0;
+				for(int k=0;k<n;k++){
+					T norm = T(0);
+					for(int i=k;i<m;i++) norm += a[size_t(i)*stride+k]*a[size_t(i)*stride+k];
+					norm = std::sqrt(norm);
+					T & alpha = a[size_t(k)*stride+k];
+					if( norm <= tolerance*largest or norm == T(0) ) deficient++;
+					largest = Max(largest, norm);
+					if( norm == T(0) ){
+						tau[k] = T(0);
+						continue;
+					}
+
+					// beta takes the sign opposite to alpha so that alpha - beta does not cancel //
+					const T beta = alpha > T(0) ? -norm : norm, scale = T(1)/(alpha - beta);
+					tau[k] = (beta - alpha)/beta;
+					for(int i=k+1;i<m;i++) a[size_t(i)*stride+k] *= scale;
+					alpha = beta;
+
+					// A[k..m)[k+1..n) -= tau v (v^T A), with w = v^T A summed a row at a time in the worker's scratch //
+					auto update = [=](size_t first, size_t last) {
+						const int width = int(last-first);
+						T * w = Scratch<T>::Get(1, size_t(width));
+						std::copy(a + size_t(k)*stride + first, a + size_t(k)*stride + last, w);
+						for(int i=k+1;i<m;i++) Subtract(w, a + size_t(i)*stride + first, -a[size_t(i)*stride+k], width);
+						Subtract(a + size_t(k)*stride + first, w, tau[k], width);
+						for(int i=k+1;i<m;i++) Subtract(a + size_t(i)*stride + first, w, tau[k]*a[size_t(i)*stride+k], width);
+					};
+					if( n-k-1 < 2*QRParallelColumns ) update(size_t(k+1), size_t(n));
+					else Parallel::For(size_t(k+1), size_t(n), QRParallelColumns, update);
+				}
+				return deficient;
+			}
+
+			// B = Q^T B in place for the m x p block B, Q is the product of the reflectors QR left below the diagonal //
+			template<typename T>
+			void ApplyQTransposed(const T * a, int m, int n, int stride, const T * tau, T * b, int p, int ldb) {
+				for(int k=0;k<n;k++){
+					if( tau[k] == T(0) ) continue;
+					ForColumns(p, [=](size_t first, size_t last) {
+						const int width = int(last-first);
+						T * w = Scratch<T>::Get(1, size_t(width));
+						std::copy(b + size_t(k)*ldb + first, b + size_t(k)*ldb + last, w);
+						for(int i=k+1;i<m;i++) Subtract(w, b + size_t(i)*ldb + first, -a[size_t(i)*stride+k], width);
+						Subtract(b + size_t(k)*ldb + first, w, tau[k], width);
+						for(int i=k+1;i<m;i++) Subtract(b + size_t(i)*ldb + first, w, tau[k]*a[size_t(i)*stride+k], width);
+					});
+				}
+			}
+		}
+
+		// factorizations that are computed once and then solve any number of right hand sides //
+		// integral matrices are factored in double, solutions are returned in the factor's Type //
+		// every factor reports IsSingular() or GetStatus() the same way Matrix::LU does //
+		namespace Factor {
+
+			// P A = L U with partial pivoting, for general square systems of any size //
+			// the runtime sized counterpart of Matrix::LU, which factors fixed size systems on the stack //
+			template<typename T>
+			class LU {
+			public:
+				typedef typename Real<T>::Type Type;
+
+				LU(const Dynamic<T> & A): a(A.Rows(),A.Columns()), pivot(size_t(A.Rows())) {
+					assert(A.HasDeterminant());
+					for(size_t i=0;i<A.Size();i++) (&a)[i] = Type((&A)[i]);
+					sign = Size() ? Kernel::Factorize(&a, Size(), Size(), pivot.data()) : 1;
+				}
+
+				int Size() const { return a.Rows(); }
+				int Sign() const { return sign; }
+				int Pivot(int k) const { return pivot[size_t(k)]; }
+				bool IsSingular() const { return sign == 0; }
+				Status GetStatus() const { return sign == 0 ? Status::Singular : Status::Success; }
+
+				Type Determinant() const { return sign == 0 ? Type() : Kernel::Determinant(&a, Size(), Size(), sign); }
+
+				// B = A^-1 B in place, B is Size() x columns with rows stride apart //
+				void SolveInto(Type * b, int columns, int stride) const {
+					assert(!IsSingular());
+					Kernel::SolveFactored(&a, Size(), Size(), pivot.data(), b, columns, stride);
+				}
+
+				Vector::Dynamic<Type> Solve(const Vector::Dynamic<T> & b) const {
+					assert(b.GetSize() == Size());
+					Vector::Dynamic<Type> x(Size());
+					for(int i=0;i<Size();i++) x[i] = Type(b[i]);
+					SolveInto(&x, 1, 1);
+					return x;
+				}
+
+				Dynamic<Type> Solve(const Dynamic<T> & B) const {
+					assert(B.Rows() == Size());
+					Dynamic<Type> X(B.Rows(),B.Columns());
+					for(size_t i=0;i<B.Size();i++) (&X)[i] = Type((&B)[i]);
+					SolveInto(&X, X.Columns(), X.Columns());
+					return X;
+				}
+
+			protected:
+				Dynamic<Type> a;
+				std::vector<int> pivot;
+				int sign;
+			};
+
+			// A = L L^T for symmetric positive definite systems, half the work of LU and no pivoting //
+			// only the lower triangle of A is read, GetStatus() is Singular when A is not positive definite //
+			template<typename T>
+			class Cholesky {
+			public:
+				typedef typename Real<T>::Type Type;
+
+				Cholesky(const Dynamic<T> & A): a(A.Rows(),A.Columns()) {
+					assert(A.HasDeterminant());
+					for(size_t i=0;i<A.Size();i++) (&a)[i] = Type((&A)[i]);
+					Factorize();
+				}
+
+				template<int N>
+				Cholesky(const Template<T,N,N> & A): a(N,N) {
+					Kernel::Copy(a, A);
+					Factorize();
+				}
+
+				int Size() const { return a.Rows(); }
+				bool IsSingular() const { return !positive; }
+				Status GetStatus() const { return positive ? Status::Success : Status::Singular; }
+
+				// the factor L, zero above the diagonal //
+				Dynamic<Type> Lower() const {
+					Dynamic<Type> L(Size(),Size());
+					for(int i=0;i<Size();i++)
+						for(int j=0;j<=i;j++) L(i,j) = a(i,j);
+					return L;
+				}
+
+				Type Determinant() const {
+					if( !positive ) return Type();
+					Type det = Type(1);
+					for(int i=0;i<Size();i++) det *= a(i,i)*a(i,i);
+					return det;
+				}
+
+				void SolveInto(Type * b, int columns, int stride) const {
+					assert(positive);
+					Kernel::SolveLower(Size(), columns, &a, Size(), b, stride, false);
+					Kernel::SolveUpper(Size(), columns, &a, Size(), b, stride, false);
+				}
+
+				Vector::Dynamic<Type> Solve(const Vector::Dynamic<T> & b) const {
+					assert(b.GetSize() == Size());
+					Vector::Dynamic<Type> x(Size());
+					for(int i=0;i<Size();i++) x[i] = Type(b[i]);
+					SolveInto(&x, 1, 1);
+					return x;
+				}
+
+				Dynamic<Type> Solve(const Dynamic<T> & B) const {
+					assert(B.Rows() == Size());
+					Dynamic<Type> X(B.Rows(),B.Columns());
+					for(size_t i=0;i<B.Size();i++) (&X)[i] = Type((&B)[i]);
+					SolveInto(&X, X.Columns(), X.Columns());
+					return X;
+				}
+
+				template<int N>
+				Vector::Template<Type,N> Solve(const Vector::Template<T,N> & b) const {
+					assert(N == Size());
+					Vector::Template<Type,N> x;
+					for(int i=0;i<N;i++) x[i] = Type(b[i]);
+					SolveInto(&x, 1, 1);
+					return x;
+				}
+
+			protected:
+				void Factorize() { positive = Kernel::Cholesky(&a, Size(), Size()); }
+
+				Dynamic<Type> a;
+				bool positive;
+			};
+
+			// A = Q R by Householder reflections for m x n systems with m >= n //
+			// Solve returns the least squares solution, GetStatus() is Singular when A has columns that are dependent //
+			// to working precision, as Kernel::QR counts them //
+			template<typename T>
+			class QR {
+			public:
+				typedef typename Real<T>::Type Type;
+
+				QR(const Dynamic<T> & A): a(A.Rows(),A.Columns()), tau(size_t(A.Columns())) {
+					for(size_t i=0;i<A.Size();i++) (&a)[i] = Type((&A)[i]);
+					Factorize();
+				}
+
+				template<int rows, int columns>
+				QR(const Template<T,rows,columns> & A): a(rows,columns), tau(size_t(columns)) {
+					Kernel::Copy(a, A);
+					Factorize();
+				}
+
+				int Rows() const { return a.Rows(); }
+				int Columns() const { return a.Columns(); }
+				bool IsSingular() const { return singular; }
+				Status GetStatus() const { return singular ? Status::Singular : Status::Success; }
+
+				// the n x n factor R //
+				Dynamic<Type> Upper() const {
+					Dynamic<Type> R(Columns(),Columns());
+					for(int i=0;i<Columns();i++)
+						for(int j=i;j<Columns();j++) R(i,j) = a(i,j);
+					return R;
+				}
+
+				// B = Q^T B in place, B is Rows() x columns //
+				void ApplyQTransposed(Type * b, int columns, int stride) const {
+					Kernel::ApplyQTransposed(&a, Rows(), Columns(), Columns(), tau.data(), b, columns, stride);
+				}
+
+				// the first Columns() rows of the Rows() x columns block B become the least squares solution //
+				void SolveInto(Type * b, int columns, int stride) const {
+					assert(!singular);
+					ApplyQTransposed(b, columns, stride);
+					Kernel::SolveUpper(Columns(), columns, &a, Columns(), b, stride, false);
+				}
+
+				Vector::Dynamic<Type> Solve(const Vector::Dynamic<T> & b) const {
+					assert(b.GetSize() == Rows());
+					Vector::Dynamic<Type> y(Rows());
+					for(int i=0;i<Rows();i++) y[i] = Type(b[i]);
+					SolveInto(&y, 1, 1);
+					Vector::Dynamic<Type> x(Columns());
+					for(int i=0;i<Columns();i++) x[i] = y[i];
+					return x;
+				}
+
+				Dynamic<Type> Solve(const Dynamic<T> & B) const {
+					assert(B.Rows() == Rows());
+					Dynamic<Type> Y(B.Rows(),B.Columns());
+					for(size_t i=0;i<B.Size();i++) (&Y)[i] = Type((&B)[i]);
+					SolveInto(&Y, Y.Columns(), Y.Columns());
+					Dynamic<Type> X(Columns(),B.Columns());
+					for(size_t i=0;i<X.Size();i++) (&X)[i] = (&Y)[i];
+					return X;
+				}
+
+			protected:
+				void Factorize() {
+					assert(Rows() >= Columns());
+					singular = Kernel::QR(&a, Rows(), Columns(), Columns(), tau.data()) > 0;
+				}
+
+				Dynamic<Type> a;
+				std::vector<Type> tau;
+				bool singular;
+			};
+		}
+
+		// x with A x = b by LU, the zero vector and Status::Singular when A is singular //
+		template<typename T>
+		Vector::Dynamic<typename Real<T>::Type> Solve(const Dynamic<T> & A, const Vector::Dynamic<T> & b, Status * status =nullptr) {
+			Factor::LU<T> lu(A);
+			if( status ) *status = lu.GetStatus();
+			return lu.IsSingular() ? Vector::Dynamic<typename Real<T>::Type>(A.Rows()) : lu.Solve(b);
+		}
+
+		// X with A X = B for every column of B at once //
+		template<typename T>
+		Dynamic<typename Real<T>::Type> Solve(const Dynamic<T> & A, const Dynamic<T> & B, Status * status =nullptr) {
+			Factor::LU<T> lu(A);
+			if( status ) *status = lu.GetStatus();
+			return lu.IsSingular() ? Dynamic<typename Real<T>::Type>(B.Rows(),B.Columns()) : lu.Solve(B);
+		}
+
+		// fixed size systems are factored on the stack by Matrix::LU //
+		template<typename T, int N>
+		Vector::Template<typename Real<T>::Type,N> Solve(const Template<T,N,N> & A, const Vector::Template<T,N> & b, Status * status =nullptr) {
+			LU<T,N> lu(A);
+			if( status ) *status = lu.GetStatus();
+			return lu.IsSingular() ? Vector::Template<typename Real<T>::Type,N>() : lu.Solve(b);
+		}
+
+		// x minimizing |A x - b| by Householder QR, A has at least as many rows as columns //
+		template<typename T>
+		Vector::Dynamic<typename Real<T>::Type> LeastSquares(const Dynamic<T> & A, const Vector::Dynamic<T> & b, Status * status =nullptr) {
+			Factor::QR<T> qr(A);
+			if( status ) *status = qr.GetStatus();
+			return qr.IsSingular() ? Vector::Dynamic<typename Real<T>::Type>(A.Columns()) : qr.Solve(b);
+		}
+
+	}
+}
+
+#endif // ending MATH_SOLVE //
@@ -0,0 +1,343 @@
+#pragma once
+
+#ifndef MATH_SPARSE
+#define MATH_SPARSE
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Parallel.h>
+#include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Matrix.h>
+#include <Math/Algebra/Batch.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Math {
+	namespace Matrix {
+
+		// one entry of a matrix under assembly, entries sharing a position are summed //
+		template<typename T>
+		struct Triplet {
+			int row, column;
+			T value;
+		};
+
+		// compressed sparse rows: the entries of row r are Values()[Offsets()[r] .. Offsets()[r+1]) in increasing column order //
+		template<typename T>
+		class Sparse {
+		public:
+			Sparse(int rows =0, int columns =0): rows(rows), columns(columns), offset(size_t(rows)+1, 0) {}
+
+			Sparse(int rows, int columns, const std::vector< Triplet<T> > & triplets): rows(rows), columns(columns), offset(size_t(rows)+1, 0) {
+				for(const auto & t : triplets){
+					assert(t.row >= 0 and t.row < rows and t.column >= 0 and t.column < columns);
+					offset[t.row+1]++;
+				}
+				for(int r=0;r<rows;r++) offset[r+1] += offset[r];
+
+				std::vector< std::pair<int,T> > entry(triplets.size());
+				std::vector<size_t> next(offset.begin(), offset.end()-1);
+				for(const auto & t : triplets) entry[next[t.row]++] = std::make_pair(t.column, t.value);
+
+				index.reserve(entry.size());
+				value.reserve(entry.size());
+				size_t first = 0;
+				for(int r=0;r<rows;r++){
+					const size_t last = offset[r+1];
+					std::sort(entry.begin()+first, entry.begin()+last, [](const std::pair<int,T> & a, const std::pair<int,T> & b) { return a.first < b.first; });
+					offset[r] = index.size();
+					for(size_t k=first;k<last;k++){
+						if( index.size() > offset[r] and index.back() == entry[k].first ) value.back() += entry[k].second;
+						else index.push_back(entry[k].first), value.push_back(entry[k].second);
+					}
+					first = last;
+				}
+				offset[rows] = index.size();
+			}
+
+			// keeps the entries of M that differ from T() //
+			explicit Sparse(const Dynamic<T> & M): rows(M.Rows()), columns(M.Columns()), offset(size_t(rows)+1, 0) {
+				for(int r=0;r<rows;r++){
+					for(int c=0;c<columns;c++)
+						if( M(r,c) != T() ) index.push_back(c), value.push_back(M(r,c));
+					offset[r+1] = index.size();
+				}
+			}
+
+			int Rows() const { return rows; }
+			int Columns() const { return columns; }
+			size_t NonZeros() const { return value.size(); }
+
+			const size_t * Offsets() const { return offset.data(); }
+			const int * Indices() const { return index.data(); }
+			const T * Values() const { return value.data(); }
+
+			// the pattern is fixed, only the stored values may change //
+			T * Values() { return value.data(); }
+
+			// T() where nothing is stored, a binary search over row r //
+			T operator () (int r, int c) const {
+				const int * first = index.data() + offset[r], * last = index.data() + offset[r+1];
+				const int * at = std::lower_bound(first, last, c);
+				return at != last and *at == c ? value[at - index.data()] : T();
+			}
+
+			Dynamic<T> Dense() const {
+				Dynamic<T> M(rows,columns);
+				for(int r=0;r<rows;r++)
+					for(size_t k=offset[r];k<offset[r+1];k++) M(r,index[k]) = value[k];
+				return M;
+			}
+
+			Vector::Dynamic<T> operator * (const Vector::Dynamic<T> & u) const;
+			Dynamic<T> operator * (const Dynamic<T> & M) const;
+
+			Sparse<T> & operator *= (T const & r) {
+				for(auto & v : value) v *= r;
+				return *this;
+			}
+
+			Sparse<T> operator * (T const & r) const {
+				Sparse<T> A = *this;
+				return std::move(A *= r);
+			}
+
+		protected:
+			int rows, columns;
+			std::vector<size_t> offset;
+			std::vector<int> index;
+			std::vector<T> value;
+		};
+
+		namespace Kernel {
+			// body(firstRow, lastRow) over row ranges holding about grain stored entries each, so a few dense rows do not stall one worker //
+			// a range takes every row that starts inside its share of the entries, the last one also takes trailing empty rows //
+			template<typename Body>
+			void ForRows(const size_t * offset, size_t rows, size_t grain, Body body) {
+				const size_t count = offset[rows];
+				if( count <= grain ) return body(size_t(0), rows);
+				Parallel::For(0, count, grain, [&](size_t first, size_t last) {
+					const size_t begin = std::lower_bound(offset, offset+rows, first) - offset;
+					const size_t end = last == count ? rows : std::lower_bound(offset, offset+rows, last) - offset;
+					if( begin < end ) body(begin, end);
+				});
+			}
+
+			// sum of value[k]*x[index[k]] over [first,last), whole registers gather x and the tail runs one entry at a time //
+			template<typename T>
+			T RowDot(const T * value, const int * index, size_t first, size_t last, const T * x) {
+				typedef Simd::Pack<T> Pack;
+				const size_t W = Simd::Width<T>::value;
+				size_t k = first;
+				T sum = T(0);
+				if( W > 1 and last - first >= W ){
+					Pack acc(T(0));
+					for(;k+W<=last;k+=W) acc = Simd::MultiplyAdd(Pack::Load(value+k), Simd::Gather<T,Simd::Width<T>::value>(x, index+k), acc);
+					sum = Simd::Sum(acc);
+				}
+				for(;k<last;k++) sum += value[k]*x[index[k]];
+				return sum;
+			}
+		}
+
+		// y = alpha*A*x + beta*y, x holds A.Columns() values and y A.Rows(), y must not alias x //
+		template<typename T>
+		void Multiply(const Sparse<T> & A, const T * x, T * y, T const & alpha =T(1), T const & beta =T(0)) {
+			const size_t * offset = A.Offsets();
+			const int * index = A.Indices();
+			const T * value = A.Values();
+			Kernel::ForRows(offset, size_t(A.Rows()), Vector::Kernel::BatchGrain, [&](size_t first, size_t last) {
+				for(size_t r=first;r<last;r++){
+					const T sum = alpha*Kernel::RowDot(value, index, offset[r], offset[r+1], x);
+					y[r] = beta == T(0) ? sum : sum + beta*y[r];
+				}
+			});
+		}
+
+		// y = alpha*A*x + beta*y, y is resized when its size does not match //
+		template<typename T>
+		void TransformInto(Vector::Dynamic<T> & y, const Sparse<T> & A, const Vector::Dynamic<T> & x, T const & alpha =T(1), T const & beta =T(0)) {
+			assert(A.Columns() == x.GetSize());
+			if( y.GetSize() != A.Rows() ) y.Resize(A.Rows());
+			Multiply(A, &x, &y, alpha, beta);
+		}
+
+		// C = alpha*A*B + beta*C for sparse A and dense B, every stored entry adds a scaled row of B to a row of C //
+		template<typename T>
+		void TransformInto(Dynamic<T> & C, const Sparse<T> & A, const Dynamic<T> & B, T const & alpha =T(1), T const & beta =T(0)) {
+			assert(A.Columns() == B.Rows());
+			if( C.Rows() != A.Rows() or C.Columns() != B.Columns() ) C.Resize(A.Rows(),B.Columns());
+			const size_t * offset = A.Offsets();
+			const int * index = A.Indices();
+			const T * value = A.Values();
+			const size_t n = size_t(B.Columns());
+			Kernel::ForRows(offset, size_t(A.Rows()), Vector::Kernel::BatchGrain/(n ? n : 1) + 1, [&](size_t first, size_t last) {
+				for(size_t r=first;r<last;r++){
+					T * c = C[int(r)];
+					if( beta == T(0) ) for(size_t j=0;j<n;j++) c[j] = T(0);
+					else if( beta != T(1) ) for(size_t j=0;j<n;j++) c[j] *= beta;
+					for(size_t k=offset[r];k<offset[r+1];k++){
+						const T a = alpha*value[k];
+						const T * b = B[index[k]];
+						Vector::Kernel::Sweep<T>(0, n, [&](size_t j, auto p) {
+							typedef decltype(p) Pack;
+							Simd::MultiplyAdd(Pack(a), Pack::Load(b+j), Pack::Load(c+j)).Store(c+j);
+						});
+					}
+				}
+			});
+		}
+
+		// C = alpha*A*B + beta*C for dense A and sparse B, each row of A scatters into its row of C //
+		template<typename T>
+		void TransformInto(Dynamic<T> & C, const Dynamic<T> & A, const Sparse<T> & B, T const & alpha =T(1), T const & beta =T(0)) {
+			assert(A.Columns() == B.Rows());
+			if( C.Rows() != A.Rows() or C.Columns() != B.Columns() ) C.Resize(A.Rows(),B.Columns());
+			const size_t * offset = B.Offsets();
+			const int * index = B.Indices();
+			const T * value = B.Values();
+			const size_t n = size_t(B.Columns()), work = B.NonZeros() + size_t(A.Columns());
+			Parallel::For(0, size_t(A.Rows()), Vector::Kernel::BatchGrain/(work ? work : 1) + 1, [&](size_t first, size_t last) {
+				for(size_t r=first;r<last;r++){
+					const T * a = A[int(r)];
+					T * c = C[int(r)];
+					if( beta == T(0) ) for(size_t j=0;j<n;j++) c[j] = T(0);
+					else if( beta != T(1) ) for(size_t j=0;j<n;j++) c[j] *= beta;
+					for(int i=0;i<A.Columns();i++){
+						if( a[i] == T(0) ) continue;
+						const T s = alpha*a[i];
+						for(size_t k=offset[i];k<offset[i+1];k++) c[index[k]] += s*value[k];
+					}
+				}
+			});
+		}
+
+		template<typename T>
+		Vector::Dynamic<T> Sparse<T>::operator * (const Vector::Dynamic<T> & u) const {
+			Vector::Dynamic<T> v(rows);
+			TransformInto(v, *this, u);
+			return v;
+		}
+
+		template<typename T>
+		Dynamic<T> Sparse<T>::operator * (const Dynamic<T> & M) const {
+			Dynamic<T> C(rows, M.Columns());
+			TransformInto(C, *this, M);
+			return C;
+		}
+
+		template<typename T>
+		Dynamic<T> Transform(const Sparse<T> & A, const Dynamic<T> & B) { return A*B; }
+
+		template<typename T>
+		Dynamic<T> Transform(const Dynamic<T> & A, const Sparse<T> & B) {
+			Dynamic<T> C(A.Rows(),B.Columns());
+			TransformInto(C,A,B);
+			return C;
+		}
+
+		// the triplet constructor buckets the entries by column of A, so each row arrives already ordered //
+		template<typename T>
+		Sparse<T> Transpose(const Sparse<T> & A) {
+			std::vector< Triplet<T> > triplets;
+			triplets.reserve(A.NonZeros());
+			const size_t * offset = A.Offsets();
+			for(int r=0;r<A.Rows();r++)
+				for(size_t k=offset[r];k<offset[r+1];k++) triplets.push_back(Triplet<T>{A.Indices()[k], r, A.Values()[k]});
+			return Sparse<T>(A.Columns(), A.Rows(), triplets);
+		}
+
+		// blocked compressed sparse rows: B by B dense blocks stored column major, for matrices whose entries cluster //
+		// such as several unknowns per mesh node, a block column product is B multiply adds of whole registers //
+		template<typename T, int B>
+		class Blocked {
+		public:
+			Blocked(): rows(0), columns(0), offset(1, 0) {}
+
+			explicit Blocked(const Sparse<T> & A): rows(A.Rows()), columns(A.Columns()), offset(size_t(BlockRows())+1, 0) {
+				const size_t * rowOffset = A.Offsets();
+				const int * rowIndex = A.Indices();
+				std::vector<int> slot(size_t(BlockColumns()), -1);
+				for(int br=0;br<BlockRows();br++){
+					const size_t first = index.size();
+					const int rlast = std::min(rows, (br+1)*B);
+					for(int r=br*B;r<rlast;r++)
+						for(size_t k=rowOffset[r];k<rowOffset[r+1];k++)
+							if( slot[rowIndex[k]/B] < 0 ) slot[rowIndex[k]/B] = 0, index.push_back(rowIndex[k]/B);
+					std::sort(index.begin()+first, index.end());
+					for(size_t k=first;k<index.size();k++) slot[index[k]] = int(k);
+
+					value.resize(index.size()*B*B, T(0));
+					for(int r=br*B;r<rlast;r++)
+						for(size_t k=rowOffset[r];k<rowOffset[r+1];k++)
+							value[size_t(slot[rowIndex[k]/B])*B*B + (rowIndex[k]%B)*B + r%B] += A.Values()[k];
+					for(size_t k=first;k<index.size();k++) slot[index[k]] = -1;
+					offset[br+1] = index.size();
+				}
+			}
+
+			int Rows() const { return rows; }
+			int Columns() const { return columns; }
+			int BlockRows() const { return (rows + B - 1)/B; }
+			int BlockColumns() const { return (columns + B - 1)/B; }
+			size_t Blocks() const { return index.size(); }
+
+			const size_t * Offsets() const { return offset.data(); }
+			const int * Indices() const { return index.data(); }
+			const T * Values() const { return value.data(); }
+
+		protected:
+			int rows, columns;
+			std::vector<size_t> offset;
+			std::vector<int> index;
+			std::vector<T> value;
+		};
+
+		// y = alpha*A*x + beta*y, y must not alias x //
+		template<typename T, int B>
+		void Multiply(const Blocked<T,B> & A, const T * x, T * y, T const & alpha =T(1), T const & beta =T(0)) {
+			typedef Simd::Pack<T,B> Pack;
+			const size_t * offset = A.Offsets();
+			const int * index = A.Indices();
+			const T * value = A.Values();
+
+			// the last block column reads past the end of x unless the columns fill whole blocks //
+			std::vector<T> padded;
+			if( A.Columns() % B ){
+				padded.assign(size_t(A.BlockColumns())*B, T(0));
+				std::copy(x, x + A.Columns(), padded.begin());
+				x = padded.data();
+			}
+
+			Kernel::ForRows(offset, size_t(A.BlockRows()), Vector::Kernel::BatchGrain/(B*B), [&](size_t first, size_t last) {
+				for(size_t br=first;br<last;br++){
+					Pack acc(T(0));
+					for(size_t k=offset[br];k<offset[br+1];k++){
+						const T * block = value + k*B*B, * xs = x + size_t(index[k])*B;
+						for(int j=0;j<B;j++) acc = Simd::MultiplyAdd(Pack::Load(block + j*B), Pack(xs[j]), acc);
+					}
+					const int count = std::min(B, A.Rows() - int(br)*B);
+					T * ys = y + br*B, tile[B];
+					if( count == B ){
+						(beta == T(0) ? Pack(alpha)*acc : Simd::MultiplyAdd(Pack(alpha), acc, Pack(beta)*Pack::Load(ys))).Store(ys);
+						continue;
+					}
+					acc.Store(tile);
+					for(int i=0;i<count;i++) ys[i] = beta == T(0) ? alpha*tile[i] : alpha*tile[i] + beta*ys[i];
+				}
+			});
+		}
+
+		template<typename T, int B>
+		void TransformInto(Vector::Dynamic<T> & y, const Blocked<T,B> & A, const Vector::Dynamic<T> & x, T const & alpha =T(1), T const & beta =T(0)) {
+			assert(A.Columns() == x.GetSize());
+			if( y.GetSize() != A.Rows() ) y.Resize(A.Rows());
+			Multiply(A, &x, &y, alpha, beta);
+		}
+
+	}
+}
+
+#endif // ending MATH_SPARSE //
@@ -4,6 +4,8 @@
 #define MATH_VECTOR
 
 #include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Algebra/Expression.h>
 
 BEGIN_C
 # include <assert.h>
@@ -13,101 +15,171 @@ namespace Math {
 
 	namespace Vector {
 
+		// lanes actually stored, 3 component float and double vectors carry one zero lane so they fill whole registers //
+		template<typename T, int size>
+		struct Storage { enum { lanes = size, alignment = alignof(T) }; };
+
+		template<> struct Storage<float,3> { enum { lanes = 4, alignment = 16 }; };
+		template<> struct Storage<float,4> { enum { lanes = 4, alignment = 16 }; };
+		template<> struct Storage<double,2> { enum { lanes = 2, alignment = 16 }; };
+		template<> struct Storage<double,3> { enum { lanes = 4, alignment = 16 }; };
+		template<> struct Storage<double,4> { enum { lanes = 4, alignment = 16 }; };
+
+		template<typename T, int size>
+		class Template;
+
+		// anything that can stand in an element wise expression, node is set for the lazy intermediate results //
+		template<typename X>
+		struct Operand { enum { value = false, node = false, length = 0 }; };
+
+		template<typename T, int size>
+		struct Operand< Template<T,size> > {
+			enum { value = size > 0, node = false, length = size };
+			typedef T Type;
+		};
+
+		// element wise kernels over the stored lanes, whole Simd::Pack registers where Storage pads to them //
+		// the scalar kernels are constexpr and also stand in for the SIMD ones while the compiler evaluates constants //
+		template<typename T, int size, bool simd =(Storage<T,size>::alignment >= 16)>
+		struct Lanes {
+			static constexpr void Add(T * e, const T * u) { for(int i=0;i<size;i++) e[i] += u[i]; }
+			static constexpr void Subtract(T * e, const T * u) { for(int i=0;i<size;i++) e[i] -= u[i]; }
+			static constexpr void Scale(T * e, T r) { for(int i=0;i<size;i++) e[i] *= r; }
+			static constexpr void Divide(T * e, T r) { for(int i=0;i<size;i++) e[i] /= r; }
+			static constexpr T Dot(const T * e, const T * u) {
+				T sum = T(0);
+				for(int i=0;i<size;i++) sum += u[i]*e[i];
+				return sum;
+			}
+
+			template<typename X>
+			static constexpr void Assign(T * e, const X & x) { for(int i=0;i<size;i++) e[i] = x[i]; }
+
+			template<typename X, typename Y>
+			static constexpr T Product(const X & x, const Y & y) {
+				T sum = T(0);
+				for(int i=0;i<size;i++) sum += x[i]*y[i];
+				return sum;
+			}
+		};
+
+		template<typename T, int size>
+		struct Lanes<T,size,true> {
+			enum {
+				count = Storage<T,size>::lanes,
+				width = count*sizeof(T) <= MATH_SIMD_BYTES ? int(count) : int(Simd::Width<T>::value)
+			};
+			typedef Simd::Pack<T,width> Pack;
+
+			static void Add(T * e, const T * u) { for(int i=0;i<count;i+=width) (Pack::Load(e+i) + Pack::Load(u+i)).Store(e+i); }
+			static void Subtract(T * e, const T * u) { for(int i=0;i<count;i+=width) (Pack::Load(e+i) - Pack::Load(u+i)).Store(e+i); }
+			static void Scale(T * e, T r) { for(int i=0;i<count;i+=width) (Pack::Load(e+i) * Pack(r)).Store(e+i); }
+			static void Divide(T * e, T r) { for(int i=0;i<count;i+=width) (Pack::Load(e+i) / Pack(r)).Store(e+i); }
+			static T Dot(const T * e, const T * u) {
+				Pack sum = Pack::Load(e)*Pack::Load(u);
+				for(int i=width;i<count;i+=width) sum = Simd::MultiplyAdd(Pack::Load(e+i), Pack::Load(u+i), sum);
+				return Simd::Sum(sum);
+			}
+
+			// padding lanes of every leaf are zero, so they stay zero through +, - and scaling //
+			template<typename X>
+			static void Assign(T * e, const X & x) { for(int i=0;i<count;i+=width) x.template Load<Pack>(i).Store(e+i); }
+
+			template<typename X, typename Y>
+			static T Product(const X & x, const Y & y) {
+				Pack sum = x.template Load<Pack>(0)*y.template Load<Pack>(0);
+				for(int i=width;i<count;i+=width) sum = Simd::MultiplyAdd(x.template Load<Pack>(i), y.template Load<Pack>(i), sum);
+				return Simd::Sum(sum);
+			}
+		};
+
 		template<typename T, int size>
 		class Template {
+			typedef Lanes<T,size,false> Scalar;
 		public:
-			Template() {
-				for(int i=0;i<size;i++)
-					e[i] = T(0);
-			}
+			constexpr Template(): e() {}
+			constexpr Template(const Template<T,size> &) = default;
 
-			Template(const std::initializer_list<T> & list) {
+			constexpr Template(const std::initializer_list<T> & list): e() {
 				int i=0;
 				if(size > 0){
 					for(const auto & item : list)
-						e[i++] = item;
+						if( i < size ) e[i++] = item;
 				}
 			}
 
-			~Template() {}
+			// evaluates a lazy expression in a single pass //
+			template<typename X, typename =typename std::enable_if<Operand<X>::node>::type>
+			constexpr Template(const X & x): e() { operator=(x); }
 
-			int GetSize() const { return size; }
-			double GetLength() const {
-				double sum = 0.0;
-				for(int i=0;i<size;i++) sum += e[i]*e[i];
+			constexpr int GetSize() const { return size; }
+			typename Real<T>::Type GetLength() const {
+				typedef typename Real<T>::Type Type;
+				if( std::is_same<T,Type>::value ) return std::sqrt( Type(operator*(*this)) );
+				Type sum = Type(0);
+				for(int i=0;i<size;i++) sum += Type(e[i])*Type(e[i]);
 				return std::sqrt(sum);
 			}
 
-			double GetAngle(const Template<T,size> & u) const {
-				double l = GetLength();
-				double ul = u.GetLength();
-				if( IsZero(l) or IsZero(ul) ) return 0.0;
-				return acos(operator*(u)/(ul*l));
+			typename Real<T>::Type GetAngle(const Template<T,size> & u) const {
+				typedef typename Real<T>::Type Type;
+				Type l = GetLength();
+				Type ul = u.GetLength();
+				if( l == Type(0) or ul == Type(0) ) return Type(0);
+				return std::acos(Max(Min(Type(operator*(u))/(ul*l), Type(1)), Type(-1)));
 			}
 
-			T & operator [] (int i) { return e[i]; }
-			const T & operator [] (int i) const { return e[i]; }
+			constexpr T & operator [] (int i) { return e[i]; }
+			constexpr const T & operator [] (int i) const { return e[i]; }
 
-			bool operator == (const Template<T,size> & u) const {
+			constexpr bool operator == (const Template<T,size> & u) const {
 				for(int i=0;i<size;i++)
 					if( e[i] != u[i] ) return false;
 				return true;
 			}
 
-			bool operator != (const Template<T,size> & u) const { return !operator==(u); }
-			typename Template<T,size> & operator = (const Template<T,size> & u){
-				for(int i=0;i<size;i++) e[i] = u[i];
+			constexpr bool operator != (const Template<T,size> & u) const { return !operator==(u); }
+			constexpr Template<T,size> & operator = (const Template<T,size> & u){
+				for(int i=0;i<Storage<T,size>::lanes;i++) e[i] = u.e[i];
 				return *this;
 			}
 
-			typename Template<T,size> & operator += (const Template<T,size> & u) {
-				for(int i=0;i<size;i++) e[i] += u[i];
+			// element i of an expression only reads element i of its operands, so x may refer to this vector //
+			template<typename X, typename =typename std::enable_if<Operand<X>::node>::type>
+			constexpr Template<T,size> & operator = (const X & x) {
+				if( MATH_CONSTANT_EVALUATED() ) Scalar::Assign(e,x);
+				else Lanes<T,size>::Assign(e,x);
 				return *this;
 			}
 
-			typename Template<T,size> & operator -= (const Template<T,size> & u) {
-				for(int i=0;i<size;i++) e[i] = u[i];
+			constexpr Template<T,size> & operator += (const Template<T,size> & u) {
+				if( MATH_CONSTANT_EVALUATED() ) Scalar::Add(e,u.e);
+				else Lanes<T,size>::Add(e,u.e);
 				return *this;
 			}
 
-			typename Template<T,size> & operator *= (T r){
-				for(int i=0;i<size;i++) e[i] *= r;
+			constexpr Template<T,size> & operator -= (const Template<T,size> & u) {
+				if( MATH_CONSTANT_EVALUATED() ) Scalar::Subtract(e,u.e);
+				else Lanes<T,size>::Subtract(e,u.e);
 				return *this;
 			}
 
-			typename Template<T,size> & operator /= (T r) {
-				for(int i=0;i<size;i++) e[i] /= r;
+			constexpr Template<T,size> & operator *= (T r){
+				if( MATH_CONSTANT_EVALUATED() ) Scalar::Scale(e,r);
+				else Lanes<T,size>::Scale(e,r);
 				return *this;
 			}
 
-			T operator * (const Template<T,size> & u) const {
-				T sum = T(0);
-				for(int i=0;i<size;i++) sum += u[i]*e[i];
-				return sum;
-			}
-
-			typename Template<T,size> operator + (const Template<T,size> & u) const {
-				Template<T,size> v = *this;
-				return v += u;
-			}
-
-			typename Template<T,size> operator - (const Template<T,size> & u) const {
-				Template<T,size> v = *this;
-				return v -= u;
-			}
-
-			typename Template<T,size> operator * (T r) const {
-				Template<T,size> v = *this;
-				return v *= r;
+			constexpr Template<T,size> & operator /= (T r) {
+				if( MATH_CONSTANT_EVALUATED() ) Scalar::Divide(e,r);
+				else Lanes<T,size>::Divide(e,r);
+				return *this;
 			}
 
-			typename Template<T,size> operator / (T r) const {
-				Template<T,size> v = *this;
-				return v /= r;
-			}
+			constexpr T operator * (const Template<T,size> & u) const { return MATH_CONSTANT_EVALUATED() ? Scalar::Dot(e,u.e) : Lanes<T,size>::Dot(e,u.e); }
 
-			T * operator & () { return e; }
-			const T * operator & () const { return e; }
+			constexpr T * operator & () { return e; }
+			constexpr const T * operator & () const { return e; }
 
 			std::string ToString() const {
 				std::string string = "<";
@@ -116,19 +188,25 @@ namespace Math {
 				return string.substr(0,string.length()-2) + ">";
 			}
 
-			bool IsZero() const {
+			template<typename P =Policy::Default>
+			constexpr bool IsZero() const {
 				for(int i=0; i<size; i++)
-					if( !Equals<T>(e,T()) ) return false;
+					if( !Equals<T,P>(e[i],T()) ) return false;
 				return true;
 			}
 
+			template<typename P>
+			P Load(int i) const { return P::Load(e+i); }
+
 		protected:
-			T e[size];
+			alignas(Storage<T,size>::alignment) T e[Storage<T,size>::lanes];
 		};
 
 		template<typename T>
 		class Template<T,0> {
 		public:
+			Template() {}
+			Template(const Template<T,0> &) = default;
 			bool IsZero() const { return true; }
 			std::string ToString() const { return "<>"; }
 			T operator [] (int i) const {return T();}
@@ -147,6 +225,97 @@ namespace Math {
 			T e[0];
 		};
 
+		// A + B*r - C builds a tree of these nodes, nothing is computed until it is assigned to a Template //
+		// leaves are held by reference, so keep a node only as long as the vectors it was built from //
+		template<typename X, typename T, int size>
+		class Node {
+		public:
+			constexpr int GetSize() const { return size; }
+			constexpr Template<T,size> Evaluate() const { return Template<T,size>(static_cast<const X &>(*this)); }
+			typename Real<T>::Type GetLength() const { return Evaluate().GetLength(); }
+			typename Real<T>::Type GetAngle(const Template<T,size> & u) const { return Evaluate().GetAngle(u); }
+			std::string ToString() const { return Evaluate().ToString(); }
+			template<typename P =Policy::Default>
+			constexpr bool IsZero() const { return Evaluate().template IsZero<P>(); }
+		};
+
+		// l[i] op r[i] //
+		template<typename T, int size, typename Op, typename L, typename R>
+		class Binary : public Node<Binary<T,size,Op,L,R>,T,size> {
+		public:
+			constexpr Binary(L const & l, R const & r): l(l), r(r) {}
+			constexpr T operator [] (int i) const { return Op::template Apply<T>(l[i], r[i]); }
+
+			template<typename P>
+			P Load(int i) const { return Op::Apply(l.template Load<P>(i), r.template Load<P>(i)); }
+
+		protected:
+			typename Expression::Hold<L,Operand<L>::node>::Type l;
+			typename Expression::Hold<R,Operand<R>::node>::Type r;
+		};
+
+		// l[i] op r for a scalar r //
+		template<typename T, int size, typename Op, typename L>
+		class Scaled : public Node<Scaled<T,size,Op,L>,T,size> {
+		public:
+			constexpr Scaled(L const & l, T const & r): l(l), r(r) {}
+			constexpr T operator [] (int i) const { return Op::template Apply<T>(l[i], r); }
+
+			template<typename P>
+			P Load(int i) const { return Op::Apply(l.template Load<P>(i), P(r)); }
+
+		protected:
+			typename Expression::Hold<L,Operand<L>::node>::Type l;
+			T r;
+		};
+
+		template<typename T, int size, typename Op, typename L, typename R>
+		struct Operand< Binary<T,size,Op,L,R> > {
+			enum { value = true, node = true, length = size };
+			typedef T Type;
+		};
+
+		template<typename T, int size, typename Op, typename L>
+		struct Operand< Scaled<T,size,Op,L> > {
+			enum { value = true, node = true, length = size };
+			typedef T Type;
+		};
+
+		// element wise operators over any pair of vectors or nodes of the same type and size //
+		template<typename L, typename R>
+		struct Pair {
+			enum { value = Operand<L>::value and Operand<R>::value and int(Operand<L>::length) == int(Operand<R>::length) };
+		};
+
+#define MATH_VECTOR_BINARY(OP,OPERATION) \
+		template<typename L, typename R, typename =typename std::enable_if<Pair<L,R>::value>::type> \
+		constexpr Binary<typename Operand<L>::Type,Operand<L>::length,Expression::OPERATION,L,R> operator OP (const L & l, const R & r) { \
+			static_assert(std::is_same<typename Operand<L>::Type,typename Operand<R>::Type>::value, "Vector expressions need a common element type"); \
+			return Binary<typename Operand<L>::Type,Operand<L>::length,Expression::OPERATION,L,R>(l,r); \
+		}
+
+#define MATH_VECTOR_SCALED(OP,OPERATION) \
+		template<typename L, typename =typename std::enable_if<Operand<L>::value>::type> \
+		constexpr Scaled<typename Operand<L>::Type,Operand<L>::length,Expression::OPERATION,L> operator OP (const L & l, typename Operand<L>::Type const & r) { \
+			return Scaled<typename Operand<L>::Type,Operand<L>::length,Expression::OPERATION,L>(l,r); \
+		}
+
+		MATH_VECTOR_BINARY(+,Add)
+		MATH_VECTOR_BINARY(-,Subtract)
+		MATH_VECTOR_SCALED(*,Multiply)
+		MATH_VECTOR_SCALED(/,Divide)
+
+#undef MATH_VECTOR_BINARY
+#undef MATH_VECTOR_SCALED
+
+		// dot product of expressions in one fused pass, Template * Template goes through the member operator //
+		template<typename L, typename R, typename =typename std::enable_if<Pair<L,R>::value and (Operand<L>::node or Operand<R>::node)>::type>
+		constexpr typename Operand<L>::Type operator * (const L & l, const R & r) {
+			typedef typename Operand<L>::Type T;
+			if( MATH_CONSTANT_EVALUATED() ) return Lanes<T,Operand<L>::length,false>::Product(l,r);
+			return Lanes<T,Operand<L>::length>::Product(l,r);
+		}
+
 		typedef Template<float,2> Dim2f;
 		typedef Template<float,3> Dim3f;
 		typedef Template<float,4> Dim4f;
@@ -189,7 +358,7 @@ namespace Math {
 
 
 		template<typename T>
-		typename Template<T,3> Cross(const Template<T,3> & A, const Template<T,3> & B) {
+		constexpr Template<T,3> Cross(const Template<T,3> & A, const Template<T,3> & B) {
 			Template<T,3> C;
 
 			C[0] =  (A[1]*B[2] - A[2]*B[1]);
@@ -198,11 +367,185 @@ namespace Math {
 			return C;
 		}
 
-		template<typename T, int size>
-		bool IsOrtho(const Template<T,size> & u, const Template<T,size> & v) {return Equals( u*v, T() );}
+#ifdef MATH_SIMD_SSE
+		namespace Kernel {
+			inline Template<float,3> Cross(const Template<float,3> & A, const Template<float,3> & B) {
+				const __m128 a = _mm_loadu_ps(&A), b = _mm_loadu_ps(&B);
+				const __m128 ayzx = _mm_shuffle_ps(a,a,_MM_SHUFFLE(3,0,2,1)), bzxy = _mm_shuffle_ps(b,b,_MM_SHUFFLE(3,1,0,2));
+				const __m128 azxy = _mm_shuffle_ps(a,a,_MM_SHUFFLE(3,1,0,2)), byzx = _mm_shuffle_ps(b,b,_MM_SHUFFLE(3,0,2,1));
+				Template<float,3> C;
+				_mm_storeu_ps(&C, _mm_sub_ps(_mm_mul_ps(ayzx,bzxy), _mm_mul_ps(azxy,byzx)));
+				return C;
+			}
+		}
+
+#ifdef MATH_NO_CONSTANT_EVALUATED
+		// with no way to tell constant evaluation apart this overload could never be constexpr //
+		inline Template<float,3> Cross(const Template<float,3> & A, const Template<float,3> & B) { return Kernel::Cross(A,B); }
+#else
+		constexpr Template<float,3> Cross(const Template<float,3> & A, const Template<float,3> & B) {
+			return MATH_CONSTANT_EVALUATED() ? Cross<float>(A,B) : Kernel::Cross(A,B);
+		}
+#endif
+#endif
+
+		template<typename P =Policy::Default, typename T, int size>
+		constexpr bool IsOrtho(const Template<T,size> & u, const Template<T,size> & v) {return Equals<T,P>( u*v, T() );}
 
 		template<typename T, int size>
-		T Dot(const Template<T,size> & u, const Template<T,size> & v) { return u*v; }
+		constexpr T Dot(const Template<T,size> & u, const Template<T,size> & v) { return u*v; }
+
+		// runtime sized vector over one 64 byte aligned heap block //
+		template<typename T>
+		class Dynamic {
+		public:
+			Dynamic(int size =0, T const & x =T()): e(AlignedAlloc<T>(size)), size(size) {
+				for(int i=0;i<size;i++) e[i] = x;
+			}
+
+			Dynamic(const std::initializer_list<T> & list): e(AlignedAlloc<T>(list.size())), size(int(list.size())) {
+				int i=0;
+				for(const auto & item : list) e[i++] = item;
+			}
+
+			template<int n>
+			Dynamic(const Template<T,n> & u): e(AlignedAlloc<T>(n)), size(n) {
+				for(int i=0;i<n;i++) e[i] = u[i];
+			}
+
+			Dynamic(const Dynamic<T> & u): e(AlignedAlloc<T>(u.size)), size(u.size) {
+				for(int i=0;i<size;i++) e[i] = u.e[i];
+			}
+
+			Dynamic(Dynamic<T> && u) noexcept : e(u.e), size(u.size) {
+				u.e = nullptr;
+				u.size = 0;
+			}
+
+			~Dynamic() { AlignedFree(e); }
+
+			int GetSize() const { return size; }
+
+			// contents are discarded when the size changes //
+			void Resize(int n) {
+				if( n == size ) return;
+				AlignedFree(e);
+				e = AlignedAlloc<T>(n);
+				size = n;
+				for(int i=0;i<size;i++) e[i] = T();
+			}
+
+			typename Real<T>::Type GetLength() const {
+				typename Real<T>::Type sum = 0;
+				for(int i=0;i<size;i++) sum += e[i]*e[i];
+				return std::sqrt(sum);
+			}
+
+			typename Real<T>::Type GetAngle(const Dynamic<T> & u) const {
+				typename Real<T>::Type l = GetLength(), ul = u.GetLength();
+				if( l == 0 or ul == 0 ) return 0;
+				return std::acos(operator*(u)/(ul*l));
+			}
+
+			T & operator [] (int i) { return e[i]; }
+			const T & operator [] (int i) const { return e[i]; }
+
+			T * operator & () { return e; }
+			const T * operator & () const { return e; }
+
+			bool operator == (const Dynamic<T> & u) const {
+				if( size != u.size ) return false;
+				for(int i=0;i<size;i++)
+					if( e[i] != u.e[i] ) return false;
+				return true;
+			}
+
+			bool operator != (const Dynamic<T> & u) const { return !operator==(u); }
+
+			Dynamic<T> & operator = (const Dynamic<T> & u) {
+				if( this == std::addressof(u) ) return *this;
+				Resize(u.size);
+				for(int i=0;i<size;i++) e[i] = u.e[i];
+				return *this;
+			}
+
+			Dynamic<T> & operator = (Dynamic<T> && u) noexcept {
+				std::swap(e,u.e);
+				std::swap(size,u.size);
+				return *this;
+			}
+
+			Dynamic<T> & operator += (const Dynamic<T> & u) {
+				assert(size == u.size);
+				for(int i=0;i<size;i++) e[i] += u.e[i];
+				return *this;
+			}
+
+			Dynamic<T> & operator -= (const Dynamic<T> & u) {
+				assert(size == u.size);
+				for(int i=0;i<size;i++) e[i] -= u.e[i];
+				return *this;
+			}
+
+			Dynamic<T> & operator *= (T r) {
+				for(int i=0;i<size;i++) e[i] *= r;
+				return *this;
+			}
+
+			Dynamic<T> & operator /= (T r) {
+				for(int i=0;i<size;i++) e[i] /= r;
+				return *this;
+			}
+
+			T operator * (const Dynamic<T> & u) const {
+				assert(size == u.size);
+				T sum = T(0);
+				for(int i=0;i<size;i++) sum += u.e[i]*e[i];
+				return sum;
+			}
+
+			Dynamic<T> operator + (const Dynamic<T> & u) const {
+				Dynamic<T> v = *this;
+				return std::move(v += u);
+			}
+
+			Dynamic<T> operator - (const Dynamic<T> & u) const {
+				Dynamic<T> v = *this;
+				return std::move(v -= u);
+			}
+
+			Dynamic<T> operator * (T r) const {
+				Dynamic<T> v = *this;
+				return std::move(v *= r);
+			}
+
+			Dynamic<T> operator / (T r) const {
+				Dynamic<T> v = *this;
+				return std::move(v /= r);
+			}
+
+			std::string ToString() const {
+				if( size == 0 ) return "<>";
+				std::string string = "<";
+				for(int i=0;i<size;i++)
+					string += std::to_string(e[i]) + ", ";
+				return string.substr(0,string.length()-2) + ">";
+			}
+
+			template<typename P =Policy::Default>
+			bool IsZero() const {
+				for(int i=0; i<size; i++)
+					if( !Equals<T,P>(e[i],T()) ) return false;
+				return true;
+			}
+
+		protected:
+			T * e;
+			int size;
+		};
+
+		template<typename T>
+		T Dot(const Dynamic<T> & u, const Dynamic<T> & v) { return u*v; }
 
 	}
 
@@ -0,0 +1,80 @@
+#pragma once
+
+#ifndef MATH_BIGINTEGER
+#define MATH_BIGINTEGER
+
+#include <Math/Prefix.h>
+
+#include <string>
+#include <vector>
+
+namespace Math {
+
+	// arbitrary precision signed integer, sign and magnitude over little endian 32 bit limbs //
+	// products of operands past BigInteger::KaratsubaLimbs limbs go through Karatsuba //
+	class BigInteger {
+	public:
+		static const size_t KaratsubaLimbs = 32;
+
+		BigInteger(): negative(false) {}
+
+		template<typename I, typename =typename std::enable_if<std::is_integral<I>::value>::type>
+		BigInteger(I x): negative(x < 0) {
+			uint64_t m = x < 0 ? uint64_t(0) - uint64_t(x) : uint64_t(x);
+			for(;m;m >>= 32) limbs.push_back(uint32_t(m));
+		}
+
+		bool IsZero() const { return limbs.empty(); }
+		bool IsNegative() const { return negative; }
+		API size_t Bits() const;
+
+		// the value when it fits in int64_t, otherwise 0 and Status::Overflow //
+		API int64_t ToInt64(Status * status =nullptr) const;
+		API std::string ToString() const;
+
+		// <0, 0 or >0 as this is less than, equal to or greater than u //
+		API int Compare(const BigInteger & u) const;
+
+		bool operator == (const BigInteger & u) const { return Compare(u) == 0; }
+		bool operator != (const BigInteger & u) const { return Compare(u) != 0; }
+		bool operator < (const BigInteger & u) const { return Compare(u) < 0; }
+		bool operator <= (const BigInteger & u) const { return Compare(u) <= 0; }
+		bool operator > (const BigInteger & u) const { return Compare(u) > 0; }
+		bool operator >= (const BigInteger & u) const { return Compare(u) >= 0; }
+
+		API BigInteger & operator += (const BigInteger & u);
+		API BigInteger & operator -= (const BigInteger & u);
+		API BigInteger & operator *= (const BigInteger & u);
+		API BigInteger & operator <<= (size_t bits);
+
+		// this/d when d is known to divide this, O(n*m) from the low limbs up rather than a full long division //
+		API BigInteger & DivideExact(const BigInteger & d);
+
+		BigInteger operator - () const {
+			BigInteger v = *this;
+			if( !v.IsZero() ) v.negative = !v.negative;
+			return v;
+		}
+
+		BigInteger operator + (const BigInteger & u) const { BigInteger v = *this; return v += u; }
+		BigInteger operator - (const BigInteger & u) const { BigInteger v = *this; return v -= u; }
+		BigInteger operator * (const BigInteger & u) const { BigInteger v = *this; return v *= u; }
+		BigInteger operator << (size_t bits) const { BigInteger v = *this; return v <<= bits; }
+
+		const std::vector<uint32_t> & Limbs() const { return limbs; }
+
+	protected:
+		API void Trim();
+
+		std::vector<uint32_t> limbs;
+		bool negative;
+	};
+
+	// out = F(n) for any n with F(0) = 0 as FibonacciNumber counts, fast doubling over BigInteger //
+	API void FibonacciNumber(uint32_t n, BigInteger & out);
+
+	// out[i-first] = F(i) for i in [first,last), indexed as FibonacciNumber //
+	API void FibonacciRange(uint32_t first, uint32_t last, BigInteger * out);
+}
+
+#endif // ending MATH_BIGINTEGER //
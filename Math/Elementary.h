@@ -0,0 +1,248 @@
+#pragma once
+
+#ifndef MATH_ELEMENTARY
+#define MATH_ELEMENTARY
+
+#include <Math/Prefix.h>
+#include <Math/SIMD.h>
+#include <Math/Algebra/Batch.h>
+
+#include <limits>
+
+namespace Math {
+	namespace Batch {
+
+		// Precise stays within a few ULP of the exact result, Fast drops to shorter polynomials worth roughly 15 bits for float and 32 for double //
+		// the bounds quoted below are the worst cases seen over tens of millions of samples against long double libm //
+		enum class Accuracy {
+			Precise,
+			Fast
+		};
+
+		namespace Kernel {
+
+			// c0 + x*(c1 + x*(c2 + ...)) //
+			template<typename P, typename T>
+			P Horner(const P &, T c) { return P(c); }
+
+			template<typename P, typename T, typename... C>
+			P Horner(const P & x, T c, C... rest) { return Simd::MultiplyAdd(Horner(x, rest...), x, P(c)); }
+
+			// Chebyshev fitted corrections on the reduced ranges, exp(r) = 1 + r + r^2 Exp(r) on |r| <= ln2/2, //
+			// sin(r) = r + r^3 Sin(r^2) and cos(r) = 1 - r^2/2 + r^4 Cos(r^2) on |r| <= pi/4, //
+			// log(1+f) = f - f^2/2 + s(f^2/2 + s^2 Log(s^2)) with s = f/(2+f) and 1+f in [sqrt(1/2),sqrt(2)), //
+			// atan(y) = y + y^3 ArcTan(y^2) on |y| <= tan(pi/8) //
+			template<typename T, bool fast>
+			struct Polynomial;
+
+			template<>
+			struct Polynomial<float,false> {
+				template<typename P> static P Exp(const P & r) { return Horner(r, 5.000000000e-01f, 1.666666716e-01f, 4.166646674e-02f, 8.333310485e-03f, 1.393364160e-03f, 1.989098091e-04f); }
+				template<typename P> static P Sin(const P & z) { return Horner(z, -1.666666418e-01f, 8.332747966e-03f, -1.958789071e-04f); }
+				template<typename P> static P Cos(const P & z) { return Horner(z, 4.166666418e-02f, -1.388830249e-03f, 2.454794230e-05f); }
+				template<typename P> static P Log(const P & z) { return Horner(z, 6.666668653e-01f, 3.998878002e-01f, 2.957994938e-01f); }
+				template<typename P> static P ArcTan(const P & z) { return Horner(z, -3.333333135e-01f, 1.999953985e-01f, -1.426395625e-01f, 1.074373126e-01f, -6.451927871e-02f); }
+			};
+
+			template<>
+			struct Polynomial<float,true> {
+				template<typename P> static P Exp(const P & r) { return Horner(r, 5.000000000e-01f, 1.674189866e-01f, 4.179198667e-02f); }
+				template<typename P> static P Sin(const P & z) { return Horner(z, -1.666573137e-01f, 8.211855777e-03f); }
+				template<typename P> static P Cos(const P & z) { return Horner(z, 4.166549444e-02f, -1.373681356e-03f); }
+				template<typename P> static P Log(const P & z) { return Horner(z, 6.666349769e-01f, 4.085826874e-01f); }
+				template<typename P> static P ArcTan(const P & z) { return Horner(z, -3.333189785e-01f, 1.984809786e-01f, -1.181944460e-01f); }
+			};
+
+			template<>
+			struct Polynomial<double,false> {
+				template<typename P> static P Exp(const P & r) {
+					return Horner(r, 5.00000000000000111e-01, 1.66666666666666685e-01, 4.16666666666241636e-02, 8.33333333333006500e-03, 1.38888889171967186e-03,
+						1.98412698630405450e-04, 2.48015213223686919e-05, 2.75572684803100238e-06, 2.76200758799833672e-07, 2.51003758325612340e-08);
+				}
+				template<typename P> static P Sin(const P & z) {
+					return Horner(z, -1.66666666666666657e-01, 8.33333333333094797e-03, -1.98412698367585736e-04, 2.75573161025524389e-06, -2.50511318450036243e-08, 1.59181292948666079e-10);
+				}
+				template<typename P> static P Cos(const P & z) {
+					return Horner(z, 4.16666666666666644e-02, -1.38888888888873976e-03, 2.48015872987656891e-05, -2.75573172717297931e-07, 2.08761462684031992e-09, -1.13826324255217172e-11);
+				}
+				template<typename P> static P Log(const P & z) {
+					return Horner(z, 6.66666666666666963e-01, 3.99999999998995048e-01, 2.85714286259754868e-01, 2.22222111347950807e-01, 1.81828891252617225e-01,
+						1.53317216005560419e-01, 1.46164496850434061e-01);
+				}
+				template<typename P> static P ArcTan(const P & z) {
+					return Horner(z, -3.33333333333333315e-01, 1.99999999999955214e-01, -1.42857142846665425e-01, 1.11111110152563614e-01, -9.09090457812390257e-02,
+						7.69218319082608654e-02, -6.66451144738194751e-02, 5.85814891280221003e-02, -5.08544973794025981e-02, 3.92316582955871893e-02, -1.91768871190622567e-02);
+				}
+			};
+
+			template<>
+			struct Polynomial<double,true> {
+				template<typename P> static P Exp(const P & r) { return Horner(r, 5.00000001345772715e-01, 1.66666666816142561e-01, 4.16664650060400502e-02, 8.33331093444886900e-03, 1.39336410319867011e-03, 1.98909808697503266e-04); }
+				template<typename P> static P Sin(const P & z) { return Horner(z, -1.66666666638552896e-01, 8.33333187471020816e-03, -1.98400867353848464e-04, 2.72499258030597915e-06); }
+				template<typename P> static P Cos(const P & z) { return Horner(z, 4.16666666643212003e-02, -1.38888876720167894e-03, 2.48006003771567284e-05, -2.73009592039014691e-07); }
+				template<typename P> static P Log(const P & z) { return Horner(z, 6.66666665544970893e-01, 4.00001218398061242e-01, 2.85508208159606647e-01, 2.33304672163038351e-01); }
+				template<typename P> static P ArcTan(const P & z) {
+					return Horner(z, -3.33333332792548009e-01, 1.99999772586883867e-01, -1.42841511936286136e-01, 1.10713650218847937e-01, -8.62467614524949355e-02, 5.04813851207974451e-02);
+				}
+			};
+
+			// inputs the polynomial paths accept, anything outside goes to libm one lane at a time //
+			template<typename T>
+			struct Domain {
+				static T ExpLow() { return std::is_same<T,float>::value ? T(-87.6f) : T(-708.7); }
+				static T ExpHigh() { return std::is_same<T,float>::value ? T(88.3f) : T(709.4); }
+
+				// the Cody-Waite products q*HalfPi stay exact below this //
+				static T Trigonometric() { return std::is_same<T,float>::value ? T(8192.0f) : T(1.0e6); }
+			};
+
+			// kernels hand packs by reference, a by value Pack is split across two registers at a call boundary and stalls on the reload //
+			template<typename T, bool fast, typename P>
+			void Exp(const P & in, P & out) {
+				const bool single = std::is_same<T,float>::value;
+				const P x = Simd::Min(Simd::Max(in, P(Domain<T>::ExpLow())), P(Domain<T>::ExpHigh()));
+				const P n = Simd::Round(x*P(T(1.44269504088896340736)));
+				P r = Simd::MultiplyAdd(n, P(single ? T(-6.93359375e-01f) : T(-6.93147180369123816e-01)), x);
+				r = Simd::MultiplyAdd(n, P(single ? T(2.12194440e-04f) : T(-1.90821492927058770e-10)), r);
+				const P p = Simd::MultiplyAdd(Polynomial<T,fast>::Exp(r), r*r, r + P(T(1)));
+				out = p*Simd::Power2(n);
+			}
+
+			template<typename T, bool fast, typename P>
+			void Log(const P & x, P & out) {
+				const bool single = std::is_same<T,float>::value;
+				P e, m = Simd::Mantissa(x, e);
+				const P small = Simd::Less(m, P(T(0.70710678118654752440)));
+				m = Simd::Select(small, m + m, m);
+				e = Simd::Select(small, e - P(T(1)), e);
+
+				const P f = m - P(T(1)), s = f/(f + P(T(2))), z = s*s, half = P(T(0.5))*f*f;
+				const P tail = Simd::MultiplyAdd(s, Simd::MultiplyAdd(z, Polynomial<T,fast>::Log(z), half), e*P(single ? T(-2.12194440e-04f) : T(1.90821492927058770e-10)));
+				out = Simd::MultiplyAdd(e, P(single ? T(6.93359375e-01f) : T(6.93147180369123816e-01)), f - (half - tail));
+			}
+
+			// x = q*pi/2 + r with |r| <= pi/4, pi/2 split in parts short enough that the leading products are exact //
+			template<typename T, bool fast, typename P>
+			void SinCos(const P & x, P & sine, P & cosine) {
+				const bool single = std::is_same<T,float>::value;
+				const P q = Simd::Round(x*P(T(0.63661977236758134308)));
+				P r = Simd::MultiplyAdd(q, P(single ? T(-1.570312500e+00f) : T(-1.57079632673412561e+00)), x);
+				r = Simd::MultiplyAdd(q, P(single ? T(-4.837512970e-04f) : T(-6.07710050630396598e-11)), r);
+				r = Simd::MultiplyAdd(q, P(single ? T(-7.549533620e-08f) : T(-2.02226624879595063e-21)), r);
+				if( single ) r = Simd::MultiplyAdd(q, P(T(-2.563344068e-12f)), r);
+
+				const P z = r*r;
+				const P s = Simd::MultiplyAdd(r*z, Polynomial<T,fast>::Sin(z), r);
+				const P c = Simd::MultiplyAdd(z*z, Polynomial<T,fast>::Cos(z), P(T(1)) - P(T(0.5))*z);
+
+				// quadrant j = q mod 4 picks the polynomial and the sign //
+				const P j = q - P(T(4))*Simd::Round(q*P(T(0.25)) - P(T(0.375)));
+				const P odd = Simd::Less(P(T(0.5)), j - P(T(2))*Simd::Round(j*P(T(0.5)) - P(T(0.25))));
+				const P v = Simd::Select(odd, c, s), w = Simd::Select(odd, s, c);
+				sine = Simd::Select(Simd::Less(P(T(1.5)), j), -v, v);
+				cosine = Simd::Select(Simd::Less(Simd::Abs(j - P(T(1.5))), P(T(1))), -w, w);
+			}
+
+			// one division reduces |x| past tan(3pi/8) to -1/|x| and past tan(pi/8) to (|x|-1)/(|x|+1) //
+			template<typename T, bool fast, typename P>
+			void ArcTan(const P & x, P & out) {
+				const P a = Simd::Abs(x), one(T(1));
+				const P big = Simd::Less(P(T(2.41421356237309504880)), a), middle = Simd::Less(P(T(0.41421356237309504880)), a);
+				const P y = Simd::Select(big, -one, Simd::Select(middle, a - one, a))/Simd::Select(big, a, Simd::Select(middle, a + one, one));
+				const P base = Simd::Select(big, P(Pi<T>()/T(2)), Simd::Select(middle, P(Pi<T>()/T(4)), P(T(0))));
+				const P z = y*y;
+				const P angle = base + Simd::MultiplyAdd(y*z, Polynomial<T,fast>::ArcTan(z), y);
+				out = Simd::Select(Simd::Less(x, P(T(0))), -angle, angle);
+			}
+
+			// vector(in[i], out[i]) over whole registers and the tail, lanes outside [lo,hi] are redone by scalar //
+			template<typename T, typename Vector, typename Scalar>
+			void Map(const T * in, T * out, size_t count, T lo, T hi, Vector vector, Scalar scalar) {
+				static_assert(std::is_same<T,float>::value or std::is_same<T,double>::value, "Batch functions take float or double arrays");
+				Math::Vector::Kernel::Sweep<T>(count, [=](size_t i, auto p) {
+					typedef decltype(p) P;
+					const P x = P::Load(in+i);
+					P y;
+					vector(x, y);
+					if( Simd::Any(Simd::Outside(x, P(lo), P(hi))) )
+						for(int l=0;l<P::Lanes();l++) if( !(x[l] >= lo and x[l] <= hi) ) y[l] = scalar(x[l]);
+					y.Store(out+i);
+				});
+			}
+		}
+
+		// out[i] = e^in[i], out may be in //
+		// Precise: 1.5 ULP. Fast: 2^8 ULP for float, 2^21 ULP for double //
+		template<typename T>
+		void Exp(const T * in, T * out, size_t count, Accuracy accuracy =Accuracy::Precise) {
+			const T lo = Kernel::Domain<T>::ExpLow(), hi = Kernel::Domain<T>::ExpHigh();
+			const auto scalar = [](T x) { return std::exp(x); };
+			if( accuracy == Accuracy::Fast ) Kernel::Map(in, out, count, lo, hi, [](const auto & x, auto & y) { Kernel::Exp<T,true>(x, y); }, scalar);
+			else Kernel::Map(in, out, count, lo, hi, [](const auto & x, auto & y) { Kernel::Exp<T,false>(x, y); }, scalar);
+		}
+
+		// out[i] = natural log of in[i], zero, negative, subnormal and non finite inputs follow std::log //
+		// Precise: 1 ULP. Fast: 8 ULP for float, 2^17 ULP for double //
+		template<typename T>
+		void Log(const T * in, T * out, size_t count, Accuracy accuracy =Accuracy::Precise) {
+			const T lo = std::numeric_limits<T>::min(), hi = std::numeric_limits<T>::max();
+			const auto scalar = [](T x) { return std::log(x); };
+			if( accuracy == Accuracy::Fast ) Kernel::Map(in, out, count, lo, hi, [](const auto & x, auto & y) { Kernel::Log<T,true>(x, y); }, scalar);
+			else Kernel::Map(in, out, count, lo, hi, [](const auto & x, auto & y) { Kernel::Log<T,false>(x, y); }, scalar);
+		}
+
+		// out[i] = sin(in[i]) and cos(in[i]) in radians, |in[i]| past 8192 for float or 10^6 for double goes through libm //
+		// Precise: 2.5 ULP. Fast: 2^7 ULP for float, 2^17 ULP for double //
+		template<typename T>
+		void Sin(const T * in, T * out, size_t count, Accuracy accuracy =Accuracy::Precise) {
+			const T limit = Kernel::Domain<T>::Trigonometric();
+			const auto scalar = [](T x) { return std::sin(x); };
+			if( accuracy == Accuracy::Fast ) Kernel::Map(in, out, count, -limit, limit, [](const auto & x, auto & y) { auto c = x; Kernel::SinCos<T,true>(x, y, c); }, scalar);
+			else Kernel::Map(in, out, count, -limit, limit, [](const auto & x, auto & y) { auto c = x; Kernel::SinCos<T,false>(x, y, c); }, scalar);
+		}
+
+		template<typename T>
+		void Cos(const T * in, T * out, size_t count, Accuracy accuracy =Accuracy::Precise) {
+			const T limit = Kernel::Domain<T>::Trigonometric();
+			const auto scalar = [](T x) { return std::cos(x); };
+			if( accuracy == Accuracy::Fast ) Kernel::Map(in, out, count, -limit, limit, [](const auto & x, auto & y) { auto s = x; Kernel::SinCos<T,true>(x, s, y); }, scalar);
+			else Kernel::Map(in, out, count, -limit, limit, [](const auto & x, auto & y) { auto s = x; Kernel::SinCos<T,false>(x, s, y); }, scalar);
+		}
+
+		// both at the cost of one range reduction, sine and cosine must not overlap each other //
+		template<typename T>
+		void SinCos(const T * in, T * sine, T * cosine, size_t count, Accuracy accuracy =Accuracy::Precise) {
+			static_assert(std::is_same<T,float>::value or std::is_same<T,double>::value, "Batch functions take float or double arrays");
+			const T limit = Kernel::Domain<T>::Trigonometric();
+			const bool fast = accuracy == Accuracy::Fast;
+			Math::Vector::Kernel::Sweep<T>(count, [=](size_t i, auto p) {
+				typedef decltype(p) P;
+				const P x = P::Load(in+i);
+				P s, c;
+				if( fast ) Kernel::SinCos<T,true>(x, s, c);
+				else Kernel::SinCos<T,false>(x, s, c);
+				if( Simd::Any(Simd::Outside(x, P(-limit), P(limit))) ){
+					for(int l=0;l<P::Lanes();l++){
+						if( x[l] >= -limit and x[l] <= limit ) continue;
+						s[l] = std::sin(x[l]);
+						c[l] = std::cos(x[l]);
+					}
+				}
+				s.Store(sine+i);
+				c.Store(cosine+i);
+			});
+		}
+
+		// out[i] = atan(in[i]) in (-pi/2,pi/2) //
+		// Precise: 2.5 ULP. Fast: 2^5 ULP for float, 2^20 ULP for double //
+		template<typename T>
+		void ArcTan(const T * in, T * out, size_t count, Accuracy accuracy =Accuracy::Precise) {
+			const T limit = std::numeric_limits<T>::infinity();
+			const auto scalar = [](T x) { return std::atan(x); };
+			if( accuracy == Accuracy::Fast ) Kernel::Map(in, out, count, -limit, limit, [](const auto & x, auto & y) { Kernel::ArcTan<T,true>(x, y); }, scalar);
+			else Kernel::Map(in, out, count, -limit, limit, [](const auto & x, auto & y) { Kernel::ArcTan<T,false>(x, y); }, scalar);
+		}
+	}
+}
+
+#endif // ending MATH_ELEMENTARY //
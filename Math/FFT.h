@@ -0,0 +1,390 @@
+#pragma once
+
+#ifndef MATH_FFT
+#define MATH_FFT
+
+#include <Math/Prefix.h>
+#include <Math/Parallel.h>
+#include <Math/Algebra/Complex.h>
+#include <Math/Algebra/GEMM.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Math {
+	namespace FFT {
+
+		// prime factors above this go through Bluestein's chirp z transform rather than an O(p^2) butterfly //
+		const size_t RadixLimit = 64;
+
+		// 2D transforms hand each Parallel worker at least this many points //
+		const size_t Grain = 1 << 14;
+
+		namespace Kernel {
+			// the layout of Complex::Template<T>, with only the arithmetic the butterflies need //
+			template<typename T>
+			struct Value { T re, im; };
+
+			template<typename T>
+			inline Value<T> operator + (const Value<T> & a, const Value<T> & b) { return Value<T>{a.re + b.re, a.im + b.im}; }
+
+			template<typename T>
+			inline Value<T> operator - (const Value<T> & a, const Value<T> & b) { return Value<T>{a.re - b.re, a.im - b.im}; }
+
+			template<typename T>
+			inline Value<T> operator * (const Value<T> & a, const Value<T> & b) { return Value<T>{a.re*b.re - a.im*b.im, a.re*b.im + a.im*b.re}; }
+
+			template<typename T>
+			inline Value<T> operator * (const Value<T> & a, T r) { return Value<T>{a.re*r, a.im*r}; }
+
+			template<typename T>
+			inline Value<T> Conjugate(const Value<T> & a) { return Value<T>{a.re, -a.im}; }
+
+			// -i*a //
+			template<typename T>
+			inline Value<T> MinusI(const Value<T> & a) { return Value<T>{a.im, -a.re}; }
+
+			// e^(-2 pi i k/n), evaluated in long double so float and double tables are correctly rounded //
+			template<typename T>
+			Value<T> Root(uint64_t k, uint64_t n) {
+				const long double angle = -2*Pi<long double>()*static_cast<long double>(k % n)/static_cast<long double>(n);
+				return Value<T>{static_cast<T>(cosl(angle)), static_cast<T>(sinl(angle))};
+			}
+
+			// one Stockham autosort pass: span points are already combined, x is read at stride n/radix and y written in order //
+			// w holds the radix-1 twiddles of each of the span offsets //
+			template<typename T>
+			void Pass2(const Value<T> * x, Value<T> * y, size_t n, size_t span, const Value<T> * w) {
+				const size_t stride = n/2;
+				for(size_t b=0;b<stride;b+=span){
+					Value<T> * out = y + 2*b;
+					for(size_t k=0;k<span;k++){
+						const Value<T> a0 = x[b+k], a1 = x[b+k+stride]*w[k];
+						out[k] = a0 + a1;
+						out[k+span] = a0 - a1;
+					}
+				}
+			}
+
+			template<typename T>
+			void Pass3(const Value<T> * x, Value<T> * y, size_t n, size_t span, const Value<T> * w) {
+				const size_t stride = n/3;
+				const T s = T(0.866025403784438646763723170752936183L);
+				for(size_t b=0;b<stride;b+=span){
+					Value<T> * out = y + 3*b;
+					for(size_t k=0;k<span;k++){
+						const Value<T> a0 = x[b+k], a1 = x[b+k+stride]*w[2*k], a2 = x[b+k+2*stride]*w[2*k+1];
+						const Value<T> t = a1 + a2, m = a0 - t*T(0.5), d = MinusI(a1 - a2)*s;
+						out[k] = a0 + t;
+						out[k+span] = m + d;
+						out[k+2*span] = m - d;
+					}
+				}
+			}
+
+			template<typename T>
+			void Pass4(const Value<T> * x, Value<T> * y, size_t n, size_t span, const Value<T> * w) {
+				const size_t stride = n/4;
+				for(size_t b=0;b<stride;b+=span){
+					Value<T> * out = y + 4*b;
+					for(size_t k=0;k<span;k++){
+						const Value<T> a0 = x[b+k], a1 = x[b+k+stride]*w[3*k], a2 = x[b+k+2*stride]*w[3*k+1], a3 = x[b+k+3*stride]*w[3*k+2];
+						const Value<T> t0 = a0 + a2, t1 = a0 - a2, t2 = a1 + a3, t3 = MinusI(a1 - a3);
+						out[k] = t0 + t2;
+						out[k+span] = t1 + t3;
+						out[k+2*span] = t0 - t2;
+						out[k+3*span] = t1 - t3;
+					}
+				}
+			}
+
+			// any other prime radix as a direct DFT, root holds e^(-2 pi i t/radix) //
+			template<typename T>
+			void PassAny(const Value<T> * x, Value<T> * y, size_t n, size_t span, size_t radix, const Value<T> * w, const Value<T> * root) {
+				const size_t stride = n/radix;
+				Value<T> a[RadixLimit];
+				for(size_t b=0;b<stride;b+=span){
+					Value<T> * out = y + radix*b;
+					for(size_t k=0;k<span;k++){
+						a[0] = x[b+k];
+						for(size_t r=1;r<radix;r++) a[r] = x[b+k+r*stride]*w[(radix-1)*k+r-1];
+						for(size_t q=0;q<radix;q++){
+							Value<T> sum = a[0];
+							for(size_t r=1,t=q;r<radix;r++,t=(t+q)%radix) sum = sum + a[r]*root[t];
+							out[k+q*span] = sum;
+						}
+					}
+				}
+			}
+		}
+
+		// factorization, twiddles and scratch needs of one transform length, shared by every call of that length //
+		// lengths made of 2, 3 and primes up to RadixLimit run mixed radix Stockham passes, radix 4 first, others go through Bluestein //
+		template<typename T>
+		class Plan {
+			typedef Kernel::Value<T> Value;
+		public:
+			// the cached plan for n points, built on first use and kept for the life of the program //
+			static const Plan<T> & Get(size_t n) {
+				static std::mutex lock;
+				static std::map< size_t, std::unique_ptr< Plan<T> > > plans;
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					auto found = plans.find(n);
+					if( found != plans.end() ) return *found->second;
+				}
+				// built unlocked, a Bluestein plan asks for its power of two plan while it is being made //
+				std::unique_ptr< Plan<T> > plan(new Plan<T>(n));
+				std::lock_guard<std::mutex> guard(lock);
+				auto inserted = plans.emplace(n, std::move(plan));
+				return *inserted.first->second;
+			}
+
+			explicit Plan(size_t n): n(n), chirpPlan(nullptr) {
+				size_t m = n;
+				std::vector<size_t> radices;
+				for(;m%4 == 0;m /= 4) radices.push_back(4);
+				if( m%2 == 0 and m > 1 ) radices.push_back(2), m /= 2;
+				for(size_t p=3;p*p<=m;p+=2)
+					for(;m%p == 0;m /= p) radices.push_back(p);
+				if( m > 1 ) radices.push_back(m);
+
+				spin.resize(n);
+				for(size_t k=0;k<n;k++) spin[k] = Kernel::Root<T>(k, 2*n);
+
+				for(size_t radix : radices){
+					if( radix > RadixLimit ){
+						stages.clear();
+						Bluestein();
+						return;
+					}
+				}
+
+				size_t span = 1;
+				for(size_t radix : radices){
+					Stage stage = { radix, span, twiddles.size(), roots.size() };
+					for(size_t k=0;k<span;k++)
+						for(size_t r=1;r<radix;r++) twiddles.push_back(Kernel::Root<T>(k*r, span*radix));
+					if( radix != 2 and radix != 3 and radix != 4 )
+						for(size_t t=0;t<radix;t++) roots.push_back(Kernel::Root<T>(t, radix));
+					stages.push_back(stage);
+					span *= radix;
+				}
+			}
+
+			size_t Size() const { return n; }
+
+			// Value elements Execute needs as scratch //
+			size_t ScratchSize() const { return chirpPlan ? chirpPlan->Size() + chirpPlan->ScratchSize() : n; }
+
+			// data[k] = sum of data[j] e^(-2 pi i jk/n), scratch holds ScratchSize() elements and must not overlap data //
+			void Execute(Value * data, Value * scratch) const {
+				if( chirpPlan ) return ExecuteBluestein(data, scratch);
+
+				Value * x = data, * y = scratch;
+				for(const Stage & stage : stages){
+					const Value * w = &twiddles[stage.twiddle];
+					switch( stage.radix ){
+						case 2: Kernel::Pass2(x, y, n, stage.span, w); break;
+						case 3: Kernel::Pass3(x, y, n, stage.span, w); break;
+						case 4: Kernel::Pass4(x, y, n, stage.span, w); break;
+						default: Kernel::PassAny(x, y, n, stage.span, stage.radix, w, &roots[stage.root]);
+					}
+					std::swap(x,y);
+				}
+				if( x != data ) std::copy(x, x+n, data);
+			}
+
+			// the same with scratch from the calling thread's buffer, grown on demand and kept like the Gemm packing buffers //
+			void Forward(Value * data) const { Execute(data, Matrix::Kernel::Scratch<Value>::Get(0, ScratchSize())); }
+
+			// data[j] = 1/n sum of data[k] e^(2 pi i jk/n), the conjugate of the forward transform of the conjugate //
+			void Inverse(Value * data) const {
+				for(size_t i=0;i<n;i++) data[i].im = -data[i].im;
+				Forward(data);
+				const T scale = T(1)/T(n);
+				for(size_t i=0;i<n;i++) data[i] = Kernel::Conjugate(data[i])*scale;
+			}
+
+			// e^(-pi i k/n) for k in [0,n), the twiddles that split a real transform of 2n points over this plan //
+			const Value * Spin() const { return spin.data(); }
+
+		protected:
+			struct Stage { size_t radix, span, twiddle, root; };
+
+			// X(k) = c(k) sum of x(j) c(j) conj(c(k-j)) with c(k) = e^(-pi i k^2/n), the sum a circular convolution of length 2^p >= 2n-1 //
+			void Bluestein() {
+				size_t m = 1;
+				while( m < 2*n-1 ) m <<= 1;
+				chirpPlan = &Get(m);
+
+				chirp.resize(n);
+				for(size_t k=0;k<n;k++) chirp[k] = Kernel::Root<T>(uint64_t(k)*k % (2*n), 2*n);
+
+				// the filter is transformed once and carries the 1/m of the inverse //
+				filter.assign(m, Value{T(0),T(0)});
+				filter[0] = Kernel::Conjugate(chirp[0]);
+				for(size_t k=1;k<n;k++) filter[k] = filter[m-k] = Kernel::Conjugate(chirp[k]);
+				chirpPlan->Forward(filter.data());
+				for(size_t k=0;k<m;k++) filter[k] = filter[k]*(T(1)/T(m));
+			}
+
+			void ExecuteBluestein(Value * data, Value * scratch) const {
+				const size_t m = chirpPlan->Size();
+				Value * a = scratch, * inner = scratch + m;
+				for(size_t k=0;k<n;k++) a[k] = data[k]*chirp[k];
+				for(size_t k=n;k<m;k++) a[k] = Value{T(0),T(0)};
+				chirpPlan->Execute(a, inner);
+				for(size_t k=0;k<m;k++) a[k] = Kernel::Conjugate(a[k]*filter[k]);
+				chirpPlan->Execute(a, inner);
+				for(size_t k=0;k<n;k++) data[k] = Kernel::Conjugate(a[k])*chirp[k];
+			}
+
+			size_t n;
+			std::vector<Stage> stages;
+			std::vector<Value> twiddles, roots, spin;
+
+			const Plan<T> * chirpPlan;
+			std::vector<Value> chirp, filter;
+		};
+
+		namespace Kernel {
+			template<typename T>
+			Value<T> * Cast(Complex::Template<T> * data) {
+				static_assert(sizeof(Complex::Template<T>) == 2*sizeof(T), "Complex::Template<T> must be two packed T");
+				return reinterpret_cast<Value<T> *>(data);
+			}
+
+			template<typename T>
+			const Value<T> * Cast(const Complex::Template<T> * data) { return reinterpret_cast<const Value<T> *>(data); }
+		}
+
+		// data[k] = sum over j of data[j] e^(-2 pi i jk/n) in O(n log n) for every n //
+		template<typename T>
+		void Forward(Complex::Template<T> * data, size_t n) {
+			if( n > 1 ) Plan<T>::Get(n).Forward(Kernel::Cast(data));
+		}
+
+		// the inverse scaled by 1/n, so Inverse after Forward gives the input back //
+		template<typename T>
+		void Inverse(Complex::Template<T> * data, size_t n) {
+			if( n > 1 ) Plan<T>::Get(n).Inverse(Kernel::Cast(data));
+		}
+
+		// out[k] for k in [0,n/2] from n real samples, the other bins are the conjugates out[n-k] //
+		// even n runs one complex transform of n/2 points over the samples taken in pairs //
+		template<typename T>
+		void ForwardReal(const T * in, Complex::Template<T> * out, size_t n) {
+			typedef Kernel::Value<T> Value;
+			Value * X = Kernel::Cast(out);
+			if( n%2 or n < 4 ){
+				std::vector<Value> full(n);
+				for(size_t i=0;i<n;i++) full[i] = Value{in[i], T(0)};
+				if( n > 1 ) Plan<T>::Get(n).Forward(full.data());
+				for(size_t k=0;k<=n/2;k++) X[k] = full[k];
+				return;
+			}
+
+			const size_t h = n/2;
+			const Plan<T> & plan = Plan<T>::Get(h);
+			for(size_t k=0;k<h;k++) X[k] = Value{in[2*k], in[2*k+1]};
+			plan.Forward(X);
+
+			// X(k) = E(k) + W^k O(k) with E and O the transforms of the even and odd samples, recovered from Z(k) and Z(h-k) //
+			const Value * W = plan.Spin();
+			const T half = T(0.5);
+			auto split = [&](const Value & z, const Value & zr, const Value & w) {
+				const Value even = (z + Kernel::Conjugate(zr))*half, odd = Kernel::MinusI(z - Kernel::Conjugate(zr))*half;
+				return even + w*odd;
+			};
+			const Value z0 = X[0];
+			X[0] = Value{z0.re + z0.im, T(0)};
+			X[h] = Value{z0.re - z0.im, T(0)};
+			for(size_t k=1;k<=h/2;k++){
+				const Value a = X[k], b = X[h-k];
+				X[k] = split(a, b, W[k]);
+				if( k != h-k ) X[h-k] = split(b, a, W[h-k]);
+			}
+		}
+
+		// n real samples from the n/2+1 bins ForwardReal gives, scaled by 1/n, in is left untouched //
+		template<typename T>
+		void InverseReal(const Complex::Template<T> * in, T * out, size_t n) {
+			typedef Kernel::Value<T> Value;
+			const Value * X = Kernel::Cast(in);
+			if( n%2 or n < 4 ){
+				std::vector<Value> full(n);
+				for(size_t k=0;k<n;k++) full[k] = k <= n/2 ? X[k] : Kernel::Conjugate(X[n-k]);
+				if( n > 1 ) Plan<T>::Get(n).Inverse(full.data());
+				for(size_t i=0;i<n;i++) out[i] = full[i].re;
+				return;
+			}
+
+			// Z(k) = E(k) + i O(k) is the transform of x(2k) + i x(2k+1), which is exactly the layout of out //
+			const size_t h = n/2;
+			const Plan<T> & plan = Plan<T>::Get(h);
+			const Value * W = plan.Spin();
+			Value * Z = reinterpret_cast<Value *>(out);
+			const T half = T(0.5);
+			for(size_t k=0;k<h;k++){
+				const Value a = X[k], b = Kernel::Conjugate(X[h-k]);
+				const Value even = (a + b)*half, odd = (a - b)*Kernel::Conjugate(W[k])*half;
+				Z[k] = even - Kernel::MinusI(odd);
+			}
+			plan.Inverse(Z);
+		}
+
+		namespace Kernel {
+			// transforms every row of a rows x columns block, then every column through a gathered block of columns //
+			template<typename T>
+			void Transform2D(Value<T> * data, size_t rows, size_t columns, bool inverse) {
+				const Plan<T> & row = Plan<T>::Get(columns), & column = Plan<T>::Get(rows);
+				auto run = [inverse](const Plan<T> & plan, Value<T> * line, Value<T> * scratch) {
+					if( inverse ) for(size_t i=0;i<plan.Size();i++) line[i].im = -line[i].im;
+					plan.Execute(line, scratch);
+					if( inverse ) for(size_t i=0;i<plan.Size();i++) line[i].im = -line[i].im;
+				};
+
+				if( columns > 1 ){
+					Parallel::For(0, rows, Grain/columns + 1, [&](size_t first, size_t last) {
+						Value<T> * scratch = Matrix::Kernel::Scratch< Value<T> >::Get(0, row.ScratchSize());
+						for(size_t r=first;r<last;r++) run(row, data + r*columns, scratch);
+					});
+				}
+
+				// columns are copied out Block at a time so each row of the gather touches one cache line //
+				const size_t Block = 8;
+				if( rows > 1 ){
+					Parallel::For(0, columns, Grain/rows + 1, [&](size_t first, size_t last) {
+						Value<T> * lines = Matrix::Kernel::Scratch< Value<T> >::Get(1, Block*rows), * scratch = Matrix::Kernel::Scratch< Value<T> >::Get(0, column.ScratchSize());
+						for(size_t c=first;c<last;c+=Block){
+							const size_t width = last-c < Block ? last-c : Block;
+							for(size_t r=0;r<rows;r++)
+								for(size_t t=0;t<width;t++) lines[t*rows+r] = data[r*columns+c+t];
+							for(size_t t=0;t<width;t++) run(column, lines + t*rows, scratch);
+							for(size_t r=0;r<rows;r++)
+								for(size_t t=0;t<width;t++) data[r*columns+c+t] = lines[t*rows+r];
+						}
+					});
+				}
+
+				if( inverse ){
+					const T scale = T(1)/(T(rows)*T(columns));
+					for(size_t i=0;i<rows*columns;i++) data[i] = data[i]*scale;
+				}
+			}
+		}
+
+		// rows x columns row major, every row then every column transformed, both split across Parallel workers //
+		template<typename T>
+		void Forward2D(Complex::Template<T> * data, size_t rows, size_t columns) { Kernel::Transform2D(Kernel::Cast(data), rows, columns, false); }
+
+		// the inverse scaled by 1/(rows*columns) //
+		template<typename T>
+		void Inverse2D(Complex::Template<T> * data, size_t rows, size_t columns) { Kernel::Transform2D(Kernel::Cast(data), rows, columns, true); }
+	}
+}
+
+#endif // ending MATH_FFT //
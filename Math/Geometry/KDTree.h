@@ -0,0 +1,305 @@
+#pragma once
+
+#ifndef MATH_GEOMETRY_KDTREE
+#define MATH_GEOMETRY_KDTREE
+
+#include <Math/Prefix.h>
+#include <Math/Parallel.h>
+#include <Math/Geometry/Point.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+BEGIN_C
+# include <assert.h>
+END_C
+
+namespace Math {
+	namespace Geometry {
+		namespace Kernel {
+			// ranges at most this long are scanned rather than split //
+			const size_t TreeLeaf = 8;
+
+			// subtrees longer than this are partitioned one level at a time across Parallel workers, //
+			// batches of queries are split across workers in chunks of TreeQueryGrain //
+			const size_t TreeGrain = 1 << 14;
+			const size_t TreeQueryGrain = 256;
+		}
+
+		// static k-d tree over a set of points, balanced by medians along the widest axis //
+		// the layout is implicit: range [lo,hi) longer than Kernel::TreeLeaf keeps its median at mid = lo + (hi-lo)/2, //
+		// the left subtree in [lo,mid) and the right one in (mid,hi), so there are no node records or child links, //
+		// coordinates are stored flat in that order and only a split axis per splitting point rides alongside //
+		// distances are squared and in Real<T>::Type, radius queries take the radius itself //
+		template<typename T, uint32_t space=2>
+		class KDTree {
+			static_assert(space > 0 and space <= 256, "KDTree keeps split axes in a byte");
+		public:
+			typedef typename Real<T>::Type Distance;
+
+			// index into the points the tree was built from //
+			struct Neighbour {
+				uint32_t index;
+				Distance distance;
+			};
+
+			// marks the unused slots of a batch k nearest result when the tree has fewer than k points //
+			static const uint32_t None = ~uint32_t(0);
+
+			KDTree() {}
+			KDTree(const Point<T,space> * points, size_t count) { Build(points, count); }
+			KDTree(const std::vector< Point<T,space> > & points) { Build(points.data(), points.size()); }
+			~KDTree() {}
+
+			// O(n log n), points are copied so the array may go away afterwards //
+			void Build(const Point<T,space> * points, size_t count) {
+				assert(count < size_t(None));
+				coordinates.resize(count*space);
+				for(size_t i=0;i<count;i++)
+					for(uint32_t d=0;d<space;d++) coordinates[i*space+d] = points[i][d];
+				order.resize(count);
+				std::iota(order.begin(), order.end(), uint32_t(0));
+				axis.assign(count, 0);
+
+				// top levels one partition per range across workers, then whole subtrees per worker //
+				std::vector< std::pair<size_t,size_t> > level(1, std::make_pair(size_t(0), count)), next;
+				while( !level.empty() ){
+					Parallel::For(0, level.size(), 1, [&](size_t first, size_t last) {
+						for(size_t r=first;r<last;r++){
+							if( level[r].second - level[r].first > Kernel::TreeGrain ) Split(level[r].first, level[r].second);
+							else Subtree(level[r].first, level[r].second);
+						}
+					});
+					next.clear();
+					for(const auto & range : level){
+						if( range.second - range.first <= Kernel::TreeGrain ) continue;
+						const size_t mid = range.first + (range.second - range.first)/2;
+						next.push_back(std::make_pair(range.first, mid));
+						next.push_back(std::make_pair(mid+1, range.second));
+					}
+					level.swap(next);
+				}
+
+				std::vector<T> sorted(count*space);
+				for(size_t i=0;i<count;i++)
+					for(uint32_t d=0;d<space;d++) sorted[i*space+d] = coordinates[size_t(order[i])*space+d];
+				coordinates.swap(sorted);
+			}
+
+			size_t GetCount() const { return order.size(); }
+			bool IsEmpty() const { return order.empty(); }
+
+			// the k nearest points in increasing distance, fewer when the tree holds fewer, returns how many //
+			size_t Nearest(const Point<T,space> & q, size_t k, Neighbour * out) const {
+				if( !k or IsEmpty() ) return 0;
+				Heap heap(k, out);
+				Distance offset[space] = {};
+				Search(0, GetCount(), q, 0, offset, heap);
+				std::sort_heap(out, out+heap.size, Closer);
+				return heap.size;
+			}
+
+			std::vector<Neighbour> Nearest(const Point<T,space> & q, size_t k) const {
+				std::vector<Neighbour> out(std::min(k, GetCount()));
+				Nearest(q, k, out.data());
+				return out;
+			}
+
+			// the tree must not be empty //
+			Neighbour Nearest(const Point<T,space> & q) const {
+				assert(!IsEmpty());
+				Neighbour n;
+				Nearest(q, 1, &n);
+				return n;
+			}
+
+			// every point within radius of q, in no particular order, appended to out //
+			void Radius(const Point<T,space> & q, Distance radius, std::vector<Neighbour> & out) const {
+				if( IsEmpty() or radius < Distance(0) ) return;
+				Ball ball{radius*radius, &out};
+				Distance offset[space] = {};
+				Search(0, GetCount(), q, 0, offset, ball);
+			}
+
+			std::vector<Neighbour> Radius(const Point<T,space> & q, Distance radius) const {
+				std::vector<Neighbour> out;
+				Radius(q, radius, out);
+				return out;
+			}
+
+			// indices of every point with lo[d] <= p[d] <= hi[d] on each axis, appended to out //
+			void Box(const Point<T,space> & lo, const Point<T,space> & hi, std::vector<uint32_t> & out) const {
+				if( !IsEmpty() ) Inside(0, GetCount(), lo, hi, out);
+			}
+
+			std::vector<uint32_t> Box(const Point<T,space> & lo, const Point<T,space> & hi) const {
+				std::vector<uint32_t> out;
+				Box(lo, hi, out);
+				return out;
+			}
+
+			// out[i*k,(i+1)*k) = Nearest(queries[i], k), padded with {None, infinity} past the tree size //
+			void Nearest(const Point<T,space> * queries, size_t count, size_t k, Neighbour * out) const {
+				Parallel::For(0, count, Kernel::TreeQueryGrain, [=](size_t first, size_t last) {
+					for(size_t i=first;i<last;i++){
+						Neighbour * row = out + i*k;
+						for(size_t j=Nearest(queries[i], k, row);j<k;j++) row[j] = Neighbour{None, std::numeric_limits<Distance>::infinity()};
+					}
+				});
+			}
+
+			std::vector< std::vector<Neighbour> > Radius(const Point<T,space> * queries, size_t count, Distance radius) const {
+				std::vector< std::vector<Neighbour> > out(count);
+				Parallel::For(0, count, Kernel::TreeQueryGrain, [&](size_t first, size_t last) {
+					for(size_t i=first;i<last;i++) Radius(queries[i], radius, out[i]);
+				});
+				return out;
+			}
+
+			std::vector< std::vector<uint32_t> > Box(const Point<T,space> * lo, const Point<T,space> * hi, size_t count) const {
+				std::vector< std::vector<uint32_t> > out(count);
+				Parallel::For(0, count, Kernel::TreeQueryGrain, [&](size_t first, size_t last) {
+					for(size_t i=first;i<last;i++) Box(lo[i], hi[i], out[i]);
+				});
+				return out;
+			}
+		protected:
+			static bool Closer(const Neighbour & a, const Neighbour & b) { return a.distance < b.distance; }
+
+			// k best so far as a max heap in the caller's array, bound is the worst once full //
+			struct Heap {
+				size_t k, size;
+				Neighbour * items;
+
+				Heap(size_t k, Neighbour * items): k(k), size(0), items(items) {}
+
+				Distance Bound() const { return size < k ? std::numeric_limits<Distance>::infinity() : items[0].distance; }
+
+				void Visit(uint32_t index, Distance distance) {
+					if( size < k ){
+						items[size++] = Neighbour{index, distance};
+						std::push_heap(items, items+size, Closer);
+					}
+					else if( distance < items[0].distance ){
+						std::pop_heap(items, items+size, Closer);
+						items[size-1] = Neighbour{index, distance};
+						std::push_heap(items, items+size, Closer);
+					}
+				}
+			};
+
+			struct Ball {
+				Distance bound;
+				std::vector<Neighbour> * out;
+
+				Distance Bound() const { return bound; }
+				void Visit(uint32_t index, Distance distance) { if( distance <= bound ) out->push_back(Neighbour{index, distance}); }
+			};
+
+			Distance Squared(size_t i, const Point<T,space> & q) const {
+				const T * p = coordinates.data() + i*space;
+				Distance d = 0;
+				for(uint32_t a=0;a<space;a++){
+					const Distance e = Distance(q[a]) - Distance(p[a]);
+					d += e*e;
+				}
+				return d;
+			}
+
+			// bound is the squared distance from q to the cell of [lo,hi), built up one axis at a time from the offsets //
+			// to the splitting planes crossed on the way down (Arya and Mount), the far side is skipped once it passes the visitor //
+			template<typename Visitor>
+			void Search(size_t lo, size_t hi, const Point<T,space> & q, Distance bound, Distance * offset, Visitor & visitor) const {
+				if( hi - lo <= Kernel::TreeLeaf ){
+					for(size_t i=lo;i<hi;i++) visitor.Visit(order[i], Squared(i, q));
+					return;
+				}
+				const size_t mid = lo + (hi-lo)/2;
+				const uint32_t a = axis[mid];
+				const Distance diff = Distance(q[a]) - Distance(coordinates[mid*space+a]);
+				visitor.Visit(order[mid], Squared(mid, q));
+
+				// near side first so the k nearest bound is as tight as it gets before the far side is tested //
+				const bool left = diff < Distance(0);
+				if( left ) Search(lo, mid, q, bound, offset, visitor);
+				else Search(mid+1, hi, q, bound, offset, visitor);
+
+				const Distance old = offset[a], far = bound - old*old + diff*diff;
+				if( far <= visitor.Bound() ){
+					offset[a] = diff;
+					if( left ) Search(mid+1, hi, q, far, offset, visitor);
+					else Search(lo, mid, q, far, offset, visitor);
+					offset[a] = old;
+				}
+			}
+
+			void Inside(size_t lo, size_t hi, const Point<T,space> & low, const Point<T,space> & high, std::vector<uint32_t> & out) const {
+				while( hi - lo > Kernel::TreeLeaf ){
+					const size_t mid = lo + (hi-lo)/2;
+					const uint32_t a = axis[mid];
+					const T split = coordinates[mid*space+a];
+					if( Contains(mid, low, high) ) out.push_back(order[mid]);
+
+					const bool left = !(split < low[a]), right = !(high[a] < split);
+					if( left and right ){
+						Inside(lo, mid, low, high, out);
+						lo = mid+1;
+					}
+					else if( left ) hi = mid;
+					else if( right ) lo = mid+1;
+					else return;
+				}
+				for(size_t i=lo;i<hi;i++)
+					if( Contains(i, low, high) ) out.push_back(order[i]);
+			}
+
+			bool Contains(size_t i, const Point<T,space> & low, const Point<T,space> & high) const {
+				const T * p = coordinates.data() + i*space;
+				for(uint32_t a=0;a<space;a++)
+					if( p[a] < low[a] or high[a] < p[a] ) return false;
+				return true;
+			}
+
+			// median of [lo,hi) along its widest axis into mid, coordinates are still in input order during the build //
+			void Split(size_t lo, size_t hi) {
+				T low[space], high[space];
+				for(uint32_t a=0;a<space;a++) low[a] = high[a] = coordinates[size_t(order[lo])*space+a];
+				for(size_t i=lo+1;i<hi;i++){
+					const T * p = coordinates.data() + size_t(order[i])*space;
+					for(uint32_t a=0;a<space;a++){
+						if( p[a] < low[a] ) low[a] = p[a];
+						if( high[a] < p[a] ) high[a] = p[a];
+					}
+				}
+				uint32_t widest = 0;
+				for(uint32_t a=1;a<space;a++)
+					if( Distance(high[widest]) - Distance(low[widest]) < Distance(high[a]) - Distance(low[a]) ) widest = a;
+
+				const size_t mid = lo + (hi-lo)/2;
+				const T * c = coordinates.data();
+				std::nth_element(order.begin()+lo, order.begin()+mid, order.begin()+hi, [=](uint32_t x, uint32_t y) { return c[size_t(x)*space+widest] < c[size_t(y)*space+widest]; });
+				axis[mid] = uint8_t(widest);
+			}
+
+			void Subtree(size_t lo, size_t hi) {
+				while( hi - lo > Kernel::TreeLeaf ){
+					Split(lo, hi);
+					const size_t mid = lo + (hi-lo)/2;
+					Subtree(lo, mid);
+					lo = mid+1;
+				}
+			}
+
+			std::vector<T> coordinates;
+			std::vector<uint32_t> order;
+			std::vector<uint8_t> axis;
+		};
+
+		template<typename T, uint32_t space>
+		const uint32_t KDTree<T,space>::None;
+	}
+}
+
+#endif // ending MATH_GEOMETRY_KDTREE //
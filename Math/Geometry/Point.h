@@ -4,6 +4,7 @@
 #define MATH_GEOMETRY_POIspaceT
 
 #include <Math/Prefix.h>
+#include <Math/Algebra/Vector.h>
 
 namespace Math {
 	namespace Geometry {
@@ -11,13 +12,22 @@ namespace Math {
 		template<typename T, uint32_t space=2>
 		class Point {
 		public:
-			Point();
-			Point(const Vector::Template<T,space> & u) {
-				operator=(u);
+			Point() {}
+			Point(const Point<T,space> &) = default;
+			Point(const Vector::Template<T,space> & u) : point(u) {}
+			~Point() {}
+
+			typename Real<T>::Type GetDistance(const Point<T,space> & u) const { return std::sqrt(GetDistanceSquared(u)); }
+
+			// no square root, what nearest neighbour searches compare //
+			typename Real<T>::Type GetDistanceSquared(const Point<T,space> & u) const {
+				typename Real<T>::Type d = 0;
+				for(uint32_t i=0;i<space;i++){
+					const typename Real<T>::Type e = typename Real<T>::Type(point[i]) - typename Real<T>::Type(u.point[i]);
+					d += e*e;
+				}
+				return d;
 			}
-			~Point();
-
-			float GetDistance(const Point<T,space> & u) const { return (point - u.point).GetLength(); }
 
 			bool operator == (const Point<T,space> & u) const {
 				for(uint32_t i=0;i<space;i++)
@@ -27,22 +37,22 @@ namespace Math {
 
 			bool operator != (const Point<T,space> & u) const { return !operator==(u); }
 
-			typename Point<T,space> & operator = (const Point<T,space> & u) {
+			Point<T,space> & operator = (const Point<T,space> & u) {
 				for(uint32_t i=0;i<space;i++) point[i] = u.point[i];
 				return *this;
 			}
 
-			typename Point<T,space> & operator += (const Point<T,space> & u) {
+			Point<T,space> & operator += (const Point<T,space> & u) {
 				for(uint32_t i=0;i<space;i++) point[i] += u.point[i];
 				return *this;
 			}
 
-			typename Point<T,space> & operator -= (const Point<T,space> & u) {
+			Point<T,space> & operator -= (const Point<T,space> & u) {
 				for(uint32_t i=0;i<space;i++) point[i] -= u.point[i];
 				return *this;
 			}
 
-			typename Point<T,space> & operator *= (T const & r) {
+			Point<T,space> & operator *= (T const & r) {
 				for(uint32_t i=0;i<space;i++) point[i] *= r;
 				return *this;
 			}
@@ -50,8 +60,8 @@ namespace Math {
 			T & operator [] (uint32_t i) { return point[i]; }
 			const T & operator [] (uint32_t i) const { return point[i]; }
 
-			T * operator & (void) { return reinterpret_cast<T *>(point); }
-			const T * operator & (void) const { return reinterpret_cast<T *>(point); }
+			T * operator & (void) { return &point; }
+			const T * operator & (void) const { return &point; }
 		protected:
 			Vector::Template<T,space> point;
 		};
@@ -73,24 +83,24 @@ namespace Math {
 			}
 
 			float GetLength() const { return (terminal-start).GetLength(); }
-			typename Line<T,N> Scale(T const & r) const {
-				Line<T,N> line;
+			Line<T,space> Scale(T const & r) const {
+				Line<T,space> line;
 				line.start = start*r;
 				line.terminal = terminal*r;
 				return line;
 			}
 
-			typename Line<T,N> GetUnit() const { return Scale( T(1)/GetLength() ); }
-			typename Point<T,N> GetMidPoint() const {
-				Point<T,N> mid;
+			Line<T,space> GetUnit() const { return Scale( T(1)/GetLength() ); }
+			Point<T,space> GetMidPoint() const {
+				Point<T,space> mid;
 				for(uint32_t i=0;i<space;i++) mid[i] = (start[i] + terminal[i])/T(2);
 				return mid;
 			}
 
-			typename Point<T,space> & GetStart() { return start; }
-			typename const Point<T,space> & GetStart() const { return start; }
-			typename Point<T,space> & GetTerminal() { return terminal; }
-			typename const Point<T,space> & GetTerminal() const { return terminal; }
+			Point<T,space> & GetStart() { return start; }
+			const Point<T,space> & GetStart() const { return start; }
+			Point<T,space> & GetTerminal() { return terminal; }
+			const Point<T,space> & GetTerminal() const { return terminal; }
 		protected:
 			Point<T,space> start, terminal;
 		};
@@ -108,8 +118,8 @@ namespace Math {
 			virtual Vector::Template<T,space> GetNormal() const=0;
 			virtual Point<T,N> GetMidPoint() const =0;
 
-			typename Line<T,space> & operator [] (uint32_t i) { return lines; }
-			typename const Line<T,space> & operator [] const (uint32_t i) { return lines; }
+			Line<T,space> & operator [] (uint32_t i) { return lines[i]; }
+			const Line<T,space> & operator [] (uint32_t i) const { return lines[i]; }
 		private:
 			Line<T,space> lines[N];
 		};
@@ -0,0 +1,50 @@
+#pragma once
+
+#ifndef MATH_PARALLEL
+#define MATH_PARALLEL
+
+#include <Math/Prefix.h>
+
+#include <functional>
+#include <vector>
+
+namespace Math {
+	namespace Parallel {
+
+		// replaces the shared pool, 0 threads picks the hardware concurrency, the calling thread counts as one of them //
+		// affinity pins worker i to logical core i, call it before any parallel work is in flight //
+		API void Configure(unsigned threads =0, bool affinity =false);
+		API unsigned Threads();
+
+		// with deterministic mode on, ranges are cut into chunks of exactly grain elements whatever the thread count //
+		// so Reduce combines the same partial results in the same order and is bitwise reproducible //
+		API void SetDeterministic(bool deterministic);
+		API bool IsDeterministic();
+
+		// chunk length For and Reduce use for a range of count elements //
+		API size_t Chunk(size_t count, size_t grain);
+
+		// runs body(begin,end) over consecutive chunks of chunk elements covering [first,last) //
+		// idle workers steal chunks, the caller works until every chunk is done, the first exception thrown is rethrown //
+		API void ForChunks(size_t first, size_t last, size_t chunk, const std::function<void(size_t,size_t)> & body);
+
+		inline void For(size_t first, size_t last, size_t grain, const std::function<void(size_t,size_t)> & body) {
+			if( last > first ) ForChunks(first, last, Chunk(last-first, grain), body);
+		}
+
+		// body(begin,end) returns the partial result of a chunk, partials are combined in chunk order //
+		template<typename T, typename Body, typename Combine>
+		T Reduce(size_t first, size_t last, size_t grain, T const & identity, Body body, Combine combine) {
+			if( last <= first ) return identity;
+			const size_t chunk = Chunk(last-first, grain);
+			std::vector<T> partial((last-first+chunk-1)/chunk, identity);
+			ForChunks(first, last, chunk, [&](size_t begin, size_t end) { partial[(begin-first)/chunk] = body(begin,end); });
+
+			T result = identity;
+			for(const auto & value : partial) result = combine(result, value);
+			return result;
+		}
+	}
+}
+
+#endif // ending MATH_PARALLEL //
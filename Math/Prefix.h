@@ -5,9 +5,12 @@
 
 #include <OS/Prefix.h>
 #include <iostream>
+#include <new>
+#include <memory>
 
 BEGIN_C
 # include <stdint.h>
+# include <stdlib.h>
 # include <math.h>
 END_C
 
@@ -18,60 +21,259 @@ END_C
 # define TAYLOR_LIMIT 25
 #endif
 
+// true while a constexpr function is being evaluated by the compiler, so it can skip SIMD and libm paths //
+#if !defined(MATH_CONSTANT_EVALUATED) and defined(__has_builtin)
+# if __has_builtin(__builtin_is_constant_evaluated)
+#  define MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# endif
+#endif
+
+#if !defined(MATH_CONSTANT_EVALUATED) and ((defined(__GNUC__) and __GNUC__ >= 9) or (defined(_MSC_VER) and _MSC_VER >= 1925))
+# define MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+// without the builtin there is no telling, so every caller takes its run time path: the SIMD, libm and Pascal table code //
+// is not constexpr, and Choose up to PascalRows, Sin, Cos and the Vector operators are then not usable in constant //
+// expressions, MATH_NO_CONSTANT_EVALUATED says so. Defining MATH_CONSTANT_EVALUATED() as true on the command line //
+// opts into the constexpr paths everywhere instead, at the cost of the scalar loops and Taylor sums at run time //
+#ifndef MATH_CONSTANT_EVALUATED
+# define MATH_CONSTANT_EVALUATED() false
+# define MATH_NO_CONSTANT_EVALUATED
+#endif
+
 namespace Math {
 
-	API uint64_t Factorial(uint64_t);
-	API uint64_t Choose(uint32_t, uint32_t);
-	API uint64_t Fibonacci(uint32_t);
+	enum class Status {
+		Success,
+		Singular,
+		Overflow
+	};
 
-	template<typename T>
-	T Infinity() { return std::numeric_limits<T>::infinity; }
+	constexpr uint64_t Factorial(uint64_t n) {
+		uint64_t factorial = 1;
+		while(n>0) factorial *= n--;
+		return factorial;
+	}
 
 	template<typename T>
-	bool IsSigned() {
-		if( std::is_same<T,int>::value ) return true;
-		if( std::is_same<T,char>::value ) return true;
-		if( std::is_same<T,short>::value ) return true;
-		if( std::is_same<T,long>::value ) return true;
-		if( std::is_same<T,long long>::value ) return true;
-		return false;
+	constexpr T Gcd(T a, T b) {
+		while( b != 0 ){
+			const T r = a % b;
+			a = b, b = r;
+		}
+		return a;
 	}
 
-	template<typename T>
-	bool IsFloatingPoint() {
-		if( std::is_same<T,float>::value ) return true;
-		if( std::is_same<T,double>::value ) return true;
-		if( std::is_same<T,long double>::value ) return true;
-		return false;
+	// rows of Pascal's triangle up to this n fit in uint64_t, C(68,34) is the first coefficient that does not //
+	const uint32_t PascalRows = 67;
+
+	// half rows of Pascal's triangle for n <= PascalRows built on first use, C(n,p) with p <= n/2 is PascalTable()[PascalIndex(n,p)] //
+	API const uint64_t * PascalTable();
+
+	constexpr size_t PascalIndex(uint32_t n, uint32_t p) { return size_t(n/2+1)*(n/2) + (n%2 ? n/2+1 : 0) + p; }
+
+	namespace Kernel {
+		// r = r*m/k where the product is known to be whole, widened to 128 bits or reduced by the gcd so it cannot wrap //
+		constexpr bool ChooseStep(uint64_t & r, uint64_t m, uint64_t k) {
+#ifdef __SIZEOF_INT128__
+			const unsigned __int128 x = static_cast<unsigned __int128>(r)*m/k;
+			if( x >> 64 ) return false;
+			r = static_cast<uint64_t>(x);
+			return true;
+#endif
+			const uint64_t g = Gcd(r,k);
+			const uint64_t t = m/(k/g);
+			r /= g;
+			if( t != 0 and r > ~uint64_t(0)/t ) return false;
+			r *= t;
+			return true;
+		}
 	}
 
+	// O(min(p,n-p)) multiplicative binomial coefficient, the arguments are swapped when n < p //
+	// small rows are read from the cached Pascal table at run time, results past uint64_t give 0 and Status::Overflow //
+	constexpr uint64_t Choose(uint32_t n, uint32_t p, Status * status =nullptr) {
+		if(n < p) return Choose(p,n,status); // to save it from returning a zero in the future //
+		if( status ) *status = Status::Success;
+		const uint32_t k = p < n-p ? p : n-p;
+		if( n <= PascalRows and !MATH_CONSTANT_EVALUATED() ) return PascalTable()[PascalIndex(n,k)];
+
+		uint64_t r = 1;
+		for(uint32_t i=1;i<=k;i++){
+			if( !Kernel::ChooseStep(r, n-k+i, i) ){
+				if( status ) *status = Status::Overflow;
+				return 0;
+			}
+		}
+		return r;
+	}
+
+	// out[k] = C(n,k) for k in [0,n], out holds n+1 values, overflowed entries are 0 //
+	API Status ChooseRow(uint32_t n, uint64_t * out);
+
+	// out[k-first] = C(n,k) for k in [first,last), last is clamped to n+1 //
+	API Status ChooseRange(uint32_t n, uint32_t first, uint32_t last, uint64_t * out);
+
+	// F(93) is the last Fibonacci number that fits in uint64_t //
+	const uint32_t FibonacciLimit = 93;
+
+	namespace Kernel {
+		// (F(n), F(n+1)) by fast doubling, exact modulo 2^64 since it only adds, subtracts and multiplies //
+		constexpr void FibonacciPair(uint32_t n, uint64_t & f, uint64_t & g) {
+			uint64_t a = 0, b = 1;
+			for(int bit=31;bit>=0;bit--){
+				const uint64_t c = a*(2*b - a), d = a*a + b*b;
+				if( (n >> bit) & 1 ) a = d, b = c + d;
+				else a = c, b = d;
+			}
+			f = a, g = b;
+		}
+	}
+
+	// F(0) = 0, F(1) = F(2) = 1 in O(log n), past FibonacciLimit the result is 0 with Status::Overflow //
+	constexpr uint64_t FibonacciNumber(uint32_t n, Status * status =nullptr) {
+		if( status ) *status = n > FibonacciLimit ? Status::Overflow : Status::Success;
+		if( n > FibonacciLimit ) return 0;
+		uint64_t f = 0, g = 0;
+		Kernel::FibonacciPair(n, f, g);
+		return f;
+	}
+
+	// the original index, one ahead of FibonacciNumber: 0 for n = 0 and F(n+1) after that, so 1, 2, 3, 5, 8 from n = 1 //
+	// kept for existing callers, past FibonacciLimit-1 the result is 0 with Status::Overflow //
+	constexpr uint64_t Fibonacci(uint32_t n, Status * status =nullptr) {
+		if( n == 0 ){
+			if( status ) *status = Status::Success;
+			return 0;
+		}
+		return FibonacciNumber(n < FibonacciLimit ? n+1 : FibonacciLimit+1, status);
+	}
 
+	// out[i-first] = FibonacciNumber(i) for i in [first,last), seeded by fast doubling and extended by additions //
+	API Status FibonacciRange(uint32_t first, uint32_t last, uint64_t * out);
 
+	// floating point type wide enough to carry intermediate results for T //
 	template<typename T>
-	T Epsilon() {
-		if(std::is_same<T,float>::value) return 1.0e-15f;
-		if(std::is_same<T,double>::value) return 1.0e-15;
-		if(std::is_same<T,long double>::value) return 1.0e-15;
-		else return 0;
+	struct Real { typedef typename std::conditional<std::is_floating_point<T>::value, T, double>::type Type; };
+
+	// heap block of count T aligned to alignment bytes, the raw pointer is kept just below the block //
+	template<typename T>
+	T * AlignedAlloc(size_t count, size_t alignment =64) {
+		if( count == 0 ) return nullptr;
+		void * raw = malloc(count*sizeof(T) + alignment + sizeof(void *));
+		if( !raw ) throw std::bad_alloc();
+		uintptr_t base = reinterpret_cast<uintptr_t>(raw) + sizeof(void *);
+		void ** block = reinterpret_cast<void **>( (base + alignment - 1) & ~uintptr_t(alignment - 1) );
+		block[-1] = raw;
+		return reinterpret_cast<T *>(block);
 	}
 
 	template<typename T>
-	T Pi() {
-		if(std::is_same<T,float>::value) return 3.14159265358979323846f;
-		if(std::is_same<T,double>::value) return 3.14159265358979323846;
-		else return 3;
+	void AlignedFree(T * p) { if( p ) free( reinterpret_cast<void **>(p)[-1] ); }
+
+	template<typename T>
+	T Infinity() { return std::numeric_limits<T>::infinity; }
+
+	template<typename T>
+	constexpr bool IsSigned() { return std::is_signed<T>::value; }
+
+	template<typename T>
+	constexpr bool IsFloatingPoint() { return std::is_floating_point<T>::value; }
+
+	// how scalar results are finished, picked at compile time so hot paths carry neither the rounding nor a type test //
+	// Snapped rounds results within Epsilon of a whole number or zero and compares floats within Epsilon, as this library always has //
+	// Exact hands back what libm and the arithmetic produced, Fast is Exact that may also trade the last bits for speed //
+	namespace Policy {
+		struct Exact {};
+		struct Snapped {};
+		struct Fast {};
+
+#ifndef MATH_POLICY
+# define MATH_POLICY Snapped
+#endif
+		// the policy every function and container uses unless it is given one, build with -DMATH_POLICY=Exact to change it //
+		typedef MATH_POLICY Default;
 	}
 
 	template<typename T>
-	T Pow(T const & x, T const & p) {
-		if( std::is_same<float,T>::value ) return std::powf(x,p);
-		if( std::is_same<double,T>::value ) return std::pow(x,p);
-		if( std::is_same<long double,T>::value ) return std::powl(x,p);
-		T X = T(1);
-		for(int i=0;i<p;i++) X *= x;
-		return X;
+	constexpr T Epsilon() { return std::is_floating_point<T>::value ? T(1.0e-15L) : T(0); }
+
+	template<typename T>
+	constexpr T Pi() { return T(3.14159265358979323846264338327950288L); }
+
+	namespace Kernel {
+		// libm entry points for T, integral types go through double //
+		template<typename T>
+		struct Libm {
+			static T Sin(T x) { return static_cast<T>(::sin(double(x))); }
+			static T Cos(T x) { return static_cast<T>(::cos(double(x))); }
+			static T ArcSin(T x) { return static_cast<T>(::asin(double(x))); }
+			static T ArcCos(T x) { return static_cast<T>(::acos(double(x))); }
+			static T ArcTan(T x) { return static_cast<T>(::atan(double(x))); }
+			static T Log(T x) { return static_cast<T>(::log(double(x))); }
+			static T Pow(T x, T p) {
+				T X = T(1);
+				for(T i=T(0);i<p;i++) X *= x;
+				return X;
+			}
+		};
+
+		template<>
+		struct Libm<float> {
+			static float Sin(float x) { return sinf(x); }
+			static float Cos(float x) { return cosf(x); }
+			static float ArcSin(float x) { return asinf(x); }
+			static float ArcCos(float x) { return acosf(x); }
+			static float ArcTan(float x) { return atanf(x); }
+			static float Log(float x) { return logf(x); }
+			static float Pow(float x, float p) { return powf(x,p); }
+		};
+
+		template<>
+		struct Libm<double> {
+			static double Sin(double x) { return ::sin(x); }
+			static double Cos(double x) { return ::cos(x); }
+			static double ArcSin(double x) { return ::asin(x); }
+			static double ArcCos(double x) { return ::acos(x); }
+			static double ArcTan(double x) { return ::atan(x); }
+			static double Log(double x) { return ::log(x); }
+			static double Pow(double x, double p) { return ::pow(x,p); }
+		};
+
+		template<>
+		struct Libm<long double> {
+			static long double Sin(long double x) { return sinl(x); }
+			static long double Cos(long double x) { return cosl(x); }
+			static long double ArcSin(long double x) { return asinl(x); }
+			static long double ArcCos(long double x) { return acosl(x); }
+			static long double ArcTan(long double x) { return atanl(x); }
+			static long double Log(long double x) { return logl(x); }
+			static long double Pow(long double x, long double p) { return powl(x,p); }
+		};
+
+		// the libm T is evaluated with under policy P, Fast takes long double through the double routines //
+		template<typename T, typename P>
+		struct Evaluate {
+			typedef Libm<T> Type;
+		};
+
+		template<>
+		struct Evaluate<long double,Policy::Fast> {
+			struct Type {
+				static long double Sin(long double x) { return ::sin(double(x)); }
+				static long double Cos(long double x) { return ::cos(double(x)); }
+				static long double ArcSin(long double x) { return ::asin(double(x)); }
+				static long double ArcCos(long double x) { return ::acos(double(x)); }
+				static long double ArcTan(long double x) { return ::atan(double(x)); }
+				static long double Log(long double x) { return ::log(double(x)); }
+				static long double Pow(long double x, long double p) { return ::pow(double(x),double(p)); }
+			};
+		};
 	}
 
+	template<typename T, typename P =Policy::Default>
+	T Pow(T const & x, T const & p) { return Kernel::Evaluate<T,P>::Type::Pow(x,p); }
+
 	template<typename T>
 	T DoubleFactorial(T const & n) {
 		if( IsFloatingPoint<T>() ) throw std::exception("Floating point values generally are not able to become factorials");
@@ -80,115 +282,193 @@ namespace Math {
 		return factorial;
 	}
 
+	template<typename T>
+	constexpr T E() { return T(2.71828182845904523536028747135266250L); }
+
+	// e^x, Euler() is the constant itself //
 	template<typename T>
 	T Euler(T const & x =T(1)) {
-		T e = T(0);
-		for(int i=0;i<TAYLOR_LIMIT;i++) e += Pow<T>(x,i)/Factorial(i);
-		return e;
+		if( x == T(1) ) return E<T>();
+		return static_cast<T>(std::exp(static_cast<typename Real<T>::Type>(x)));
 	}
 
 	template<typename T>
-	T Abs(const T & a) { return a<0 ? -a : a; }
+	constexpr T Abs(const T & a) { return a<0 ? -a : a; }
 
 	template<typename T>
-	T Max(const T & a, const T & b) { return a > b ? a : b; }
+	constexpr T Max(const T & a, const T & b) { return a > b ? a : b; }
 
 	template<typename T>
-	T Min(const T & a, const T & b) { return a < b ? a : b; }
+	constexpr T Min(const T & a, const T & b) { return a < b ? a : b; }
+
+	namespace Kernel {
+		template<typename T, bool floating =std::is_floating_point<T>::value>
+		struct Correct { static constexpr T Apply(T & r) { return r; } };
+
+		// std::floor for constant evaluation, values past long long are whole already and NaN passes through //
+		template<typename T>
+		constexpr T Floor(T const & x) {
+			if( !(x > T(-9.2e18) and x < T(9.2e18)) ) return x;
+			const T t = static_cast<T>(static_cast<long long>(x));
+			return t > x ? t - T(1) : t;
+		}
 
-	template<typename T>
-	bool Equals(const T & a, const T & b) {
-		if( std::is_same<T,float>::value ) return Abs<T>(a-b) <= Epsilon<T>();
-		else return a == b;
+		template<typename T>
+		struct Correct<T,true> {
+			static constexpr T Apply(T & r) {
+				const T floor = MATH_CONSTANT_EVALUATED() ? Floor(r) : std::floor(r);
+				const T ceil = MATH_CONSTANT_EVALUATED() ? -Floor(-r) : std::ceil(r);
+				if( Abs(r - floor) <= Epsilon<T>() )
+					r = floor;
+				else if( Abs(r - ceil) <= Epsilon<T>() )
+					r = ceil;
+				if( Abs(r) <= Epsilon<T>() ) r = T(0);
+				return r;
+			}
+		};
+
+		// what a policy does to a finished result and how it compares two values //
+		template<typename P>
+		struct Finish {
+			// whether Apply can change a result, kernels that finish in a separate pass skip it when it cannot //
+			enum { snaps = false };
+
+			template<typename T>
+			static constexpr T Apply(T & r) { return r; }
+
+			template<typename T>
+			static constexpr bool Equals(const T & a, const T & b) { return a == b; }
+		};
+
+		template<>
+		struct Finish<Policy::Snapped> {
+			enum { snaps = true };
+
+			template<typename T>
+			static constexpr T Apply(T & r) { return Correct<T>::Apply(r); }
+
+			template<typename T>
+			static constexpr bool Equals(const T & a, const T & b) { return std::is_same<T,float>::value ? Abs<T>(a-b) <= Epsilon<T>() : a == b; }
+		};
 	}
 
+	template<typename T, typename P =Policy::Default>
+	constexpr bool Equals(const T & a, const T & b) { return Kernel::Finish<P>::Equals(a,b); }
+
+	// snaps floating point values within Epsilon of a whole number or zero onto it, whatever the policy //
 	template<typename T>
-	T AutoCorrect(T & r) {
-		if( IsFloatingPoint<T>() ){
-			if( Abs(r - std::floor(r)) <= Epsilon<T>() )
-				r = std::floor(r);
-			else if( Abs(r - std::ceil(r)) <= Epsilon<T>() )
-				r = std::ceil(r);
-		}
+	T AutoCorrect(T & r) { return Kernel::Correct<T>::Apply(r); }
 
-		if( ( Abs(r - T(0)) <= Epsilon<T>() ) and (IsSigned<T>() or IsFloatingPoint<T>()) ) r = T(0);
-		return r;
+	// r as policy P finishes it, AutoCorrect under Snapped and untouched otherwise //
+	template<typename P, typename T>
+	constexpr T Snap(T & r) { return Kernel::Finish<P>::Apply(r); }
+
+	// natural log, and log of x in base b //
+	template<typename T, typename P =Policy::Default>
+	T Log(T const & x) {
+		T r = Kernel::Evaluate<T,P>::Type::Log(x);
+		return Snap<P>(r);
 	}
 
-	template<typename T>
-	T Log(T const & x, T const & b=Euler<T>()){ return AutoCorrect(log(x))/AutoCorrect(log(b)); }
+	template<typename T, typename P =Policy::Default>
+	T Log(T const & x, T const & b) {
+		typedef typename Kernel::Evaluate<typename Real<T>::Type,P>::Type Libm;
+		T r = static_cast<T>(Libm::Log(x)), base = static_cast<T>(Libm::Log(b));
+		return Snap<P>(r)/Snap<P>(base);
+	}
 
-	template<typename T>
-	T DegsToRads(T degs) { return AutoCorrect(degs*Math::Pi<T>()/T(180)); }
+	// Fast folds the degree to radian ratio into one multiply //
+	template<typename T, typename P =Policy::Default>
+	T DegsToRads(T degs) {
+		T r = std::is_same<P,Policy::Fast>::value ? degs*(Math::Pi<T>()/T(180)) : degs*Math::Pi<T>()/T(180);
+		return Snap<P>(r);
+	}
 
-	template<typename T>
-	T RadsToDegs(T rads) { return AutoCorrect(rads*T(180)/Math::Pi<T>()); }
+	template<typename T, typename P =Policy::Default>
+	T RadsToDegs(T rads) {
+		T r = std::is_same<P,Policy::Fast>::value ? rads*(T(180)/Math::Pi<T>()) : rads*T(180)/Math::Pi<T>();
+		return Snap<P>(r);
+	}
 
-	template<typename T>
-	T Sin(T const & angle) {
-		T c;
-		if( std::is_same<T,float>::value ) c = sinf(angle);
-		if( std::is_same<T,double>::value ) c = sin(angle);
-		if( std::is_same<T,long double>::value ) c = sinl(angle);
-		else c = static_cast<T>(sin(angle));
-		AutoCorrect(c);
-		return c;
+	namespace Constant {
+
+		// reduces x to [-pi,pi] and sums TAYLOR_LIMIT terms in long double, for tables and transforms built at compile time //
+		constexpr long double Reduce(long double x) {
+			const long double tau = 2*Pi<long double>();
+			const long double k = x/tau;
+			return x - tau*static_cast<long double>(static_cast<long long>(k < 0 ? k - 0.5L : k + 0.5L));
+		}
+
+		template<typename T>
+		constexpr T Sin(T const & angle) {
+			const long double x = Reduce(static_cast<long double>(angle));
+			long double term = x, sum = x;
+			for(int i=1;i<TAYLOR_LIMIT;i++){
+				term *= -x*x/((2*i)*(2*i+1));
+				sum += term;
+			}
+			return static_cast<T>(sum);
+		}
+
+		template<typename T>
+		constexpr T Cos(T const & angle) {
+			const long double x = Reduce(static_cast<long double>(angle));
+			long double term = 1, sum = 1;
+			for(int i=1;i<TAYLOR_LIMIT;i++){
+				term *= -x*x/((2*i-1)*(2*i));
+				sum += term;
+			}
+			return static_cast<T>(sum);
+		}
 	}
 
-	template<typename T>
-	T Csc(T const & angle) { return T(1)/Sin(angle); }
+	template<typename T, typename P =Policy::Default>
+	constexpr T Sin(T const & angle) {
+		T c = MATH_CONSTANT_EVALUATED() ? Constant::Sin(angle) : Kernel::Evaluate<T,P>::Type::Sin(angle);
+		return Snap<P>(c);
+	}
 
-	template<typename T>
-	T Cos(T const & angle) {
-		T c;
-		if( std::is_same<T,float>::value ) c = cosf(angle);
-		if( std::is_same<T,double>::value ) c = cos(angle);
-		if( std::is_same<T,long double>::value ) c = cosl(angle);
-		else c = static_cast<T>(cos(angle));
-		AutoCorrect(c);
-		return c;
+	template<typename T, typename P =Policy::Default>
+	T Csc(T const & angle) { return T(1)/Sin<T,P>(angle); }
+
+	template<typename T, typename P =Policy::Default>
+	constexpr T Cos(T const & angle) {
+		T c = MATH_CONSTANT_EVALUATED() ? Constant::Cos(angle) : Kernel::Evaluate<T,P>::Type::Cos(angle);
+		return Snap<P>(c);
 	}
 
-	template<typename T>
-	T Sec(T const & angle) { return T(1)/Cos(angle); }
+	// both from one argument reduction, compilers merge the pair of libm calls into a single sincos //
+	template<typename T, typename P =Policy::Default>
+	constexpr void SinCos(T const & angle, T & sine, T & cosine) {
+		sine = Sin<T,P>(angle);
+		cosine = Cos<T,P>(angle);
+	}
 
-	template<typename T>
-	T Tan(T const & angle) { return Sin(angle)/Cos(angle); }
+	template<typename T, typename P =Policy::Default>
+	T Sec(T const & angle) { return T(1)/Cos<T,P>(angle); }
 
-	template<typename T>
-	T Cot(T const & angle) { return T(1)/Tan(angle); }
+	template<typename T, typename P =Policy::Default>
+	T Tan(T const & angle) { return Sin<T,P>(angle)/Cos<T,P>(angle); }
 
-	template<typename T>
+	template<typename T, typename P =Policy::Default>
+	T Cot(T const & angle) { return T(1)/Tan<T,P>(angle); }
+
+	template<typename T, typename P =Policy::Default>
 	T ArcSin(T const & y) {
-		T c;
-		if( std::is_same<T,float>::value ) c = asinf(y);
-		if( std::is_same<T,double>::value ) c = asin(y);
-		if( std::is_same<T,long double>::value ) c = asinl(y);
-		else c = static_cast<T>( asin(y));
-		AutoCorrect(c);
-		return c;
+		T c = Kernel::Evaluate<T,P>::Type::ArcSin(y);
+		return Snap<P>(c);
 	}
 
-	template<typename T>
+	template<typename T, typename P =Policy::Default>
 	T ArcCos(T const & y) {
-		T c;
-		if( std::is_same<T,float>::value ) c = acosf(y);
-		if( std::is_same<T,double>::value ) c = acos(y);
-		if( std::is_same<T,long double>::value ) c = acosl(y);
-		else c = static_cast<T>( acos(y));
-		AutoCorrect(c);
-		return c;
+		T c = Kernel::Evaluate<T,P>::Type::ArcCos(y);
+		return Snap<P>(c);
 	}
 
-	template<typename T>
+	template<typename T, typename P =Policy::Default>
 	T ArcTan(T const & y) {
-		T c;
-		if( std::is_same<T,float>::value ) c = atanf(y);
-		if( std::is_same<T,double>::value ) c = atan(y);
-		if( std::is_same<T,long double>::value ) c = atanl(y);
-		else c = static_cast<T>( atanf(y));
-		AutoCorrect(c);
-		return c;
+		T c = Kernel::Evaluate<T,P>::Type::ArcTan(y);
+		return Snap<P>(c);
 	}
 }
 
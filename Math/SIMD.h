@@ -0,0 +1,529 @@
+#pragma once
+
+#ifndef MATH_SIMD
+#define MATH_SIMD
+
+#include <Math/Prefix.h>
+
+#if defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+# define MATH_SIMD_SSE
+# include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+# define MATH_SIMD_AVX
+# include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+# define MATH_SIMD_AVX2
+#endif
+
+#if defined(__FMA__) or (defined(_MSC_VER) and defined(__AVX2__))
+# define MATH_SIMD_FMA
+#endif
+
+#ifdef MATH_SIMD_AVX
+# define MATH_SIMD_BYTES 32
+#else
+# define MATH_SIMD_BYTES 16
+#endif
+
+namespace Math {
+	namespace Simd {
+
+		// number of T lanes in one native vector register //
+		template<typename T>
+		struct Width { enum { value = sizeof(T) >= MATH_SIMD_BYTES ? 1 : MATH_SIMD_BYTES/sizeof(T) }; };
+
+		// fixed width group of lanes, plain loops unless an intrinsic specialization below exists for T and L //
+		template<typename T, int L =Width<T>::value>
+		class Pack {
+		public:
+			Pack() {}
+			Pack(T const & x) { for(int i=0;i<L;i++) v[i] = x; }
+
+			static Pack Load(const T * p) {
+				Pack r;
+				for(int i=0;i<L;i++) r.v[i] = p[i];
+				return r;
+			}
+
+			void Store(T * p) const { for(int i=0;i<L;i++) p[i] = v[i]; }
+
+			static int Lanes() { return L; }
+
+			T & operator [] (int i) { return v[i]; }
+			const T & operator [] (int i) const { return v[i]; }
+
+			Pack & operator += (const Pack & u) { for(int i=0;i<L;i++) v[i] += u.v[i]; return *this; }
+			Pack & operator -= (const Pack & u) { for(int i=0;i<L;i++) v[i] -= u.v[i]; return *this; }
+			Pack & operator *= (const Pack & u) { for(int i=0;i<L;i++) v[i] *= u.v[i]; return *this; }
+			Pack & operator /= (const Pack & u) { for(int i=0;i<L;i++) v[i] /= u.v[i]; return *this; }
+
+			Pack operator + (const Pack & u) const { Pack r = *this; return r += u; }
+			Pack operator - (const Pack & u) const { Pack r = *this; return r -= u; }
+			Pack operator * (const Pack & u) const { Pack r = *this; return r *= u; }
+			Pack operator / (const Pack & u) const { Pack r = *this; return r /= u; }
+			Pack operator - () const { Pack r; for(int i=0;i<L;i++) r.v[i] = -v[i]; return r; }
+
+		protected:
+			alignas((L & (L-1)) ? alignof(T) : sizeof(T)*L <= 64 ? sizeof(T)*L : 64) T v[L];
+		};
+
+		// a*b + c, fused where the target has it //
+		template<typename T, int L>
+		Pack<T,L> MultiplyAdd(const Pack<T,L> & a, const Pack<T,L> & b, const Pack<T,L> & c) { return a*b + c; }
+
+		// horizontal sum of every lane //
+		template<typename T, int L>
+		T Sum(const Pack<T,L> & a) {
+			T sum = a[0];
+			for(int i=1;i<L;i++) sum += a[i];
+			return sum;
+		}
+
+		// lane wise square root and maximum //
+		template<typename T, int L>
+		Pack<T,L> Sqrt(const Pack<T,L> & a) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = std::sqrt(a[i]);
+			return r;
+		}
+
+		template<typename T, int L>
+		Pack<T,L> Max(const Pack<T,L> & a, const Pack<T,L> & b) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = a[i] > b[i] ? a[i] : b[i];
+			return r;
+		}
+
+		template<typename T, int L>
+		Pack<T,L> Min(const Pack<T,L> & a, const Pack<T,L> & b) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = a[i] < b[i] ? a[i] : b[i];
+			return r;
+		}
+
+		template<typename T, int L>
+		Pack<T,L> Abs(const Pack<T,L> & a) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = std::abs(a[i]);
+			return r;
+		}
+
+		// nearest whole number with ties to even, valid for |a| < 2^31 //
+		template<typename T, int L>
+		Pack<T,L> Round(const Pack<T,L> & a) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = std::nearbyint(a[i]);
+			return r;
+		}
+
+		// 2^n for whole n inside the normal exponent range of T, built straight into the exponent bits //
+		template<typename T, int L>
+		Pack<T,L> Power2(const Pack<T,L> & n) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = std::ldexp(T(1), int(n[i]));
+			return r;
+		}
+
+		// a = m*2^e with m in [0.5,1) for positive normal a, other lanes are unspecified //
+		template<typename T, int L>
+		Pack<T,L> Mantissa(const Pack<T,L> & a, Pack<T,L> & e) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++){
+				int exponent = 0;
+				r[i] = std::frexp(a[i], &exponent);
+				e[i] = T(exponent);
+			}
+			return r;
+		}
+
+		// masks from Less and Outside are only meaningful to Select and Any //
+		template<typename T, int L>
+		Pack<T,L> Less(const Pack<T,L> & a, const Pack<T,L> & b) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = a[i] < b[i] ? T(1) : T(0);
+			return r;
+		}
+
+		// lanes where a is not inside [lo,hi], NaN included //
+		template<typename T, int L>
+		Pack<T,L> Outside(const Pack<T,L> & a, const Pack<T,L> & lo, const Pack<T,L> & hi) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = a[i] >= lo[i] and a[i] <= hi[i] ? T(0) : T(1);
+			return r;
+		}
+
+		// a where the mask is set, b elsewhere //
+		template<typename T, int L>
+		Pack<T,L> Select(const Pack<T,L> & mask, const Pack<T,L> & a, const Pack<T,L> & b) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = mask[i] != T(0) ? a[i] : b[i];
+			return r;
+		}
+
+		template<typename T, int L>
+		bool Any(const Pack<T,L> & mask) {
+			for(int i=0;i<L;i++) if( mask[i] != T(0) ) return true;
+			return false;
+		}
+
+		// lane i is base[index[i]] //
+		template<typename T, int L>
+		Pack<T,L> Gather(const T * base, const int * index) {
+			Pack<T,L> r;
+			for(int i=0;i<L;i++) r[i] = base[index[i]];
+			return r;
+		}
+
+		// the even and odd entries of the 2L values from p on, the real and imaginary parts of interleaved complex values //
+		template<typename T, int L>
+		void Deinterleave(const T * p, Pack<T,L> & even, Pack<T,L> & odd) {
+			for(int i=0;i<L;i++) even[i] = p[2*i], odd[i] = p[2*i+1];
+		}
+
+		// writes the 2L values Deinterleave would read back as even and odd //
+		template<typename T, int L>
+		void Interleave(T * p, const Pack<T,L> & even, const Pack<T,L> & odd) {
+			for(int i=0;i<L;i++) p[2*i] = even[i], p[2*i+1] = odd[i];
+		}
+
+#define MATH_SIMD_PACK(T,L,R,SET1,LOAD,STORE,ADD,SUB,MUL,DIV,XOR) \
+		template<> \
+		class Pack<T,L> { \
+		public: \
+			Pack() {} \
+			Pack(T const & x) { u.r = SET1(x); } \
+			Pack(R const & r) { u.r = r; } \
+			static Pack Load(const T * p) { return Pack(LOAD(p)); } \
+			void Store(T * p) const { STORE(p, u.r); } \
+			static int Lanes() { return L; } \
+			R Register() const { return u.r; } \
+			T & operator [] (int i) { return u.v[i]; } \
+			const T & operator [] (int i) const { return u.v[i]; } \
+			Pack & operator += (const Pack & p) { u.r = ADD(u.r,p.u.r); return *this; } \
+			Pack & operator -= (const Pack & p) { u.r = SUB(u.r,p.u.r); return *this; } \
+			Pack & operator *= (const Pack & p) { u.r = MUL(u.r,p.u.r); return *this; } \
+			Pack & operator /= (const Pack & p) { u.r = DIV(u.r,p.u.r); return *this; } \
+			Pack operator + (const Pack & p) const { return Pack(ADD(u.r,p.u.r)); } \
+			Pack operator - (const Pack & p) const { return Pack(SUB(u.r,p.u.r)); } \
+			Pack operator * (const Pack & p) const { return Pack(MUL(u.r,p.u.r)); } \
+			Pack operator / (const Pack & p) const { return Pack(DIV(u.r,p.u.r)); } \
+			Pack operator - () const { return Pack(XOR(u.r,SET1(T(-0.0)))); } \
+		protected: \
+			union { R r; T v[L]; } u; \
+		}
+
+#ifdef MATH_SIMD_SSE
+		MATH_SIMD_PACK(float,4,__m128,_mm_set1_ps,_mm_loadu_ps,_mm_storeu_ps,_mm_add_ps,_mm_sub_ps,_mm_mul_ps,_mm_div_ps,_mm_xor_ps);
+		MATH_SIMD_PACK(double,2,__m128d,_mm_set1_pd,_mm_loadu_pd,_mm_storeu_pd,_mm_add_pd,_mm_sub_pd,_mm_mul_pd,_mm_div_pd,_mm_xor_pd);
+#endif
+
+#ifdef MATH_SIMD_AVX
+		MATH_SIMD_PACK(float,8,__m256,_mm256_set1_ps,_mm256_loadu_ps,_mm256_storeu_ps,_mm256_add_ps,_mm256_sub_ps,_mm256_mul_ps,_mm256_div_ps,_mm256_xor_ps);
+		MATH_SIMD_PACK(double,4,__m256d,_mm256_set1_pd,_mm256_loadu_pd,_mm256_storeu_pd,_mm256_add_pd,_mm256_sub_pd,_mm256_mul_pd,_mm256_div_pd,_mm256_xor_pd);
+#endif
+
+#undef MATH_SIMD_PACK
+
+#ifdef MATH_SIMD_SSE
+		template<>
+		inline float Sum(const Pack<float,4> & a) {
+			__m128 r = a.Register();
+			r = _mm_add_ps(r, _mm_movehl_ps(r,r));
+			return _mm_cvtss_f32(_mm_add_ss(r, _mm_shuffle_ps(r,r,1)));
+		}
+
+		template<>
+		inline double Sum(const Pack<double,2> & a) {
+			__m128d r = a.Register();
+			return _mm_cvtsd_f64(_mm_add_sd(r, _mm_unpackhi_pd(r,r)));
+		}
+#endif
+
+#ifdef MATH_SIMD_AVX
+		template<>
+		inline float Sum(const Pack<float,8> & a) { return Sum(Pack<float,4>(_mm_add_ps(_mm256_castps256_ps128(a.Register()), _mm256_extractf128_ps(a.Register(),1)))); }
+
+		template<>
+		inline double Sum(const Pack<double,4> & a) { return Sum(Pack<double,2>(_mm_add_pd(_mm256_castpd256_pd128(a.Register()), _mm256_extractf128_pd(a.Register(),1)))); }
+#endif
+
+#define MATH_SIMD_UNARY(NAME,T,L,OP) \
+		template<> \
+		inline Pack<T,L> NAME(const Pack<T,L> & a) { return OP(a.Register()); }
+
+#define MATH_SIMD_BINARY(NAME,T,L,OP) \
+		template<> \
+		inline Pack<T,L> NAME(const Pack<T,L> & a, const Pack<T,L> & b) { return OP(a.Register(),b.Register()); }
+
+#ifdef MATH_SIMD_SSE
+		namespace Kernel {
+			inline __m128 AbsPs(__m128 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+			inline __m128d AbsPd(__m128d a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+			inline __m128 RoundPs(__m128 a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+			inline __m128d RoundPd(__m128d a) { return _mm_cvtepi32_pd(_mm_cvtpd_epi32(a)); }
+
+			// n + 127 lands in the exponent field after the shift //
+			inline __m128 Power2Ps(__m128 n) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23)); }
+
+			// adding 2^52 + 1023 leaves n + 1023 in the low mantissa bits, which the shift moves into the exponent field //
+			inline __m128d Power2Pd(__m128d n) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(4503599627371519.0))), 52)); }
+
+			inline __m128 MantissaPs(__m128 a, __m128 & e) {
+				const __m128i bits = _mm_castps_si128(a);
+				e = _mm_sub_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bits, 23)), _mm_set1_ps(126.0f));
+				return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x807fffff)), _mm_set1_epi32(0x3f000000)));
+			}
+
+			// the biased exponent is or'ed under 2^52 so one subtraction turns it into a double //
+			inline __m128d MantissaPd(__m128d a, __m128d & e) {
+				const __m128i bits = _mm_castpd_si128(a);
+				const __m128i biased = _mm_or_si128(_mm_srli_epi64(bits, 52), _mm_castpd_si128(_mm_set1_pd(4503599627370496.0)));
+				e = _mm_sub_pd(_mm_castsi128_pd(biased), _mm_set1_pd(4503599627370496.0 + 1022.0));
+				const __m128i mask = _mm_set_epi32(0x800fffff, -1, 0x800fffff, -1), half = _mm_set_epi32(0x3fe00000, 0, 0x3fe00000, 0);
+				return _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, mask), half));
+			}
+
+			inline __m128 OutsidePs(__m128 a, __m128 lo, __m128 hi) { return _mm_or_ps(_mm_cmpnge_ps(a, lo), _mm_cmpnle_ps(a, hi)); }
+			inline __m128d OutsidePd(__m128d a, __m128d lo, __m128d hi) { return _mm_or_pd(_mm_cmpnge_pd(a, lo), _mm_cmpnle_pd(a, hi)); }
+		}
+
+		MATH_SIMD_UNARY(Sqrt,float,4,_mm_sqrt_ps)
+		MATH_SIMD_UNARY(Sqrt,double,2,_mm_sqrt_pd)
+		MATH_SIMD_UNARY(Abs,float,4,Kernel::AbsPs)
+		MATH_SIMD_UNARY(Abs,double,2,Kernel::AbsPd)
+		MATH_SIMD_UNARY(Round,float,4,Kernel::RoundPs)
+		MATH_SIMD_UNARY(Round,double,2,Kernel::RoundPd)
+		MATH_SIMD_UNARY(Power2,float,4,Kernel::Power2Ps)
+		MATH_SIMD_UNARY(Power2,double,2,Kernel::Power2Pd)
+		MATH_SIMD_BINARY(Max,float,4,_mm_max_ps)
+		MATH_SIMD_BINARY(Max,double,2,_mm_max_pd)
+		MATH_SIMD_BINARY(Min,float,4,_mm_min_ps)
+		MATH_SIMD_BINARY(Min,double,2,_mm_min_pd)
+		MATH_SIMD_BINARY(Less,float,4,_mm_cmplt_ps)
+		MATH_SIMD_BINARY(Less,double,2,_mm_cmplt_pd)
+
+		template<>
+		inline Pack<float,4> Mantissa(const Pack<float,4> & a, Pack<float,4> & e) {
+			__m128 exponent;
+			const Pack<float,4> m = Kernel::MantissaPs(a.Register(), exponent);
+			e = exponent;
+			return m;
+		}
+
+		template<>
+		inline Pack<double,2> Mantissa(const Pack<double,2> & a, Pack<double,2> & e) {
+			__m128d exponent;
+			const Pack<double,2> m = Kernel::MantissaPd(a.Register(), exponent);
+			e = exponent;
+			return m;
+		}
+
+		template<>
+		inline Pack<float,4> Outside(const Pack<float,4> & a, const Pack<float,4> & lo, const Pack<float,4> & hi) { return Kernel::OutsidePs(a.Register(), lo.Register(), hi.Register()); }
+
+		template<>
+		inline Pack<double,2> Outside(const Pack<double,2> & a, const Pack<double,2> & lo, const Pack<double,2> & hi) { return Kernel::OutsidePd(a.Register(), lo.Register(), hi.Register()); }
+
+		template<>
+		inline Pack<float,4> Select(const Pack<float,4> & mask, const Pack<float,4> & a, const Pack<float,4> & b) { return _mm_or_ps(_mm_and_ps(mask.Register(), a.Register()), _mm_andnot_ps(mask.Register(), b.Register())); }
+
+		template<>
+		inline Pack<double,2> Select(const Pack<double,2> & mask, const Pack<double,2> & a, const Pack<double,2> & b) { return _mm_or_pd(_mm_and_pd(mask.Register(), a.Register()), _mm_andnot_pd(mask.Register(), b.Register())); }
+
+		template<>
+		inline bool Any(const Pack<float,4> & mask) { return _mm_movemask_ps(mask.Register()) != 0; }
+
+		template<>
+		inline bool Any(const Pack<double,2> & mask) { return _mm_movemask_pd(mask.Register()) != 0; }
+#endif
+
+#ifdef MATH_SIMD_AVX
+		namespace Kernel {
+			inline __m256 AbsPs(__m256 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+			inline __m256d AbsPd(__m256d a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+			inline __m256 RoundPs(__m256 a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+			inline __m256d RoundPd(__m256d a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+			// AVX has no 256 bit integer shifts before AVX2, so the exponent tricks run on each 128 bit half //
+			inline __m256 Power2Ps(__m256 n) { return _mm256_insertf128_ps(_mm256_castps128_ps256(Power2Ps(_mm256_castps256_ps128(n))), Power2Ps(_mm256_extractf128_ps(n,1)), 1); }
+			inline __m256d Power2Pd(__m256d n) { return _mm256_insertf128_pd(_mm256_castpd128_pd256(Power2Pd(_mm256_castpd256_pd128(n))), Power2Pd(_mm256_extractf128_pd(n,1)), 1); }
+
+			inline __m256 LessPs(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			inline __m256d LessPd(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+		}
+
+		MATH_SIMD_UNARY(Sqrt,float,8,_mm256_sqrt_ps)
+		MATH_SIMD_UNARY(Sqrt,double,4,_mm256_sqrt_pd)
+		MATH_SIMD_UNARY(Abs,float,8,Kernel::AbsPs)
+		MATH_SIMD_UNARY(Abs,double,4,Kernel::AbsPd)
+		MATH_SIMD_UNARY(Round,float,8,Kernel::RoundPs)
+		MATH_SIMD_UNARY(Round,double,4,Kernel::RoundPd)
+		MATH_SIMD_UNARY(Power2,float,8,Kernel::Power2Ps)
+		MATH_SIMD_UNARY(Power2,double,4,Kernel::Power2Pd)
+		MATH_SIMD_BINARY(Max,float,8,_mm256_max_ps)
+		MATH_SIMD_BINARY(Max,double,4,_mm256_max_pd)
+		MATH_SIMD_BINARY(Min,float,8,_mm256_min_ps)
+		MATH_SIMD_BINARY(Min,double,4,_mm256_min_pd)
+		MATH_SIMD_BINARY(Less,float,8,Kernel::LessPs)
+		MATH_SIMD_BINARY(Less,double,4,Kernel::LessPd)
+
+		template<>
+		inline Pack<float,8> Mantissa(const Pack<float,8> & a, Pack<float,8> & e) {
+			__m128 lo, hi;
+			const __m128 m0 = Kernel::MantissaPs(_mm256_castps256_ps128(a.Register()), lo), m1 = Kernel::MantissaPs(_mm256_extractf128_ps(a.Register(),1), hi);
+			e = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(m0), m1, 1);
+		}
+
+		template<>
+		inline Pack<double,4> Mantissa(const Pack<double,4> & a, Pack<double,4> & e) {
+			__m128d lo, hi;
+			const __m128d m0 = Kernel::MantissaPd(_mm256_castpd256_pd128(a.Register()), lo), m1 = Kernel::MantissaPd(_mm256_extractf128_pd(a.Register(),1), hi);
+			e = _mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1);
+			return _mm256_insertf128_pd(_mm256_castpd128_pd256(m0), m1, 1);
+		}
+
+		template<>
+		inline Pack<float,8> Outside(const Pack<float,8> & a, const Pack<float,8> & lo, const Pack<float,8> & hi) { return _mm256_or_ps(_mm256_cmp_ps(a.Register(), lo.Register(), _CMP_NGE_UQ), _mm256_cmp_ps(a.Register(), hi.Register(), _CMP_NLE_UQ)); }
+
+		template<>
+		inline Pack<double,4> Outside(const Pack<double,4> & a, const Pack<double,4> & lo, const Pack<double,4> & hi) { return _mm256_or_pd(_mm256_cmp_pd(a.Register(), lo.Register(), _CMP_NGE_UQ), _mm256_cmp_pd(a.Register(), hi.Register(), _CMP_NLE_UQ)); }
+
+		template<>
+		inline Pack<float,8> Select(const Pack<float,8> & mask, const Pack<float,8> & a, const Pack<float,8> & b) { return _mm256_blendv_ps(b.Register(), a.Register(), mask.Register()); }
+
+		template<>
+		inline Pack<double,4> Select(const Pack<double,4> & mask, const Pack<double,4> & a, const Pack<double,4> & b) { return _mm256_blendv_pd(b.Register(), a.Register(), mask.Register()); }
+
+		template<>
+		inline bool Any(const Pack<float,8> & mask) { return _mm256_movemask_ps(mask.Register()) != 0; }
+
+		template<>
+		inline bool Any(const Pack<double,4> & mask) { return _mm256_movemask_pd(mask.Register()) != 0; }
+#endif
+
+#undef MATH_SIMD_UNARY
+#undef MATH_SIMD_BINARY
+
+		// store that bypasses the cache for output that will not be read back soon, p must be 16 byte aligned //
+		// a run of streaming stores is finished with Fence before another thread reads the data //
+		template<typename T, int L>
+		void Stream(T * p, const Pack<T,L> & a) { a.Store(p); }
+
+#ifdef MATH_SIMD_SSE
+		template<>
+		inline void Stream(float * p, const Pack<float,4> & a) { _mm_stream_ps(p, a.Register()); }
+
+		template<>
+		inline void Stream(double * p, const Pack<double,2> & a) { _mm_stream_pd(p, a.Register()); }
+
+		inline void Fence() { _mm_sfence(); }
+#else
+		inline void Fence() {}
+#endif
+
+#ifdef MATH_SIMD_AVX
+		template<>
+		inline void Stream(float * p, const Pack<float,8> & a) {
+			_mm_stream_ps(p, _mm256_castps256_ps128(a.Register()));
+			_mm_stream_ps(p+4, _mm256_extractf128_ps(a.Register(),1));
+		}
+
+		template<>
+		inline void Stream(double * p, const Pack<double,4> & a) {
+			_mm_stream_pd(p, _mm256_castpd256_pd128(a.Register()));
+			_mm_stream_pd(p+2, _mm256_extractf128_pd(a.Register(),1));
+		}
+#endif
+
+#ifdef MATH_SIMD_SSE
+		template<>
+		inline void Deinterleave(const float * p, Pack<float,4> & even, Pack<float,4> & odd) {
+			const __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p+4);
+			even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+			odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+		}
+
+		template<>
+		inline void Deinterleave(const double * p, Pack<double,2> & even, Pack<double,2> & odd) {
+			const __m128d a = _mm_loadu_pd(p), b = _mm_loadu_pd(p+2);
+			even = _mm_unpacklo_pd(a, b);
+			odd = _mm_unpackhi_pd(a, b);
+		}
+
+		template<>
+		inline void Interleave(float * p, const Pack<float,4> & even, const Pack<float,4> & odd) {
+			_mm_storeu_ps(p, _mm_unpacklo_ps(even.Register(), odd.Register()));
+			_mm_storeu_ps(p+4, _mm_unpackhi_ps(even.Register(), odd.Register()));
+		}
+
+		template<>
+		inline void Interleave(double * p, const Pack<double,2> & even, const Pack<double,2> & odd) {
+			_mm_storeu_pd(p, _mm_unpacklo_pd(even.Register(), odd.Register()));
+			_mm_storeu_pd(p+2, _mm_unpackhi_pd(even.Register(), odd.Register()));
+		}
+#endif
+
+#ifdef MATH_SIMD_AVX
+		// the shuffles work within 128 bit halves, so the halves are regrouped first and last //
+		template<>
+		inline void Deinterleave(const float * p, Pack<float,8> & even, Pack<float,8> & odd) {
+			const __m256 a = _mm256_loadu_ps(p), b = _mm256_loadu_ps(p+8);
+			const __m256 lo = _mm256_permute2f128_ps(a, b, 0x20), hi = _mm256_permute2f128_ps(a, b, 0x31);
+			even = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2,0,2,0));
+			odd = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3,1,3,1));
+		}
+
+		template<>
+		inline void Deinterleave(const double * p, Pack<double,4> & even, Pack<double,4> & odd) {
+			const __m256d a = _mm256_loadu_pd(p), b = _mm256_loadu_pd(p+4);
+			const __m256d lo = _mm256_permute2f128_pd(a, b, 0x20), hi = _mm256_permute2f128_pd(a, b, 0x31);
+			even = _mm256_unpacklo_pd(lo, hi);
+			odd = _mm256_unpackhi_pd(lo, hi);
+		}
+
+		template<>
+		inline void Interleave(float * p, const Pack<float,8> & even, const Pack<float,8> & odd) {
+			const __m256 lo = _mm256_unpacklo_ps(even.Register(), odd.Register()), hi = _mm256_unpackhi_ps(even.Register(), odd.Register());
+			_mm256_storeu_ps(p, _mm256_permute2f128_ps(lo, hi, 0x20));
+			_mm256_storeu_ps(p+8, _mm256_permute2f128_ps(lo, hi, 0x31));
+		}
+
+		template<>
+		inline void Interleave(double * p, const Pack<double,4> & even, const Pack<double,4> & odd) {
+			const __m256d lo = _mm256_unpacklo_pd(even.Register(), odd.Register()), hi = _mm256_unpackhi_pd(even.Register(), odd.Register());
+			_mm256_storeu_pd(p, _mm256_permute2f128_pd(lo, hi, 0x20));
+			_mm256_storeu_pd(p+4, _mm256_permute2f128_pd(lo, hi, 0x31));
+		}
+#endif
+
+#ifdef MATH_SIMD_FMA
+		template<>
+		inline Pack<float,4> MultiplyAdd(const Pack<float,4> & a, const Pack<float,4> & b, const Pack<float,4> & c) { return _mm_fmadd_ps(a.Register(),b.Register(),c.Register()); }
+
+		template<>
+		inline Pack<double,2> MultiplyAdd(const Pack<double,2> & a, const Pack<double,2> & b, const Pack<double,2> & c) { return _mm_fmadd_pd(a.Register(),b.Register(),c.Register()); }
+
+		template<>
+		inline Pack<float,8> MultiplyAdd(const Pack<float,8> & a, const Pack<float,8> & b, const Pack<float,8> & c) { return _mm256_fmadd_ps(a.Register(),b.Register(),c.Register()); }
+
+		template<>
+		inline Pack<double,4> MultiplyAdd(const Pack<double,4> & a, const Pack<double,4> & b, const Pack<double,4> & c) { return _mm256_fmadd_pd(a.Register(),b.Register(),c.Register()); }
+#endif
+
+#ifdef MATH_SIMD_AVX2
+		// the masked forms start from zero rather than an undefined register, which some compilers warn about //
+		template<>
+		inline Pack<float,8> Gather(const float * base, const int * index) { return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, _mm256_loadu_si256((const __m256i*)index), _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4); }
+
+		template<>
+		inline Pack<double,4> Gather(const double * base, const int * index) { return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, _mm_loadu_si128((const __m128i*)index), _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8); }
+#endif
+	}
+}
+
+#endif // ending MATH_SIMD //
@@ -0,0 +1,324 @@
+#define API_EXPORT
+#include <Math/BigInteger.h>
+
+#include <algorithm>
+
+BEGIN_C
+# include <assert.h>
+END_C
+
+namespace Math {
+	namespace {
+		typedef std::vector<uint32_t> Magnitude;
+
+		int CompareMagnitude(const Magnitude & a, const Magnitude & b) {
+			if( a.size() != b.size() ) return a.size() < b.size() ? -1 : 1;
+			for(size_t i=a.size();i-->0;)
+				if( a[i] != b[i] ) return a[i] < b[i] ? -1 : 1;
+			return 0;
+		}
+
+		// a += b //
+		void AddMagnitude(Magnitude & a, const Magnitude & b) {
+			if( a.size() < b.size() ) a.resize(b.size(), 0);
+			uint64_t carry = 0;
+			for(size_t i=0;i<a.size();i++){
+				if( i >= b.size() and carry == 0 ) break;
+				carry += uint64_t(a[i]) + (i < b.size() ? b[i] : 0);
+				a[i] = uint32_t(carry);
+				carry >>= 32;
+			}
+			if( carry ) a.push_back(uint32_t(carry));
+		}
+
+		// a -= b for |a| >= |b| //
+		void SubtractMagnitude(Magnitude & a, const Magnitude & b) {
+			int64_t borrow = 0;
+			for(size_t i=0;i<a.size();i++){
+				if( i >= b.size() and borrow == 0 ) break;
+				borrow += int64_t(a[i]) - (i < b.size() ? int64_t(b[i]) : 0);
+				a[i] = uint32_t(borrow);
+				borrow = borrow < 0 ? -1 : 0;
+			}
+		}
+
+		// out[0,na+nb) += a*b //
+		void Schoolbook(const uint32_t * a, size_t na, const uint32_t * b, size_t nb, uint32_t * out) {
+			for(size_t i=0;i<na;i++){
+				uint64_t carry = 0;
+				const uint64_t x = a[i];
+				for(size_t j=0;j<nb;j++){
+					carry += x*b[j] + out[i+j];
+					out[i+j] = uint32_t(carry);
+					carry >>= 32;
+				}
+				for(size_t k=i+nb;carry;k++){
+					carry += out[k];
+					out[k] = uint32_t(carry);
+					carry >>= 32;
+				}
+			}
+		}
+
+		// out[0,n) += a[0,na) with carry propagation, returns the carry out of the top //
+		uint32_t Accumulate(uint32_t * out, size_t n, const uint32_t * a, size_t na) {
+			uint64_t carry = 0;
+			size_t i = 0;
+			for(;i<na;i++){
+				carry += uint64_t(out[i]) + a[i];
+				out[i] = uint32_t(carry);
+				carry >>= 32;
+			}
+			for(;carry and i<n;i++){
+				carry += out[i];
+				out[i] = uint32_t(carry);
+				carry >>= 32;
+			}
+			return uint32_t(carry);
+		}
+
+		void Multiply(const uint32_t * a, size_t na, const uint32_t * b, size_t nb, uint32_t * out);
+
+		void ShiftRightMagnitude(Magnitude & a, size_t bits) {
+			const size_t words = bits/32, shift = bits%32;
+			a.erase(a.begin(), a.begin() + (words < a.size() ? words : a.size()));
+			if( shift )
+				for(size_t i=0;i<a.size();i++) a[i] = (a[i] >> shift) | (i+1 < a.size() ? a[i+1] << (32-shift) : 0);
+			while( !a.empty() and a.back() == 0 ) a.pop_back();
+		}
+
+		size_t TrailingZeros(const Magnitude & a) {
+			size_t bits = 0, i = 0;
+			for(;i<a.size() and a[i] == 0;i++) bits += 32;
+			if( i < a.size() ) for(uint32_t w=a[i];!(w & 1);w >>= 1) bits++;
+			return bits;
+		}
+
+		// out[0,2n) += a*b for two n limb operands, a = a1*B^m + a0 and a1*b1, a0*b0, (a0+a1)(b0+b1) give the three products //
+		void Karatsuba(const uint32_t * a, const uint32_t * b, size_t n, uint32_t * out) {
+			const size_t m = n/2, h = n - m;
+			Magnitude sa(h+1, 0), sb(h+1, 0), low(2*m, 0), high(2*h, 0), middle(2*h+2, 0);
+			std::copy(a+m, a+n, sa.begin());
+			std::copy(b+m, b+n, sb.begin());
+			sa[h] = Accumulate(sa.data(), h, a, m);
+			sb[h] = Accumulate(sb.data(), h, b, m);
+
+			Multiply(a, m, b, m, low.data());
+			Multiply(a+m, h, b+m, h, high.data());
+			Multiply(sa.data(), sa[h] ? h+1 : h, sb.data(), sb[h] ? h+1 : h, middle.data());
+
+			Magnitude::iterator top = middle.end();
+			while( top != middle.begin() and *(top-1) == 0 ) --top;
+			Magnitude mid(middle.begin(), top);
+			SubtractMagnitude(mid, low);
+			SubtractMagnitude(mid, high);
+			while( !mid.empty() and mid.back() == 0 ) mid.pop_back();
+
+			Accumulate(out, 2*n, low.data(), low.size());
+			Accumulate(out+2*m, 2*n-2*m, high.data(), high.size());
+			Accumulate(out+m, 2*n-m, mid.data(), mid.size());
+		}
+
+		// out[0,na+nb) += a*b, out must not overlap a or b //
+		void Multiply(const uint32_t * a, size_t na, const uint32_t * b, size_t nb, uint32_t * out) {
+			if( na < nb ) std::swap(a,b), std::swap(na,nb);
+			if( nb < BigInteger::KaratsubaLimbs ) return Schoolbook(a, na, b, nb, out);
+
+			// unbalanced operands are cut into nb limb slices of a, each a balanced product //
+			if( na > nb ){
+				Magnitude slice(2*nb, 0);
+				for(size_t i=0;i<na;i+=nb){
+					const size_t n = na-i < nb ? na-i : nb;
+					std::fill(slice.begin(), slice.end(), 0);
+					if( n == nb ) Karatsuba(a+i, b, nb, slice.data());
+					else Multiply(b, nb, a+i, n, slice.data());
+					Accumulate(out+i, na+nb-i, slice.data(), n+nb);
+				}
+				return;
+			}
+			Karatsuba(a, b, na, out);
+		}
+	}
+
+	API void BigInteger::Trim() {
+		while( !limbs.empty() and limbs.back() == 0 ) limbs.pop_back();
+		if( limbs.empty() ) negative = false;
+	}
+
+	API size_t BigInteger::Bits() const {
+		if( limbs.empty() ) return 0;
+		size_t bits = 32*(limbs.size()-1);
+		for(uint32_t top=limbs.back();top;top >>= 1) bits++;
+		return bits;
+	}
+
+	API int64_t BigInteger::ToInt64(Status * status) const {
+		const uint64_t limit = negative ? uint64_t(1) << 63 : (uint64_t(1) << 63) - 1;
+		uint64_t m = 0;
+		for(size_t i=limbs.size();i-->0;){
+			if( i >= 2 or m > limit ){ m = limit+1; break; }
+			m = (m << 32) | limbs[i];
+		}
+		if( m > limit ){
+			if( status ) *status = Status::Overflow;
+			return 0;
+		}
+		if( status ) *status = Status::Success;
+		return negative ? int64_t(uint64_t(0) - m) : int64_t(m);
+	}
+
+	API std::string BigInteger::ToString() const {
+		if( limbs.empty() ) return "0";
+		Magnitude m = limbs;
+		std::vector<uint32_t> chunks;
+		while( !m.empty() ){
+			uint64_t remainder = 0;
+			for(size_t i=m.size();i-->0;){
+				remainder = (remainder << 32) | m[i];
+				m[i] = uint32_t(remainder/1000000000u);
+				remainder %= 1000000000u;
+			}
+			chunks.push_back(uint32_t(remainder));
+			while( !m.empty() and m.back() == 0 ) m.pop_back();
+		}
+
+		std::string string = negative ? "-" : "";
+		string += std::to_string(chunks.back());
+		for(size_t i=chunks.size()-1;i-->0;){
+			const std::string digits = std::to_string(chunks[i]);
+			string += std::string(9-digits.size(), '0') + digits;
+		}
+		return string;
+	}
+
+	API int BigInteger::Compare(const BigInteger & u) const {
+		if( negative != u.negative ) return negative ? -1 : 1;
+		const int c = CompareMagnitude(limbs, u.limbs);
+		return negative ? -c : c;
+	}
+
+	API BigInteger & BigInteger::operator += (const BigInteger & u) {
+		if( negative == u.negative ) AddMagnitude(limbs, u.limbs);
+		else if( CompareMagnitude(limbs, u.limbs) >= 0 ) SubtractMagnitude(limbs, u.limbs);
+		else {
+			Magnitude m = u.limbs;
+			SubtractMagnitude(m, limbs);
+			limbs.swap(m);
+			negative = u.negative;
+		}
+		Trim();
+		return *this;
+	}
+
+	API BigInteger & BigInteger::operator -= (const BigInteger & u) {
+		if( this == &u ){
+			limbs.clear();
+			negative = false;
+			return *this;
+		}
+		negative = !negative;
+		operator+=(u);
+		if( !IsZero() ) negative = !negative;
+		return *this;
+	}
+
+	API BigInteger & BigInteger::operator *= (const BigInteger & u) {
+		if( IsZero() or u.IsZero() ){
+			limbs.clear();
+			negative = false;
+			return *this;
+		}
+		Magnitude product(limbs.size() + u.limbs.size(), 0);
+		Multiply(limbs.data(), limbs.size(), u.limbs.data(), u.limbs.size(), product.data());
+		limbs.swap(product);
+		negative = negative != u.negative;
+		Trim();
+		return *this;
+	}
+
+	API BigInteger & BigInteger::operator <<= (size_t bits) {
+		if( IsZero() ) return *this;
+		const size_t words = bits/32, shift = bits%32;
+		if( shift ){
+			limbs.push_back(0);
+			for(size_t i=limbs.size()-1;i>0;i--) limbs[i] = (limbs[i] << shift) | (limbs[i-1] >> (32-shift));
+			limbs[0] <<= shift;
+		}
+		limbs.insert(limbs.begin(), words, 0);
+		Trim();
+		return *this;
+	}
+
+	// Jebelean's exact division: with an odd divisor each quotient limb is the low limb of the remainder times the //
+	// inverse of the divisor modulo 2^32, the remainder then loses that limb exactly //
+	API BigInteger & BigInteger::DivideExact(const BigInteger & d) {
+		assert(!d.IsZero());
+		if( IsZero() ) return *this;
+		Magnitude n = limbs, v = d.limbs;
+		const size_t zeros = TrailingZeros(v);
+		ShiftRightMagnitude(n, zeros);
+		ShiftRightMagnitude(v, zeros);
+
+		// Newton's iteration doubles the correct low bits of the inverse, an odd v is its own inverse to 3 bits //
+		uint32_t inverse = v[0];
+		for(int i=0;i<4;i++) inverse *= 2 - v[0]*inverse;
+
+		const size_t count = n.size() >= v.size() ? n.size() - v.size() + 1 : 0;
+		Magnitude q(count, 0);
+		for(size_t i=0;i<count;i++){
+			const uint32_t digit = n[i]*inverse;
+			q[i] = digit;
+			uint64_t carry = 0;
+			int64_t borrow = 0;
+			for(size_t j=0;i+j<n.size();j++){
+				if( j >= v.size() and carry == 0 and borrow == 0 ) break;
+				carry += uint64_t(digit)*(j < v.size() ? v[j] : 0);
+				borrow += int64_t(n[i+j]) - int64_t(uint32_t(carry));
+				n[i+j] = uint32_t(borrow);
+				carry >>= 32;
+				borrow = borrow < 0 ? -1 : 0;
+			}
+		}
+		limbs.swap(q);
+		negative = negative != d.negative;
+		Trim();
+		return *this;
+	}
+
+	API void FibonacciNumber(uint32_t n, BigInteger & out) {
+		if( n <= FibonacciLimit ){
+			out = BigInteger(FibonacciNumber(n));
+			return;
+		}
+
+		// a = F(k), b = F(k+1) for the leading bits k of n //
+		BigInteger a(0), b(1);
+		for(int bit=31;bit>=0;bit--){
+			BigInteger c = (b << 1) - a;
+			c *= a;
+			BigInteger d = a*a;
+			d += b*b;
+			if( (n >> bit) & 1 ){
+				a = d;
+				b = c += d;
+			}
+			else {
+				a = std::move(c);
+				b = std::move(d);
+			}
+		}
+		out = std::move(a);
+	}
+
+	API void FibonacciRange(uint32_t first, uint32_t last, BigInteger * out) {
+		if( first >= last ) return;
+		BigInteger f, g;
+		FibonacciNumber(first, f);
+		FibonacciNumber(first+1, g);
+		for(uint32_t i=first;i<last;i++){
+			*out++ = f;
+			f += g;
+			std::swap(f, g);
+		}
+	}
+}
@@ -0,0 +1,214 @@
+#define API_EXPORT
+#include <Math/Parallel.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#elif defined(_WIN32)
+# include <windows.h>
+#endif
+
+namespace Math {
+	namespace Parallel {
+		namespace {
+
+			struct Group {
+				std::atomic<size_t> pending;
+				std::mutex lock;
+				std::exception_ptr error;
+			};
+
+			struct Job {
+				const std::function<void(size_t,size_t)> * body;
+				size_t begin, end;
+				Group * group;
+			};
+
+			struct Queue {
+				std::mutex lock;
+				std::deque<Job> jobs;
+			};
+
+			void Run(const Job & job) {
+				try {
+					(*job.body)(job.begin, job.end);
+				}
+				catch(...) {
+					std::lock_guard<std::mutex> guard(job.group->lock);
+					if( !job.group->error ) job.group->error = std::current_exception();
+				}
+				job.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+			}
+
+			void Pin(std::thread & thread, unsigned core) {
+#if defined(__linux__)
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(core % CPU_SETSIZE, &set);
+				pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#elif defined(_WIN32)
+				SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << (core % (sizeof(DWORD_PTR)*8)));
+#else
+				(void)thread, (void)core;
+#endif
+			}
+
+			// one deque per worker, owners push and pop at the back, thieves and the calling thread take from the front //
+			class Pool {
+			public:
+				Pool(unsigned threads, bool affinity): queues(threads > 1 ? threads-1 : 0), queued(0), next(0), stop(false) {
+					for(unsigned i=0;i<queues.size();i++){
+						workers.emplace_back(&Pool::Work, this, int(i));
+						if( affinity ) Pin(workers.back(), i+1);
+					}
+				}
+
+				~Pool() {
+					{
+						std::lock_guard<std::mutex> guard(sleep);
+						stop = true;
+					}
+					wake.notify_all();
+					for(auto & worker : workers) worker.join();
+				}
+
+				unsigned Workers() const { return unsigned(queues.size()); }
+
+				void Push(const Job & job) {
+					size_t q = self >= 0 and owner == this ? size_t(self) : next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+					{
+						std::lock_guard<std::mutex> guard(queues[q].lock);
+						queues[q].jobs.push_back(job);
+					}
+					queued.fetch_add(1, std::memory_order_release);
+					std::lock_guard<std::mutex> guard(sleep);
+					wake.notify_one();
+				}
+
+				bool TryRun(int index) {
+					Job job;
+					if( index >= 0 and Pop(queues[index], job, true) ) return Run(job), true;
+
+					const size_t n = queues.size();
+					const size_t start = index >= 0 ? size_t(index)+1 : next.load(std::memory_order_relaxed);
+					for(size_t i=0;i<n;i++)
+						if( Pop(queues[(start+i)%n], job, false) ) return Run(job), true;
+					return false;
+				}
+
+				void Help(Group & group) {
+					const int index = owner == this ? self : -1;
+					while( group.pending.load(std::memory_order_acquire) > 0 )
+						if( !TryRun(index) ) std::this_thread::yield();
+				}
+
+			private:
+				bool Pop(Queue & queue, Job & job, bool back) {
+					std::lock_guard<std::mutex> guard(queue.lock);
+					if( queue.jobs.empty() ) return false;
+					if( back ) job = queue.jobs.back(), queue.jobs.pop_back();
+					else job = queue.jobs.front(), queue.jobs.pop_front();
+					queued.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+
+				void Work(int index) {
+					self = index;
+					owner = this;
+					while( true ){
+						if( TryRun(index) ) continue;
+						std::unique_lock<std::mutex> lock(sleep);
+						wake.wait(lock, [this]() { return stop or queued.load(std::memory_order_acquire) > 0; });
+						if( stop ) return;
+					}
+				}
+
+				std::vector<Queue> queues;
+				std::vector<std::thread> workers;
+				std::atomic<size_t> queued, next;
+				std::mutex sleep;
+				std::condition_variable wake;
+				bool stop;
+
+				static thread_local int self;
+				static thread_local Pool * owner;
+			};
+
+			thread_local int Pool::self = -1;
+			thread_local Pool * Pool::owner = nullptr;
+
+			// shared owns the pool and only changes under configure, published is what Threads, Chunk and ForChunks read //
+			// so once the pool exists those calls take no lock //
+			std::mutex configure;
+			std::unique_ptr<Pool> shared;
+			std::atomic<Pool *> published(nullptr);
+			std::atomic<bool> deterministic(false);
+
+			unsigned Hardware() {
+				unsigned n = std::thread::hardware_concurrency();
+				return n ? n : 1;
+			}
+
+			Pool & Shared() {
+				Pool * pool = published.load(std::memory_order_acquire);
+				if( pool ) return *pool;
+				std::lock_guard<std::mutex> guard(configure);
+				if( !shared ){
+					shared.reset(new Pool(Hardware(), false));
+					published.store(shared.get(), std::memory_order_release);
+				}
+				return *shared;
+			}
+		}
+
+		API void Configure(unsigned threads, bool affinity) {
+			std::lock_guard<std::mutex> guard(configure);
+			published.store(nullptr, std::memory_order_release);
+			shared.reset();
+			shared.reset(new Pool(threads ? threads : Hardware(), affinity));
+			published.store(shared.get(), std::memory_order_release);
+		}
+
+		API unsigned Threads() { return Shared().Workers() + 1; }
+
+		API void SetDeterministic(bool value) { deterministic.store(value); }
+		API bool IsDeterministic() { return deterministic.load(); }
+
+		API size_t Chunk(size_t count, size_t grain) {
+			if( grain == 0 ) grain = 1;
+			if( IsDeterministic() ) return grain;
+			const size_t split = 4*size_t(Threads());
+			const size_t chunk = (count + split - 1)/split;
+			return chunk > grain ? chunk : grain;
+		}
+
+		API void ForChunks(size_t first, size_t last, size_t chunk, const std::function<void(size_t,size_t)> & body) {
+			if( last <= first ) return;
+			if( chunk == 0 ) chunk = 1;
+			const size_t count = (last-first+chunk-1)/chunk;
+			Pool & pool = Shared();
+			if( count == 1 or pool.Workers() == 0 ){
+				for(size_t begin=first;begin<last;begin+=chunk) body(begin, last-begin < chunk ? last : begin+chunk);
+				return;
+			}
+
+			Group group;
+			group.pending.store(count);
+			for(size_t i=count-1;i>0;i--){
+				const size_t begin = first + i*chunk;
+				pool.Push(Job{ &body, begin, last-begin < chunk ? last : begin+chunk, &group });
+			}
+			Run(Job{ &body, first, first+chunk, &group });
+			pool.Help(group);
+			if( group.error ) std::rethrow_exception(group.error);
+		}
+	}
+}
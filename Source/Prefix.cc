@@ -2,24 +2,79 @@
 #include <Math/Prefix.h>
 
 namespace Math {
-	API uint64_t Factorial(uint64_t n) {
-		if(n==0) return 1;
-		uint64_t factorial = 1;
-		while(n>0) factorial *= n--;
-		return factorial;
+	namespace {
+		struct Pascal {
+			Pascal() {
+				for(uint32_t n=0;n<=PascalRows;n++){
+					uint64_t * row = e + PascalIndex(n,0);
+					const uint64_t * above = n > 0 ? e + PascalIndex(n-1,0) : nullptr;
+					row[0] = 1;
+					for(uint32_t p=1;p<=n/2;p++) row[p] = above[p-1] + (p <= (n-1)/2 ? above[p] : above[n-1-p]);
+				}
+			}
+
+			uint64_t e[PascalIndex(PascalRows+1,0)];
+		};
+	}
+
+	API const uint64_t * PascalTable() {
+		static const Pascal pascal;
+		return pascal.e;
+	}
+
+	API Status FibonacciRange(uint32_t first, uint32_t last, uint64_t * out) {
+		if( first >= last ) return Status::Success;
+		uint64_t f = 0, g = 0;
+		if( first <= FibonacciLimit ) Kernel::FibonacciPair(first, f, g);
+		for(uint32_t i=first;i<last;i++){
+			*out++ = i <= FibonacciLimit ? f : 0;
+			const uint64_t h = f + g;
+			f = g, g = h;
+		}
+		return last-1 > FibonacciLimit ? Status::Overflow : Status::Success;
 	}
 
-	API uint64_t Choose(uint32_t n, uint32_t p) {
-		if(n < p) return Choose(p,n); // to save it from returning a zero in the future //
-		return Factorial(n)/(Factorial(p)*Factorial(n-p));
+	API Status ChooseRow(uint32_t n, uint64_t * out) {
+		return ChooseRange(n, 0, n+1, out);
 	}
 
-	API uint64_t Fibonacci(uint32_t n) {
-		uint64_t fib = 0, a = 0, b = 1;
-		for(uint32_t i=0;i<n;i++) {
-			fib = a + b;
-			a = b, b = fib;
+	API Status ChooseRange(uint32_t n, uint32_t first, uint32_t last, uint64_t * out) {
+		if( last > n+1 ) last = n+1;
+		if( first >= last ) return Status::Success;
+
+		if( n <= PascalRows ){
+			const uint64_t * row = PascalTable() + PascalIndex(n,0);
+			for(uint32_t p=first;p<last;p++) *out++ = row[p <= n/2 ? p : n-p];
+			return Status::Success;
+		}
+
+		// C(n,p) = C(n,p-1)*(n-p+1)/p walking up to the middle of the row, and back from the far end for the falling half //
+		// both walks move towards larger values, so once a step overflows the rest of that walk does as well //
+		Status status = Status::Success;
+		const uint32_t split = Min(Max(first, n/2+1), last);
+		bool valid = false;
+		uint64_t r = 0;
+		for(uint32_t p=first;p<split;p++){
+			if( p == first ){
+				Status s = Status::Success;
+				r = Choose(n, p, &s);
+				valid = s == Status::Success;
+			}
+			else if( valid ) valid = Kernel::ChooseStep(r, n-p+1, p);
+			if( !valid ) status = Status::Overflow;
+			out[p-first] = valid ? r : 0;
+		}
+
+		for(uint32_t p=last;p-->split;){
+			if( p == last-1 ){
+				Status s = Status::Success;
+				r = Choose(n, p, &s);
+				valid = s == Status::Success;
+			}
+			else if( valid ) valid = Kernel::ChooseStep(r, p+1, n-p);
+			if( !valid ) status = Status::Overflow;
+			out[p-first] = valid ? r : 0;
 		}
-		return fib;
+		return status;
 	}
-}
\ No newline at end of file
+}
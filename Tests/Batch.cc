@@ -0,0 +1,96 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Batch.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// every bulk kernel against the same arithmetic one element at a time, in double //
+template<typename T, int size>
+static void Kernels(size_t count, std::mt19937 & random, double tolerance) {
+	std::uniform_real_distribution<double> u(-2, 2);
+	std::vector< Vector::Template<T,size> > a(count), b(count);
+	for(size_t i=0;i<count;i++)
+		for(int c=0;c<size;c++) a[i][c] = T(u(random)), b[i][c] = T(u(random));
+	// zero and orthogonal elements for Normalize, GetAngle and IsOrtho //
+	if( count > 3 ){
+		for(int c=0;c<size;c++) a[1][c] = T(0), a[3][c] = b[3][c] = T(0);
+		a[3][0] = T(1), b[3][1] = T(2);
+	}
+
+	// the array of structs round trip goes through the transposes and has to be exact //
+	const Vector::Batch<T,size> A(a), B(b.data(), count);
+	MATH_CHECK(A.GetCount() == count and A.ToVector() == a);
+	std::vector< Vector::Template<T,size> > back(count);
+	B.Extract(back.data());
+	MATH_CHECK(back == b);
+
+	std::vector<T> dot(count), length(count), angle(count);
+	std::unique_ptr<bool[]> ortho(new bool[count ? count : 1]);
+	Vector::Dot(A, B, dot.data());
+	A.GetLength(length.data());
+	A.GetAngle(B, angle.data());
+	Vector::IsOrtho(A, B, ortho.get());
+
+	Vector::Batch<T,size> N = A, Y = B;
+	N.Normalize();
+	Vector::Axpy(T(-1.5), A, Y);
+
+	bool near = true, unit = true, axpy = true;
+	for(size_t i=0;i<count;i++){
+		double d = 0, aa = 0, bb = 0;
+		for(int c=0;c<size;c++) d += double(a[i][c])*b[i][c], aa += double(a[i][c])*a[i][c], bb += double(b[i][c])*b[i][c];
+		const double theta = aa == 0 or bb == 0 ? 0 : std::acos(Max(Min(d/std::sqrt(aa*bb), 1.0), -1.0));
+		near = near and Abs(double(dot[i]) - d) <= tolerance*(1 + Abs(d)) and Abs(double(length[i]) - std::sqrt(aa)) <= tolerance;
+		near = near and Abs(double(angle[i]) - theta) <= std::sqrt(tolerance) and ortho[i] == (Abs(d) <= 1e-15);
+		for(int c=0;c<size;c++){
+			unit = unit and Abs(double(N[i][c]) - (aa == 0 ? 0 : a[i][c]/std::sqrt(aa))) <= tolerance;
+			axpy = axpy and Abs(double(Y[i][c]) - (double(b[i][c]) - 1.5*a[i][c])) <= tolerance;
+		}
+	}
+	MATH_CHECK(near);
+	MATH_CHECK(unit);
+	MATH_CHECK(axpy);
+	if( count > 3 ) MATH_CHECK(ortho[3] and angle[1] == T(0) and Abs(double(angle[3]) - Pi<double>()/2) <= tolerance);
+}
+
+// the cross product may write over either of its operands //
+template<typename T>
+static void Cross(size_t count, std::mt19937 & random, double tolerance) {
+	std::uniform_real_distribution<double> u(-2, 2);
+	std::vector< Vector::Template<T,3> > a(count), b(count);
+	for(size_t i=0;i<count;i++)
+		for(int c=0;c<3;c++) a[i][c] = T(u(random)), b[i][c] = T(u(random));
+	Vector::Batch<T,3> A(a), B(b), C;
+	Vector::Cross(A, B, C);
+	Vector::Cross(A, B, A);
+
+	bool cross = true;
+	for(size_t i=0;i<count;i++){
+		const double x = double(a[i][1])*b[i][2] - double(a[i][2])*b[i][1];
+		const double y = double(a[i][2])*b[i][0] - double(a[i][0])*b[i][2];
+		const double z = double(a[i][0])*b[i][1] - double(a[i][1])*b[i][0];
+		cross = cross and Abs(double(C[i][0]) - x) <= tolerance and Abs(double(C[i][1]) - y) <= tolerance and Abs(double(C[i][2]) - z) <= tolerance;
+		cross = cross and A[i] == C[i];
+	}
+	MATH_CHECK(cross);
+}
+
+int main() {
+	std::mt19937 random(61);
+	// empty, shorter than a register, a partial tail, and long enough to be split across workers //
+	for(size_t count : {size_t(0), size_t(3), size_t(37), (size_t(1) << 15) + 5}){
+		Kernels<float,2>(count, random, 1e-5);
+		Kernels<float,3>(count, random, 1e-5);
+		Kernels<float,4>(count, random, 1e-5);
+		Kernels<double,2>(count, random, 1e-13);
+		Kernels<double,3>(count, random, 1e-13);
+		Kernels<double,4>(count, random, 1e-13);
+		Cross<float>(count, random, 1e-5);
+		Cross<double>(count, random, 1e-13);
+	}
+	return Tests::Report("Batch");
+}
@@ -0,0 +1,104 @@
+#include <Tests/Check.h>
+#include <Math/BigInteger.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+static_assert(FibonacciNumber(10) == 55 and Fibonacci(10) == 89, "Fibonacci stays usable in constant expressions");
+
+// the uint64_t entry points, both indexings, and where each runs out //
+static void Sequence() {
+	const uint64_t first[] = {0, 1, 1, 2, 3, 5, 8, 13, 21, 34};
+	bool standard = true, original = Fibonacci(0) == 0;
+	for(uint32_t n=0;n<10;n++) standard = standard and FibonacciNumber(n) == first[n];
+	for(uint32_t n=1;n<9;n++) original = original and Fibonacci(n) == first[n+1];
+	MATH_CHECK(standard);
+	MATH_CHECK(original);
+
+	Status status = Status::Overflow;
+	MATH_CHECK(FibonacciNumber(FibonacciLimit, &status) == 12200160415121876738ull and status == Status::Success);
+	MATH_CHECK(FibonacciNumber(FibonacciLimit+1, &status) == 0 and status == Status::Overflow);
+	MATH_CHECK(Fibonacci(FibonacciLimit-1, &status) == 12200160415121876738ull and status == Status::Success);
+	MATH_CHECK(Fibonacci(FibonacciLimit, &status) == 0 and status == Status::Overflow);
+	MATH_CHECK(Fibonacci(~uint32_t(0), &status) == 0 and status == Status::Overflow);
+
+	std::vector<uint64_t> range(20);
+	MATH_CHECK(FibonacciRange(80, 100, range.data()) == Status::Overflow);
+	bool same = true;
+	for(uint32_t i=80;i<100;i++) same = same and range[i-80] == FibonacciNumber(i);
+	MATH_CHECK(same);
+	MATH_CHECK(FibonacciRange(0, 10, range.data()) == Status::Success and range[9] == 34);
+}
+
+static BigInteger Random(size_t limbs, std::mt19937 & random) {
+	BigInteger x(0);
+	for(size_t i=0;i<limbs;i++) x = (x << 32) + BigInteger(uint32_t(random()));
+	return random() & 1 ? -x : x;
+}
+
+// small operands against __int128, large ones through identities that mix the schoolbook and Karatsuba products //
+static void Arithmetic(std::mt19937 & random) {
+	std::uniform_int_distribution<int64_t> u(-(int64_t(1) << 62), int64_t(1) << 62);
+	bool small = true;
+	for(int k=0;k<2000;k++){
+		const int64_t a = u(random), b = k % 10 ? u(random) : int64_t(k % 3) - 1;
+		const BigInteger x(a), y(b);
+		const __int128 product = (__int128)a*b;
+		const BigInteger p = x*y;
+		small = small and (x + y).ToInt64() == a + b and (x - y).ToInt64() == a - b and x.Compare(y) == (a < b ? -1 : a > b ? 1 : 0);
+		small = small and (p - (BigInteger(int64_t(product >> 64)) << 64)) == BigInteger(uint64_t(product));
+		if( b ) small = small and BigInteger(p).DivideExact(y) == x;
+	}
+	MATH_CHECK(small);
+
+	bool large = true;
+	for(size_t limbs : {size_t(1), size_t(31), size_t(32), size_t(33), size_t(100), size_t(257)}){
+		const BigInteger a = Random(limbs, random), b = Random(limbs + limbs/3, random), c = Random(7, random);
+		const BigInteger square = (a + b)*(a + b) - (a - b)*(a - b), four = (a*b) << 2;
+		large = large and square == four and a*(b + c) == a*b + a*c and (a*b)*c == a*(b*c);
+		large = large and (a*b).DivideExact(b) == a and (-a).IsNegative() != a.IsNegative();
+	}
+	MATH_CHECK(large);
+
+	Status status = Status::Success;
+	MATH_CHECK((BigInteger(1) << 62).ToInt64(&status) == int64_t(1) << 62 and status == Status::Success);
+	MATH_CHECK((BigInteger(1) << 63).ToInt64(&status) == 0 and status == Status::Overflow);
+	MATH_CHECK(BigInteger(-1234567890123456789ll).ToString() == "-1234567890123456789" and BigInteger(0).ToString() == "0");
+	MATH_CHECK(BigInteger(0).IsZero() and !(-BigInteger(0)).IsNegative() and (BigInteger(1) << 100).Bits() == 101);
+}
+
+// exact values past uint64_t, Cassini's identity F(n-1)F(n+1) - F(n)^2 = (-1)^n, and the range against single values //
+static void Large() {
+	BigInteger f;
+	FibonacciNumber(100, f);
+	MATH_CHECK(f.ToString() == "354224848179261915075");
+	FibonacciNumber(FibonacciLimit, f);
+	MATH_CHECK(f == BigInteger(FibonacciNumber(FibonacciLimit)));
+
+	for(uint32_t n : {94u, 1000u, 20001u}){
+		BigInteger a, b, c;
+		FibonacciNumber(n-1, a);
+		FibonacciNumber(n, b);
+		FibonacciNumber(n+1, c);
+		MATH_CHECK(a*c - b*b == BigInteger(n % 2 ? -1 : 1));
+	}
+
+	std::vector<BigInteger> range(30);
+	FibonacciRange(90, 120, range.data());
+	bool same = true;
+	for(uint32_t i=90;i<120;i++){
+		FibonacciNumber(i, f);
+		same = same and range[i-90] == f;
+	}
+	MATH_CHECK(same);
+}
+
+int main() {
+	std::mt19937 random(67);
+	Sequence();
+	Arithmetic(random);
+	Large();
+	return Tests::Report("BigInteger");
+}
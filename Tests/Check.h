@@ -0,0 +1,44 @@
+#pragma once
+
+#ifndef MATH_TESTS_CHECK
+#define MATH_TESTS_CHECK
+
+#include <Math/Prefix.h>
+
+#include <cstdio>
+
+// every file under Tests is a program of its own, built with the repository root on the include path and Source/*.cc //
+// linked in, a run prints each failed check and exits non zero when there was any //
+namespace Math {
+	namespace Tests {
+		inline int & Failures() {
+			static int failures = 0;
+			return failures;
+		}
+
+		inline bool Check(bool ok, const char * what, const char * file, int line) {
+			if( !ok ){
+				std::printf("%s:%d: check failed: %s\n", file, line, what);
+				Failures()++;
+			}
+			return ok;
+		}
+
+		// |a - b| <= tolerance*max(1,|b|) //
+		template<typename T>
+		bool Near(T const & a, T const & b, double tolerance) {
+			const double d = Abs(double(a) - double(b)), m = Abs(double(b));
+			return d <= tolerance*(m > 1 ? m : 1);
+		}
+
+		inline int Report(const char * name) {
+			std::printf("%s: %d failure%s\n", name, Failures(), Failures() == 1 ? "" : "s");
+			return Failures() ? 1 : 0;
+		}
+	}
+}
+
+#define MATH_CHECK(x) Math::Tests::Check(bool(x), #x, __FILE__, __LINE__)
+#define MATH_CHECK_NEAR(a, b, tolerance) Math::Tests::Check(Math::Tests::Near(a, b, tolerance), #a " ~ " #b, __FILE__, __LINE__)
+
+#endif // ending MATH_TESTS_CHECK //
@@ -0,0 +1,150 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Complex.h>
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+template<typename T>
+static std::vector< std::complex<T> > Values(size_t count, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-4, 4);
+	std::vector< std::complex<T> > values(count);
+	for(auto & v : values) v = std::complex<T>(T(u(random)), T(u(random)));
+	return values;
+}
+
+template<typename T>
+static Complex::Buffer<T> Fill(const std::vector< std::complex<T> > & values, Complex::Layout layout) {
+	Complex::Buffer<T> buffer(values.size(), layout);
+	for(size_t i=0;i<values.size();i++) buffer.Set(i, Complex::Template<T>(values[i].real(), values[i].imag()));
+	return buffer;
+}
+
+template<typename T>
+static double Distance(const Complex::Buffer<T> & a, const std::vector< std::complex<T> > & b) {
+	double d = 0;
+	for(size_t i=0;i<b.size();i++) d = Max(d, Max(Abs(double(a[i][0]) - double(b[i].real())), Abs(double(a[i][1]) - double(b[i].imag()))));
+	return d;
+}
+
+// every kernel against std::complex, over each mix of layouts and counts around a register width //
+template<typename T>
+static void Kernels(size_t count, std::mt19937 & random, double tolerance) {
+	const Complex::Layout layouts[2] = {Complex::Layout::Split, Complex::Layout::Interleaved};
+	const auto x = Values<T>(count, random), y = Values<T>(count, random);
+	const std::complex<T> alpha(T(0.75), T(-1.25));
+
+	std::vector< std::complex<T> > product(count), cross(count), axpy(count);
+	std::complex<double> dot, inner;
+	for(size_t i=0;i<count;i++){
+		product[i] = x[i]*y[i];
+		cross[i] = x[i]*std::conj(y[i]);
+		axpy[i] = y[i] + alpha*x[i];
+		dot += std::complex<double>(x[i])*std::complex<double>(y[i]);
+		inner += std::conj(std::complex<double>(x[i]))*std::complex<double>(y[i]);
+	}
+	const double scale = tolerance*Max(1.0, double(count));
+
+	for(Complex::Layout la : layouts)
+		for(Complex::Layout lb : layouts)
+			for(Complex::Layout lo : layouts){
+				const Complex::Buffer<T> a = Fill(x, la), b = Fill(y, lb);
+				Complex::Buffer<T> out(0, lo);
+				Complex::Multiply(a, b, out);
+				MATH_CHECK(Distance(out, product) <= 16*tolerance);
+				Complex::MultiplyConjugate(a, b, out);
+				MATH_CHECK(Distance(out, cross) <= 16*tolerance);
+
+				Complex::Buffer<T> v = Fill(y, lo);
+				Complex::Axpy(Complex::Template<T>(alpha.real(), alpha.imag()), a, v);
+				MATH_CHECK(Distance(v, axpy) <= 16*tolerance);
+			}
+
+	for(Complex::Layout la : layouts)
+		for(Complex::Layout lb : layouts){
+			const Complex::Buffer<T> a = Fill(x, la), b = Fill(y, lb);
+			const Complex::Template<T> d = Complex::Dot(a, b), c = Complex::DotConjugate(a, b);
+			MATH_CHECK(Abs(double(d[0]) - dot.real()) <= 16*scale and Abs(double(d[1]) - dot.imag()) <= 16*scale);
+			MATH_CHECK(Abs(double(c[0]) - inner.real()) <= 16*scale and Abs(double(c[1]) - inner.imag()) <= 16*scale);
+		}
+
+	// the output may be one of the inputs //
+	Complex::Buffer<T> a = Fill(x, Complex::Layout::Split);
+	Complex::Multiply(a, Fill(y, Complex::Layout::Split), a);
+	MATH_CHECK(Distance(a, product) <= 16*tolerance);
+
+	for(Complex::Layout la : layouts){
+		const Complex::Buffer<T> a = Fill(x, la);
+		std::vector<T> magnitude(count), phase(count);
+		Complex::Magnitude(a, magnitude.data());
+		Complex::Phase(a, phase.data());
+		bool near = true;
+		for(size_t i=0;i<count;i++) near = near and Tests::Near(magnitude[i], std::abs(x[i]), tolerance) and Tests::Near(phase[i], std::arg(x[i]), 4*tolerance);
+		MATH_CHECK(near);
+	}
+}
+
+// the axes, zeros and infinities come out as std::atan2 has them, except the documented pi for a -0 imaginary part //
+// on the negative real axis, the scalar magnitude keeps the part type //
+template<typename T>
+static void Edges(double tolerance) {
+	const T infinity = std::numeric_limits<T>::infinity();
+	const std::vector< std::complex<T> > x = {
+		{T(1), T(0)}, {T(0), T(1)}, {T(-1), T(0)}, {T(0), T(-1)}, {T(0), T(0)}, {T(-0.0), T(0)},
+		{infinity, T(1)}, {-infinity, T(1)}, {T(1), infinity}, {T(-2), -infinity}, {infinity, infinity}, {T(-3), T(1e-30)}
+	};
+	std::vector<T> phase(x.size()), magnitude(x.size());
+	for(Complex::Layout layout : {Complex::Layout::Split, Complex::Layout::Interleaved}){
+		const Complex::Buffer<T> a = Fill(x, layout);
+		Complex::Phase(a, phase.data());
+		Complex::Magnitude(a, magnitude.data());
+		for(size_t i=0;i<x.size();i++){
+			MATH_CHECK(Tests::Near(phase[i], std::atan2(x[i].imag(), x[i].real()), tolerance));
+			MATH_CHECK(magnitude[i] == std::abs(x[i]) or Tests::Near(magnitude[i], std::abs(x[i]), tolerance));
+		}
+		const Complex::Buffer<T> axis = Fill(std::vector< std::complex<T> >(1, std::complex<T>(T(-1), T(-0.0))), layout);
+		Complex::Phase(axis, phase.data());
+		MATH_CHECK(Tests::Near(phase[0], Pi<T>(), tolerance));
+	}
+
+	// parts whose squares are past float range still have a finite double magnitude //
+	MATH_CHECK(Tests::Near(Complex::Template<T>(T(3), T(4)).Magnitude(), T(5), tolerance));
+	MATH_CHECK((Tests::Near(Complex::Template<double>(3e30, 4e30).Magnitude(), 5e30, 1e-15)));
+}
+
+// switching layout keeps the values, and copies keep both the values and the layout //
+template<typename T>
+static void Layouts(std::mt19937 & random) {
+	const auto x = Values<T>(37, random);
+	Complex::Buffer<T> a = Fill(x, Complex::Layout::Split);
+	a.Convert(Complex::Layout::Interleaved);
+	MATH_CHECK(a.GetLayout() == Complex::Layout::Interleaved and Distance(a, x) == 0);
+	bool data = true;
+	for(size_t i=0;i<x.size();i++) data = data and a.Data()[i] == a[i];
+	MATH_CHECK(data);
+	a.Convert(Complex::Layout::Split);
+	MATH_CHECK(a.GetLayout() == Complex::Layout::Split and Distance(a, x) == 0);
+
+	Complex::Buffer<T> b(5, Complex::Layout::Interleaved);
+	b = a;
+	MATH_CHECK(b.GetLayout() == Complex::Layout::Split and b.GetCount() == x.size() and Distance(b, x) == 0);
+	const Complex::Buffer<T> c(std::move(b));
+	MATH_CHECK(Distance(c, x) == 0 and b.GetCount() == 0);
+}
+
+int main() {
+	std::mt19937 random(37);
+	for(size_t count : {0, 1, 3, 7, 8, 9, 16, 17, 1001}){
+		Kernels<float>(count, random, 1e-5);
+		Kernels<double>(count, random, 1e-13);
+	}
+	Edges<float>(1e-6);
+	Edges<double>(1e-14);
+	Layouts<float>(random);
+	Layouts<double>(random);
+	return Tests::Report("Complex");
+}
@@ -0,0 +1,109 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <random>
+
+using namespace Math;
+
+// the expansion along the first row that Determinant used before the LU kernel, kept as the reference for small N //
+template<typename T, int N>
+struct Cofactor {
+	static T Of(const Matrix::Template<T,N,N> & M) {
+		T det = T();
+		for(int i=0;i<N;i++) det += (i%2 ? -1 : 1)*M[0][i]*Cofactor<T,N-1>::Of(M.Reduced(0,i));
+		return det;
+	}
+};
+
+template<typename T>
+struct Cofactor<T,1> {
+	static T Of(const Matrix::Template<T,1,1> & M) { return M[0][0]; }
+};
+
+template<typename T, int N>
+Matrix::Template<T,N,N> Random(std::mt19937 & random, int range) {
+	std::uniform_int_distribution<int> u(-range, range);
+	Matrix::Template<T,N,N> M;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) M[i][j] = T(u(random));
+	return M;
+}
+
+// |det| is at most the product of the row norms (Hadamard), the LU error is a small multiple of eps times that //
+template<typename T, int N>
+double Scale(const Matrix::Template<T,N,N> & M) {
+	double scale = 1;
+	for(int i=0;i<N;i++){
+		double row = 0;
+		for(int j=0;j<N;j++) row += double(M[i][j])*double(M[i][j]);
+		scale *= std::sqrt(row);
+	}
+	return scale;
+}
+
+template<int N>
+void Compare(std::mt19937 & random) {
+	for(int t=0;t<50;t++){
+		// small integers in doubles keep the cofactor sum exact, so it is the true determinant //
+		const Matrix::Template<double,N,N> M = Random<double,N>(random, 9);
+		const double det = Matrix::Determinant(M), exact = Cofactor<double,N>::Of(M);
+		MATH_CHECK(Abs(det - exact) <= 1e-12*Scale(M));
+
+		Matrix::Dynamic<double> D(M);
+		MATH_CHECK(Abs(Matrix::Determinant(D) - exact) <= 1e-12*Scale(M));
+
+		// integral entries take the exact path and agree to the last digit //
+		const Matrix::Template<int,N,N> I = Random<int,N>(random, 3);
+		MATH_CHECK((Matrix::Determinant(I) == Cofactor<int,N>::Of(I)));
+
+		Matrix::Template<float,N,N> F;
+		for(int i=0;i<N;i++)
+			for(int j=0;j<N;j++) F[i][j] = float(M[i][j]);
+		MATH_CHECK(Abs(double(Matrix::Determinant(F)) - exact) <= 1e-5*Scale(M));
+	}
+
+	// a repeated row is singular, exactly on the expansion and to rounding on LU //
+	Matrix::Template<double,N,N> S = Random<double,N>(random, 9);
+	if( N > 1 ){
+		for(int j=0;j<N;j++) S[N-1][j] = S[0][j];
+		MATH_CHECK((Abs(Matrix::Determinant(S)) <= 1e-12*Scale(S) and Cofactor<double,N>::Of(S) == 0));
+	}
+}
+
+// the closed forms at 2, 3 and 4 report an integral determinant that T cannot hold rather than wrap it //
+static void Overflow() {
+	Status status;
+	Matrix::Byte3x3 B(int8_t(0));
+	for(int i=0;i<3;i++) B[i][i] = 100;
+	MATH_CHECK(Matrix::Determinant(B, &status) == 0 and status == Status::Overflow);
+	for(int i=0;i<3;i++) B[i][i] = 5;
+	MATH_CHECK(Matrix::Determinant(B, &status) == 125 and status == Status::Success);
+
+	Matrix::UWord2x2 U(uint16_t(0));
+	U[0][1] = U[1][0] = 3;
+	MATH_CHECK(Matrix::Determinant(U, &status) == 0 and status == Status::Overflow);
+
+	Matrix::Long4x4 L(int64_t(0));
+	for(int i=0;i<4;i++) L[i][i] = int64_t(1) << 20;
+	MATH_CHECK(Matrix::Determinant(L, &status) == 0 and status == Status::Overflow);
+	L[3][3] = 4;
+	MATH_CHECK(Matrix::Determinant(L, &status) == int64_t(1) << 62 and status == Status::Success);
+
+	// entries large enough to overflow Kernel::Wide on the way still end in Overflow, not in a wrapped value //
+	for(int i=0;i<4;i++) L[i][i] = int64_t(1) << 62;
+	MATH_CHECK(Matrix::Determinant(L, &status) == 0 and status == Status::Overflow);
+}
+
+int main() {
+	std::mt19937 random(7);
+	Compare<1>(random);
+	Compare<2>(random);
+	Compare<3>(random);
+	Compare<4>(random);
+	Compare<5>(random);
+	Compare<6>(random);
+	Compare<7>(random);
+	Compare<8>(random);
+	Overflow();
+	return Tests::Report("Determinant");
+}
@@ -0,0 +1,132 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Eigen.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+template<typename T, int N>
+Matrix::Template<T,N,N> Random(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Template<T,N,N> M;
+	for(int i=0;i<N;i++)
+		for(int j=i;j<N;j++) M[i][j] = M[j][i] = T(u(random));
+	return M;
+}
+
+// Q diag(values) Q^T for a random rotation Q, so the spectrum is known up front //
+template<typename T>
+Matrix::Template<T,3,3> Spectrum(std::mt19937 & random, double a, double b, double c) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	double q[3][3];
+	for(int i=0;i<3;i++){
+		for(int k=0;k<3;k++) q[i][k] = u(random);
+		for(int j=0;j<i;j++){
+			double dot = 0;
+			for(int k=0;k<3;k++) dot += q[i][k]*q[j][k];
+			for(int k=0;k<3;k++) q[i][k] -= dot*q[j][k];
+		}
+		const double length = std::sqrt(q[i][0]*q[i][0] + q[i][1]*q[i][1] + q[i][2]*q[i][2]);
+		for(int k=0;k<3;k++) q[i][k] /= length;
+	}
+	const double values[3] = {a, b, c};
+	Matrix::Template<T,3,3> M;
+	for(int i=0;i<3;i++)
+		for(int j=0;j<3;j++){
+			double s = 0;
+			for(int k=0;k<3;k++) s += q[k][i]*values[k]*q[k][j];
+			M[i][j] = T(s);
+		}
+	return M;
+}
+
+// |M v - lambda v|, |V V^T - I| and the order of the values, all relative to the largest entry of M //
+template<typename T, int N>
+bool Holds(const Matrix::Template<T,N,N> & M, const Eigen::Decomposition<T,N> & d, double tolerance) {
+	double scale = 0;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) scale = Max(scale, Abs(double(M[i][j])));
+	if( scale == 0 ) scale = 1;
+
+	double residual = 0, orthogonal = 0;
+	bool sorted = true;
+	for(int i=0;i<N;i++){
+		if( i ) sorted = sorted and d.values[i-1] <= d.values[i];
+		for(int r=0;r<N;r++){
+			double s = -double(d.values[i])*double(d.vectors[i][r]);
+			for(int k=0;k<N;k++) s += double(M[r][k])*double(d.vectors[i][k]);
+			residual = Max(residual, Abs(s));
+		}
+		for(int j=0;j<N;j++){
+			double dot = i == j ? -1 : 0;
+			for(int k=0;k<N;k++) dot += double(d.vectors[i][k])*double(d.vectors[j][k]);
+			orthogonal = Max(orthogonal, Abs(dot));
+		}
+	}
+	return sorted and residual <= tolerance*scale and orthogonal <= tolerance;
+}
+
+template<typename T, int N>
+static void Jacobi(std::mt19937 & random, double tolerance) {
+	for(int k=0;k<50;k++){
+		const Matrix::Template<T,N,N> M = Random<T,N>(random);
+		MATH_CHECK((Holds(M, Eigen::Jacobi(M), tolerance)));
+	}
+}
+
+template<typename T>
+static void Symmetric(std::mt19937 & random, double tolerance) {
+	// the closed form against Jacobi on random input //
+	for(int k=0;k<200;k++){
+		const Matrix::Template<T,3,3> M = Random<T,3>(random);
+		const Eigen::Decomposition<T,3> d = Eigen::Symmetric(M), e = Eigen::Jacobi(M);
+		MATH_CHECK((Holds(M, d, tolerance)));
+		for(int i=0;i<3;i++) MATH_CHECK_NEAR(d.values[i], e.values[i], tolerance);
+	}
+
+	// repeated, nearly repeated and all equal eigenvalues, where the closed form hands over to Jacobi //
+	const double spectra[][3] = {{2, 2, 5}, {-1, 3, 3}, {4, 4, 4}, {1, 1 + 1e-9, 2}, {0, 0, 0}, {-1e3, 1e-3, 1e3}};
+	for(const auto & s : spectra){
+		const Matrix::Template<T,3,3> M = Spectrum<T>(random, s[0], s[1], s[2]);
+		const Eigen::Decomposition<T,3> d = Eigen::Symmetric(M);
+		MATH_CHECK((Holds(M, d, tolerance)));
+		for(int i=0;i<3;i++) MATH_CHECK_NEAR(d.values[i], T(s[i]), tolerance*Max(1.0, Abs(s[0]) + Abs(s[2])));
+	}
+}
+
+// the batch runs several matrices per register and has to agree with one at a time, tail and degenerate lanes included //
+template<typename T>
+static void Batched(std::mt19937 & random, double tolerance) {
+	const size_t count = 1001;
+	std::vector< Matrix::Template<T,3,3> > in(count);
+	for(size_t i=0;i<count;i++) in[i] = i % 7 == 3 ? Spectrum<T>(random, 1, 1, -2) : Random<T,3>(random);
+	std::vector< Eigen::Decomposition<T,3> > out(count);
+	Eigen::Symmetric(in.data(), out.data(), count);
+
+	bool same = true, holds = true;
+	for(size_t i=0;i<count;i++){
+		const Eigen::Decomposition<T,3> d = Eigen::Symmetric(in[i]);
+		holds = holds and Holds(in[i], out[i], tolerance);
+		for(int j=0;j<3;j++){
+			double dot = 0;
+			for(int k=0;k<3;k++) dot += double(d.vectors[j][k])*double(out[i].vectors[j][k]);
+			same = same and Tests::Near(out[i].values[j], d.values[j], tolerance) and Abs(Abs(dot) - 1) <= tolerance;
+		}
+	}
+	MATH_CHECK(holds);
+	MATH_CHECK(same);
+}
+
+int main() {
+	std::mt19937 random(31);
+	Jacobi<double,2>(random, 1e-13);
+	Jacobi<double,3>(random, 1e-13);
+	Jacobi<double,7>(random, 1e-13);
+	Jacobi<float,4>(random, 1e-5);
+	Symmetric<double>(random, 1e-9);
+	Symmetric<float>(random, 1e-4);
+	Batched<double>(random, 1e-9);
+	Batched<float>(random, 1e-4);
+	return Tests::Report("Eigen");
+}
@@ -0,0 +1,125 @@
+#include <Tests/Check.h>
+#include <Math/Elementary.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// |y - exact| in units of the spacing of T at exact //
+template<typename T>
+static double Ulp(T y, long double exact) {
+	if( std::isnan(exact) ) return std::isnan(y) ? 0 : std::numeric_limits<double>::infinity();
+	if( std::isinf(exact) or std::isinf(y) ) return y == exact ? 0 : std::numeric_limits<double>::infinity();
+	const T rounded = T(exact);
+	const long double spacing = std::isinf(std::nextafter(Abs(rounded), std::numeric_limits<T>::infinity())) ? std::numeric_limits<T>::max() - std::nextafter(std::numeric_limits<T>::max(), T(0)) : (long double)std::nextafter(Abs(rounded), std::numeric_limits<T>::infinity()) - Abs(rounded);
+	return double(Abs((long double)y - exact)/(spacing > 0 ? spacing : (long double)std::numeric_limits<T>::denorm_min()));
+}
+
+template<typename T, typename Batch, typename Exact>
+static double Worst(const std::vector<T> & in, Batch batch, Exact exact, Math::Batch::Accuracy accuracy) {
+	std::vector<T> out(in.size());
+	batch(in.data(), out.data(), in.size(), accuracy);
+	double worst = 0;
+	for(size_t i=0;i<in.size();i++) worst = Max(worst, Ulp(out[i], exact((long double)in[i])));
+	return worst;
+}
+
+template<typename T>
+static std::vector<T> Uniform(double lo, double hi, size_t count, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(lo, hi);
+	std::vector<T> values(count);
+	for(auto & v : values) v = T(u(random));
+	return values;
+}
+
+// each function against long double libm inside the polynomial domain and past it, within the bounds the header quotes //
+// plus half an ULP for the rounding of the reference, Fast within twice its bound //
+template<typename T>
+static void Bounds(std::mt19937 & random, double fastExp, double fastLog, double fastTrig, double fastArcTan) {
+	typedef Math::Batch::Accuracy Accuracy;
+	const size_t count = 100003;
+	const double limit = Math::Batch::Kernel::Domain<T>::Trigonometric();
+
+	const auto exp = [](long double x) { return std::exp(x); };
+	const auto log = [](long double x) { return std::log(x); };
+	const auto sin = [](long double x) { return std::sin(x); };
+	const auto cos = [](long double x) { return std::cos(x); };
+	const auto atan = [](long double x) { return std::atan(x); };
+	const auto Exp = [](const T * in, T * out, size_t n, Accuracy a) { Math::Batch::Exp(in, out, n, a); };
+	const auto Log = [](const T * in, T * out, size_t n, Accuracy a) { Math::Batch::Log(in, out, n, a); };
+	const auto Sin = [](const T * in, T * out, size_t n, Accuracy a) { Math::Batch::Sin(in, out, n, a); };
+	const auto Cos = [](const T * in, T * out, size_t n, Accuracy a) { Math::Batch::Cos(in, out, n, a); };
+	const auto ArcTan = [](const T * in, T * out, size_t n, Accuracy a) { Math::Batch::ArcTan(in, out, n, a); };
+
+	const auto exponent = Uniform<T>(Math::Batch::Kernel::Domain<T>::ExpLow(), Math::Batch::Kernel::Domain<T>::ExpHigh(), count, random);
+	const auto positive = Uniform<T>(-30, 30, count, random), angle = Uniform<T>(-limit, limit, count, random), small = Uniform<T>(-4, 4, count, random);
+	std::vector<T> logarithm(count), tangent(count);
+	for(size_t i=0;i<count;i++) logarithm[i] = T(std::exp(double(positive[i]))), tangent[i] = T(std::sinh(double(positive[i])));
+
+	MATH_CHECK(Worst(exponent, Exp, exp, Accuracy::Precise) <= 2.0);
+	MATH_CHECK(Worst(logarithm, Log, log, Accuracy::Precise) <= 1.5);
+	MATH_CHECK(Worst(angle, Sin, sin, Accuracy::Precise) <= 3.0 and Worst(small, Sin, sin, Accuracy::Precise) <= 3.0);
+	MATH_CHECK(Worst(angle, Cos, cos, Accuracy::Precise) <= 3.0 and Worst(small, Cos, cos, Accuracy::Precise) <= 3.0);
+	MATH_CHECK(Worst(tangent, ArcTan, atan, Accuracy::Precise) <= 3.0 and Worst(small, ArcTan, atan, Accuracy::Precise) <= 3.0);
+
+	MATH_CHECK(Worst(exponent, Exp, exp, Accuracy::Fast) <= 2*fastExp);
+	MATH_CHECK(Worst(logarithm, Log, log, Accuracy::Fast) <= 2*fastLog);
+	MATH_CHECK(Worst(small, Sin, sin, Accuracy::Fast) <= 2*fastTrig and Worst(small, Cos, cos, Accuracy::Fast) <= 2*fastTrig);
+	MATH_CHECK(Worst(tangent, ArcTan, atan, Accuracy::Fast) <= 2*fastArcTan);
+
+	// SinCos is Sin and Cos at once, bit for bit //
+	std::vector<T> s(count), c(count), sine(count), cosine(count);
+	Math::Batch::SinCos(angle.data(), s.data(), c.data(), count);
+	Math::Batch::Sin(angle.data(), sine.data(), count);
+	Math::Batch::Cos(angle.data(), cosine.data(), count);
+	MATH_CHECK(s == sine and c == cosine);
+}
+
+// lanes outside the polynomial domain go to libm, so they match std:: exactly, whatever lane of a register they sit in //
+template<typename T>
+static void Edges() {
+	const T infinity = std::numeric_limits<T>::infinity(), nan = std::numeric_limits<T>::quiet_NaN();
+	const T limit = Math::Batch::Kernel::Domain<T>::Trigonometric();
+	const std::vector<T> in = {
+		T(0), T(-0.0), T(1), infinity, -infinity, nan, T(-1), std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::min(),
+		std::numeric_limits<T>::max(), T(1000), T(-1000), T(4)*limit, T(-3)*limit, T(0.5), T(2)
+	};
+	const size_t n = in.size();
+	std::vector<T> e(n), l(n), s(n), c(n), a(n);
+	Math::Batch::Exp(in.data(), e.data(), n);
+	Math::Batch::Log(in.data(), l.data(), n);
+	Math::Batch::Sin(in.data(), s.data(), n);
+	Math::Batch::Cos(in.data(), c.data(), n);
+	Math::Batch::ArcTan(in.data(), a.data(), n);
+
+	const auto same = [](T x, T y) { return (std::isnan(x) and std::isnan(y)) or x == y; };
+	bool libm = true;
+	for(size_t i=0;i<n;i++){
+		const T x = in[i];
+		if( !(x >= Math::Batch::Kernel::Domain<T>::ExpLow() and x <= Math::Batch::Kernel::Domain<T>::ExpHigh()) ) libm = libm and same(e[i], std::exp(x));
+		if( !(x >= std::numeric_limits<T>::min() and x <= std::numeric_limits<T>::max()) ) libm = libm and same(l[i], std::log(x));
+		if( !(x >= -limit and x <= limit) ) libm = libm and same(s[i], std::sin(x)) and same(c[i], std::cos(x));
+		if( std::isnan(x) ) libm = libm and std::isnan(a[i]);
+	}
+	MATH_CHECK(libm);
+	MATH_CHECK(e[0] == T(1) and l[2] == T(0) and s[0] == T(0) and c[0] == T(1) and a[0] == T(0));
+	MATH_CHECK(a[3] == Pi<T>()/T(2) and a[4] == -Pi<T>()/T(2));
+
+	// out may be in //
+	std::vector<T> x = {T(0.25), T(-0.75), T(3), T(5), T(7), T(-9), T(11), T(13), T(15)}, y(x.size());
+	Math::Batch::Exp(x.data(), y.data(), x.size());
+	Math::Batch::Exp(x.data(), x.data(), x.size());
+	MATH_CHECK(x == y);
+}
+
+int main() {
+	std::mt19937 random(47);
+	Bounds<float>(random, 256, 8, 128, 32);
+	Bounds<double>(random, 1 << 21, 1 << 17, 1 << 17, 1 << 20);
+	Edges<float>();
+	Edges<double>();
+	return Tests::Report("Elementary");
+}
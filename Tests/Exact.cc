@@ -0,0 +1,96 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Matrix.h>
+#include <Math/Algebra/Exact.h>
+
+#include <random>
+
+using namespace Math;
+
+// 99 I + J, det = 99^(n-1) (99 + n), 9990198504 for n = 5, beyond int8_t and int32_t //
+template<typename T>
+Matrix::Template<T,5,5> Spiked() {
+	Matrix::Template<T,5,5> M;
+	for(int i=0;i<5;i++)
+		for(int j=0;j<5;j++) M[i][j] = T(i == j ? 100 : 1);
+	return M;
+}
+
+static void Narrowing() {
+	Status status;
+	MATH_CHECK(Matrix::Determinant(Spiked<int8_t>(), &status) == 0 and status == Status::Overflow);
+	MATH_CHECK(Matrix::Determinant(Spiked<int32_t>(), &status) == 0 and status == Status::Overflow);
+	MATH_CHECK(Matrix::Determinant(Spiked<int64_t>(), &status) == 9990198504LL and status == Status::Success);
+	MATH_CHECK(Matrix::Determinant(Spiked<int8_t>()) == 0);
+
+	Matrix::Dynamic<int16_t> D(Spiked<int16_t>());
+	MATH_CHECK(Matrix::Determinant(D, &status) == 0 and status == Status::Overflow);
+	Matrix::Dynamic<int64_t> W(Spiked<int64_t>());
+	MATH_CHECK(Matrix::Determinant(W, &status) == 9990198504LL and status == Status::Success);
+}
+
+static void Nullspace() {
+	std::mt19937 random(5);
+	std::uniform_int_distribution<int> entry(-9, 9);
+	for(int trial=0;trial<200;trial++){
+		// rank at most 4 by construction, rows 4 and 5 are combinations of the first ones //
+		const int m = 6, n = 7;
+		Matrix::Dynamic<int> M(m, n);
+		for(int i=0;i<4;i++)
+			for(int j=0;j<n;j++) M(i,j) = entry(random);
+		for(int j=0;j<n;j++){
+			M(4,j) = 2*M(0,j) - M(3,j);
+			M(5,j) = M(1,j) + 3*M(2,j);
+		}
+
+		Status status;
+		const int rank = Matrix::Exact::Rank(M, &status);
+		MATH_CHECK(status == Status::Success and rank <= 4);
+		const auto basis = Matrix::Exact::Nullspace(M, &status);
+		MATH_CHECK(status == Status::Success and int(basis.size()) == n - rank);
+		for(const auto & x : basis){
+			bool zero = true, trivial = true;
+			for(int i=0;i<m;i++){
+				Matrix::Kernel::Wide s = 0;
+				for(int j=0;j<n;j++) s += Matrix::Kernel::Wide(M(i,j))*x[j];
+				zero = zero and s == 0;
+			}
+			for(int j=0;j<n;j++) trivial = trivial and x[j] == 0;
+			MATH_CHECK(zero and !trivial);
+		}
+	}
+}
+
+static void Determinants() {
+	std::mt19937 random(9);
+	std::uniform_int_distribution<int> entry(-50, 50);
+	for(int trial=0;trial<200;trial++){
+		Matrix::Template<int,6,6> M;
+		for(int i=0;i<6;i++)
+			for(int j=0;j<6;j++) M[i][j] = entry(random);
+		const BigInteger big = Matrix::Exact::Determinant<BigInteger>(M);
+		Status status;
+		const Matrix::Kernel::Wide wide = Matrix::Exact::Determinant(M, &status);
+		MATH_CHECK(status == Status::Success and big == BigInteger(int64_t(wide)));
+		// int holds the smaller ones, the rest must be reported rather than wrapped //
+		const int det = Matrix::Determinant(M, &status);
+		if( wide == Matrix::Kernel::Wide(int(wide)) ) MATH_CHECK(det == wide and status == Status::Success);
+		else MATH_CHECK(det == 0 and status == Status::Overflow);
+	}
+
+	// a diagonal of 2^40 gives minors near 2^200, past int64_t but not BigInteger //
+	Matrix::Template<int64_t,5,5> B;
+	for(int i=0;i<5;i++)
+		for(int j=0;j<5;j++) B[i][j] = i == j ? int64_t(1) << 40 : int64_t(i+j);
+	Status status;
+	Matrix::Exact::Determinant<int64_t>(B, &status);
+	MATH_CHECK(status == Status::Overflow);
+	Matrix::Exact::Determinant<BigInteger>(B, &status);
+	MATH_CHECK(status == Status::Success);
+}
+
+int main() {
+	Narrowing();
+	Nullspace();
+	Determinants();
+	return Tests::Report("Exact");
+}
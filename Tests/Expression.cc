@@ -0,0 +1,107 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Vector.h>
+#include <Math/Algebra/Matrix.h>
+
+using namespace Math;
+
+// an element that counts how it is made, every Template made whole default constructs its lanes once //
+struct Counted {
+	static int & Defaults() { static int n = 0; return n; }
+	static int & Copies() { static int n = 0; return n; }
+
+	Counted(): x(0) { Defaults()++; }
+	Counted(double x): x(x) {}
+	Counted(const Counted & c): x(c.x) { Copies()++; }
+	Counted & operator = (const Counted & c) { x = c.x; return *this; }
+
+	Counted & operator += (const Counted & c) { x += c.x; return *this; }
+	Counted & operator -= (const Counted & c) { x -= c.x; return *this; }
+	Counted & operator *= (const Counted & c) { x *= c.x; return *this; }
+	Counted & operator /= (const Counted & c) { x /= c.x; return *this; }
+	friend Counted operator + (const Counted & a, const Counted & b) { return Counted(a.x + b.x); }
+	friend Counted operator - (const Counted & a, const Counted & b) { return Counted(a.x - b.x); }
+	friend Counted operator * (const Counted & a, const Counted & b) { return Counted(a.x * b.x); }
+	friend Counted operator / (const Counted & a, const Counted & b) { return Counted(a.x / b.x); }
+	bool operator != (const Counted & c) const { return x != c.x; }
+	bool operator == (const Counted & c) const { return x == c.x; }
+
+	double x;
+};
+
+static void Reset() { Counted::Defaults() = 0, Counted::Copies() = 0; }
+
+static void Vectors() {
+	typedef Vector::Template<Counted,4> V;
+	V A{1,2,3,4}, B{5,6,7,8}, C{9,10,11,12};
+
+	// one whole vector for the result, the three temporaries of eager evaluation are gone //
+	Reset();
+	V D = A + B*Counted(2) - C;
+	MATH_CHECK(Counted::Defaults() == 4);
+	for(int i=0;i<4;i++) MATH_CHECK(D[i].x == A[i].x + 2*B[i].x - C[i].x);
+
+	// into an existing vector nothing is made whole at all //
+	Reset();
+	D = A + B*Counted(2) - C;
+	MATH_CHECK(Counted::Defaults() == 0);
+
+	// the same expression evaluated eagerly, a temporary per operator //
+	Reset();
+	V t = B;
+	t *= Counted(2);
+	V s = A;
+	s += t;
+	s -= C;
+	const int eager = Counted::Copies();
+	MATH_CHECK(s == D);
+
+	// lazily the leaves are read in place, only the scalar rides along in the nodes //
+	Reset();
+	D = A + B*Counted(2) - C;
+	MATH_CHECK(Counted::Copies() < 4);
+	MATH_CHECK(eager >= 2*4);
+	std::printf("A + B*2 - C on 4 lanes: %d element copies eager, %d lazy\n", eager, Counted::Copies());
+
+	// a node may read the vector it is assigned to //
+	D = D + A;
+	for(int i=0;i<4;i++) MATH_CHECK(D[i].x == 2*A[i].x + 2*B[i].x - C[i].x);
+
+	// dot products of nodes fuse as well //
+	Reset();
+	const Counted dot = (A + B)*(A - C);
+	MATH_CHECK(Counted::Defaults() == 0);
+	MATH_CHECK(dot.x == 6*(-8) + 8*(-8) + 10*(-8) + 12*(-8));
+}
+
+static void Matrices() {
+	typedef Matrix::Template<Counted,3,3> M;
+	M P, Q, R;
+	for(int i=0;i<3;i++)
+		for(int j=0;j<3;j++) P[i][j] = Counted(i+j), Q[i][j] = Counted(i*j), R[i][j] = Counted(i-j);
+
+	Reset();
+	M S = P + Q*Counted(2) - R;
+	MATH_CHECK(Counted::Defaults() == 9);
+	for(int i=0;i<3;i++)
+		for(int j=0;j<3;j++) MATH_CHECK(S[i][j].x == double(i+j) + 2*double(i*j) - double(i-j));
+
+	Reset();
+	S = P + Q*Counted(2) - R;
+	MATH_CHECK(Counted::Defaults() == 0);
+}
+
+static void Packed() {
+	// the SIMD path gives the same numbers as element wise arithmetic, padding lanes included //
+	Vector::Template<double,3> a{1,2,3}, b{4,5,6}, c{7,8,9};
+	const Vector::Template<double,3> d = a + b*2.0 - c/4.0;
+	for(int i=0;i<3;i++) MATH_CHECK(d[i] == a[i] + b[i]*2.0 - c[i]/4.0);
+	MATH_CHECK((&d)[3] == 0.0);
+	MATH_CHECK(Abs((a + b)*(a - c) - (5*-6 + 7*-6 + 9*-6)) == 0);
+}
+
+int main() {
+	Vectors();
+	Matrices();
+	Packed();
+	return Tests::Report("Expression");
+}
@@ -0,0 +1,98 @@
+#include <Tests/Check.h>
+#include <Math/FFT.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// direct sum in long double, the reference every transform is held to //
+static std::vector< Complex::Template<long double> > Direct(const std::vector< Complex::Template<double> > & x, int sign) {
+	const size_t n = x.size();
+	std::vector< Complex::Template<long double> > X(n);
+	for(size_t k=0;k<n;k++){
+		long double re = 0, im = 0;
+		for(size_t j=0;j<n;j++){
+			const long double a = sign*2*Pi<long double>()*(long double)((j*k)%n)/(long double)n;
+			const long double c = std::cos(a), s = std::sin(a);
+			re += x[j][0]*c - x[j][1]*s;
+			im += x[j][0]*s + x[j][1]*c;
+		}
+		X[k] = Complex::Template<long double>(re, im);
+	}
+	return X;
+}
+
+static double Error(const std::vector< Complex::Template<double> > & a, const std::vector< Complex::Template<long double> > & b) {
+	long double error = 0, scale = 0;
+	for(size_t i=0;i<a.size();i++){
+		error = std::max(error, std::fabs(a[i][0] - b[i][0]) + std::fabs(a[i][1] - b[i][1]));
+		scale = std::max(scale, std::fabs(b[i][0]) + std::fabs(b[i][1]));
+	}
+	return double(error/(scale > 1 ? scale : 1));
+}
+
+static std::vector< Complex::Template<double> > Random(size_t n, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::vector< Complex::Template<double> > x(n);
+	for(auto & v : x) v = Complex::Template<double>(u(random), u(random));
+	return x;
+}
+
+int main() {
+	std::mt19937 random(3);
+
+	// radix 2, 3 and 4 passes, the generic butterfly for 5 to 61, Bluestein for 67 and up //
+	const size_t sizes[] = {1, 2, 3, 4, 5, 6, 7, 8, 12, 15, 16, 30, 49, 60, 61, 64, 67, 97, 100, 128, 210, 243, 256, 331, 1000, 1024, 1031};
+	for(size_t n : sizes){
+		const auto x = Random(n, random);
+		auto y = x;
+		FFT::Forward(y.data(), n);
+		MATH_CHECK(Error(y, Direct(x, -1)) < 1e-12);
+
+		// Inverse undoes Forward //
+		auto z = x;
+		FFT::Forward(z.data(), n);
+		FFT::Inverse(z.data(), n);
+		double round = 0;
+		for(size_t i=0;i<n;i++) round = std::max(round, std::fabs(z[i][0] - x[i][0]) + std::fabs(z[i][1] - x[i][1]));
+		MATH_CHECK(round < 1e-12);
+
+		// real input against the complex transform of the same samples //
+		std::vector<double> real(n), back(n);
+		std::vector< Complex::Template<double> > half(n/2 + 1), full(n);
+		for(size_t i=0;i<n;i++) real[i] = x[i][0], full[i] = Complex::Template<double>(x[i][0], 0);
+		FFT::ForwardReal(real.data(), half.data(), n);
+		const auto reference = Direct(full, -1);
+		half.resize(n/2 + 1);
+		MATH_CHECK(Error(half, std::vector< Complex::Template<long double> >(reference.begin(), reference.begin() + n/2 + 1)) < 1e-12);
+		FFT::InverseReal(half.data(), back.data(), n);
+		double error = 0;
+		for(size_t i=0;i<n;i++) error = std::max(error, std::fabs(back[i] - real[i]));
+		MATH_CHECK(error < 1e-12);
+	}
+
+	// 2D equals the row transforms followed by the column transforms //
+	const size_t rows = 12, columns = 20;
+	auto x = Random(rows*columns, random), y = x;
+	FFT::Forward2D(y.data(), rows, columns);
+	std::vector< Complex::Template<double> > line(columns), column(rows);
+	for(size_t r=0;r<rows;r++){
+		for(size_t c=0;c<columns;c++) line[c] = x[r*columns+c];
+		const auto X = Direct(line, -1);
+		for(size_t c=0;c<columns;c++) x[r*columns+c] = Complex::Template<double>(double(X[c][0]), double(X[c][1]));
+	}
+	std::vector< Complex::Template<long double> > expected(rows*columns);
+	for(size_t c=0;c<columns;c++){
+		for(size_t r=0;r<rows;r++) column[r] = x[r*columns+c];
+		const auto X = Direct(column, -1);
+		for(size_t r=0;r<rows;r++) expected[r*columns+c] = X[r];
+	}
+	MATH_CHECK(Error(y, expected) < 1e-12);
+	FFT::Inverse2D(y.data(), rows, columns);
+	FFT::Forward2D(y.data(), rows, columns);
+	MATH_CHECK(Error(y, expected) < 1e-12);
+
+	return Tests::Report("FFT");
+}
@@ -0,0 +1,81 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/GEMM.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// C = alpha*A*B + beta*C in long double over the same strided blocks //
+template<typename T>
+static void Reference(int m, int n, int k, T alpha, const T * A, int lda, const T * B, int ldb, T beta, T * C, int ldc) {
+	for(int i=0;i<m;i++)
+		for(int j=0;j<n;j++){
+			long double s = 0;
+			for(int p=0;p<k;p++) s += (long double)A[size_t(i)*lda+p]*B[size_t(p)*ldb+j];
+			C[size_t(i)*ldc+j] = T(alpha*s + (beta == T(0) ? 0 : (long double)beta*C[size_t(i)*ldc+j]));
+		}
+}
+
+// shapes on either side of the register tile and the panel depth, with padded leading dimensions whose padding must survive //
+template<typename T>
+static void Shapes(std::mt19937 & random, double tolerance) {
+	typedef Matrix::Kernel::Blocking<T> Blocking;
+	std::uniform_real_distribution<double> u(-1, 1);
+	const int MR = Blocking::MR, NR = Blocking::NR, KC = Blocking::KC, MC = Blocking::MC;
+	const int sizes[][3] = {
+		{1, 1, 1}, {MR, NR, 1}, {MR-1, NR+1, 3}, {MR+1, NR-1, KC}, {2*MR+3, 3*NR+1, KC+1}, {MC+5, 2*NR+3, 2*KC+7}, {37, 1, 19}, {1, 45, 23}, {7, 9, 0}
+	};
+	const T nan = std::numeric_limits<T>::quiet_NaN();
+	const T scalars[][2] = {{T(1), T(0)}, {T(-0.5), T(2)}, {T(0), T(0.25)}, {T(1.5), T(1)}};
+
+	for(const auto & s : sizes){
+		const int m = s[0], n = s[1], k = s[2], lda = k+3, ldb = n+2, ldc = n+5;
+		std::vector<T> A(size_t(m)*lda), B(size_t(k > 0 ? k : 1)*ldb), C(size_t(m)*ldc);
+		for(auto & a : A) a = T(u(random));
+		for(auto & b : B) b = T(u(random));
+		for(const auto & ab : scalars){
+			for(auto & c : C) c = T(u(random));
+			// beta of zero overwrites whatever C held, NaN included //
+			if( ab[1] == T(0) ) C[0] = nan;
+			std::vector<T> R(C), D(C);
+			Reference(m, n, k, ab[0], A.data(), lda, B.data(), ldb, ab[1], R.data(), ldc);
+			Matrix::Gemm(m, n, k, ab[0], A.data(), lda, B.data(), ldb, ab[1], D.data(), ldc);
+
+			bool near = true, padding = true;
+			for(int i=0;i<m;i++){
+				for(int j=0;j<n;j++) near = near and Abs(double(D[size_t(i)*ldc+j]) - double(R[size_t(i)*ldc+j])) <= tolerance*(1 + k);
+				for(int j=n;j<ldc;j++) padding = padding and D[size_t(i)*ldc+j] == C[size_t(i)*ldc+j];
+			}
+			MATH_CHECK(near);
+			MATH_CHECK(padding);
+		}
+	}
+}
+
+// the split across workers keeps the accumulation order, so any thread count gives the same bits //
+static void Threads(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	const int m = 301, n = 259, k = 283;
+	std::vector<double> A(size_t(m)*k), B(size_t(k)*n), C(size_t(m)*n), D(size_t(m)*n);
+	for(auto & a : A) a = u(random);
+	for(auto & b : B) b = u(random);
+	for(size_t i=0;i<C.size();i++) C[i] = D[i] = u(random);
+
+	const unsigned threads = Parallel::Threads();
+	Parallel::Configure(1);
+	Matrix::Gemm(m, n, k, 1.25, A.data(), k, B.data(), n, -0.5, C.data(), n);
+	Parallel::Configure(4);
+	Matrix::Gemm(m, n, k, 1.25, A.data(), k, B.data(), n, -0.5, D.data(), n);
+	Parallel::Configure(threads);
+	MATH_CHECK(C == D);
+}
+
+int main() {
+	std::mt19937 random(59);
+	Shapes<double>(random, 1e-15);
+	Shapes<float>(random, 1e-6);
+	Threads(random);
+	return Tests::Report("GEMM");
+}
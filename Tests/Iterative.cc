@@ -0,0 +1,140 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Iterative.h>
+
+#include <vector>
+
+using namespace Math;
+
+// 5 point Laplacian on a k x k grid, plus a first order term of strength c that makes it non symmetric when c is not 0 //
+static Matrix::Sparse<double> Grid(int k, double c) {
+	std::vector< Matrix::Triplet<double> > triplets;
+	for(int i=0;i<k;i++)
+		for(int j=0;j<k;j++){
+			const int r = i*k+j;
+			triplets.push_back(Matrix::Triplet<double>{r, r, 4.0});
+			if( i > 0 ) triplets.push_back(Matrix::Triplet<double>{r, r-k, -1.0 - c});
+			if( i+1 < k ) triplets.push_back(Matrix::Triplet<double>{r, r+k, -1.0 + c});
+			if( j > 0 ) triplets.push_back(Matrix::Triplet<double>{r, r-1, -1.0});
+			if( j+1 < k ) triplets.push_back(Matrix::Triplet<double>{r, r+1, -1.0});
+		}
+	return Matrix::Sparse<double>(k*k, k*k, triplets);
+}
+
+// |b - A x|/|b| recomputed from scratch rather than as the method tracked it //
+static double Residual(const Matrix::Sparse<double> & A, const Vector::Dynamic<double> & b, const Vector::Dynamic<double> & x) {
+	Vector::Dynamic<double> r = b;
+	Matrix::Multiply(A, &x, &r, -1.0, 1.0);
+	double rr = 0, bb = 0;
+	for(int i=0;i<b.GetSize();i++) rr += r[i]*r[i], bb += b[i]*b[i];
+	return std::sqrt(rr/bb);
+}
+
+static bool Decreasing(const std::vector<double> & history) {
+	for(size_t i=1;i<history.size();i++)
+		if( history[i] > history[i-1]*(1 + 1e-12) ) return false;
+	return true;
+}
+
+static void Symmetric() {
+	const int k = 40, n = k*k;
+	const Matrix::Sparse<double> A = Grid(k, 0.0);
+	Vector::Dynamic<double> b(n);
+	for(int i=0;i<n;i++) b[i] = double((i*7919)%13) - 6;
+	const Iterative::Settings<double> settings(1e-10, 2000);
+
+	Vector::Dynamic<double> x;
+	const auto plain = Iterative::CG(A, Iterative::Identity<double>(size_t(n)), b, x, settings);
+	MATH_CHECK(plain.converged and Residual(A, b, x) < 1e-9);
+	MATH_CHECK(plain.history.size() == plain.iterations + 1);
+
+	Vector::Dynamic<double> y;
+	const auto jacobi = Iterative::CG(A, Iterative::Jacobi<double>(A), b, y, settings);
+	MATH_CHECK(jacobi.converged and Residual(A, b, y) < 1e-9);
+
+	// the incomplete factor of a diagonally dominant M matrix never breaks down and cuts the iterations //
+	const Iterative::IncompleteCholesky<double> ichol(A);
+	MATH_CHECK(ichol.GetStatus() == Status::Success);
+	Vector::Dynamic<double> z;
+	const auto incomplete = Iterative::CG(A, ichol, b, z, settings);
+	MATH_CHECK(incomplete.converged and Residual(A, b, z) < 1e-9);
+	MATH_CHECK(incomplete.iterations < plain.iterations);
+
+	// a solution already in x converges at once //
+	const auto again = Iterative::CG(A, ichol, b, z, settings);
+	MATH_CHECK(again.converged and again.iterations <= 1);
+}
+
+static void General() {
+	const int k = 30, n = k*k;
+	const Matrix::Sparse<double> A = Grid(k, 0.4);
+	Vector::Dynamic<double> b(n, 1.0);
+	const Iterative::Settings<double> settings(1e-10, 2000, 20);
+
+	Vector::Dynamic<double> x;
+	const auto bicgstab = Iterative::BiCGSTAB(A, Iterative::Jacobi<double>(A), b, x, settings);
+	MATH_CHECK(bicgstab.converged and Residual(A, b, x) < 1e-9);
+
+	// restarted GMRES minimizes the residual over a growing space, it never goes up //
+	Vector::Dynamic<double> y;
+	const auto gmres = Iterative::GMRES(A, Iterative::Jacobi<double>(A), b, y, settings);
+	MATH_CHECK(gmres.converged and Residual(A, b, y) < 1e-9);
+	MATH_CHECK(Decreasing(gmres.history));
+
+	// any callable is an operator, here the same matrix through the raw pointer entry point and a kept workspace //
+	Iterative::Workspace<double> workspace;
+	Vector::Dynamic<double> w(n, 0.0), v(n, 0.0);
+	auto product = [&A](const double * in, double * out) { Matrix::Multiply(A, in, out); };
+	const auto first = Iterative::GMRES(product, Iterative::Identity<double>(size_t(n)), &b, &w, size_t(b.GetSize()), settings, &workspace);
+	const auto second = Iterative::GMRES(product, Iterative::Identity<double>(size_t(n)), &b, &v, size_t(b.GetSize()), settings, &workspace);
+	MATH_CHECK(first.converged and second.iterations == first.iterations);
+	bool same = true;
+	for(int i=0;i<n;i++) same = same and w[i] == v[i];
+	MATH_CHECK(same);
+
+	// on a stronger first order term the BiCGSTAB recurrence drifts below the tolerance ahead of b - A x, converged means the true one //
+	const int m = 80;
+	const Matrix::Sparse<double> C = Grid(m, 0.8);
+	Vector::Dynamic<double> c(m*m, 1.0), u;
+	const auto drift = Iterative::BiCGSTAB(C, Iterative::Jacobi<double>(C), c, u, Iterative::Settings<double>(1e-10, 2000));
+	MATH_CHECK(drift.converged and Residual(C, c, u) <= 1e-10 and Tests::Near(drift.residual, Residual(C, c, u), 1e-3));
+}
+
+// solves started from Parallel workers wait on nested loops of their own, and a waiting thread runs other queued solves, //
+// so each has to keep its vectors to itself: every answer is checked against the true residual //
+static void Concurrent() {
+	const int n = 200000, solves = 16;
+	std::vector< Matrix::Triplet<double> > triplets;
+	for(int r=0;r<n;r++){
+		triplets.push_back(Matrix::Triplet<double>{r, r, 4.0});
+		if( r > 0 ) triplets.push_back(Matrix::Triplet<double>{r, r-1, -1.0});
+		if( r+1 < n ) triplets.push_back(Matrix::Triplet<double>{r, r+1, -1.0});
+	}
+	const Matrix::Sparse<double> A(n, n, triplets);
+	std::vector< Vector::Dynamic<double> > b(solves), x(solves);
+	std::vector<char> converged(solves);
+	for(int s=0;s<solves;s++){
+		b[s] = Vector::Dynamic<double>(n);
+		for(int i=0;i<n;i++) b[s][i] = double((i*(s+3))%17) - 8;
+	}
+
+	const unsigned threads = Parallel::Threads();
+	Parallel::Configure(4);
+	Parallel::For(0, solves, 1, [&](size_t first, size_t last) {
+		for(size_t s=first;s<last;s++){
+			const auto report = Iterative::CG(A, Iterative::Identity<double>(size_t(n)), b[s], x[s], Iterative::Settings<double>(1e-10, 200, 30, false));
+			converged[s] = report.converged;
+		}
+	});
+	Parallel::Configure(threads);
+
+	bool solved = true;
+	for(int s=0;s<solves;s++) solved = solved and converged[s] and Residual(A, b[s], x[s]) < 1e-9;
+	MATH_CHECK(solved);
+}
+
+int main() {
+	Symmetric();
+	General();
+	Concurrent();
+	return Tests::Report("Iterative");
+}
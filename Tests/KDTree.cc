@@ -0,0 +1,97 @@
+#include <Tests/Check.h>
+#include <Math/Geometry/KDTree.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+template<uint32_t space>
+static std::vector< Geometry::Point<double,space> > Points(size_t count, std::mt19937 & random, bool grid) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::uniform_int_distribution<int> g(0, 3);
+	std::vector< Geometry::Point<double,space> > points(count);
+	for(auto & p : points)
+		for(uint32_t d=0;d<space;d++) p[d] = grid ? double(g(random)) : u(random);
+	return points;
+}
+
+// every query against a scan of all the points, the k nearest by distance only since ties may come in any order //
+template<uint32_t space>
+static void Compare(size_t count, std::mt19937 & random, bool grid) {
+	typedef Geometry::KDTree<double,space> Tree;
+	const auto points = Points<space>(count, random, grid), queries = Points<space>(64, random, false);
+	const Tree tree(points);
+	MATH_CHECK(tree.GetCount() == count);
+
+	const size_t k = 5;
+	bool nearest = true, radius = true, box = true;
+	for(const auto & q : queries){
+		std::vector<double> distances(count);
+		for(size_t i=0;i<count;i++) distances[i] = points[i].GetDistanceSquared(q);
+		std::vector<double> sorted(distances);
+		std::sort(sorted.begin(), sorted.end());
+
+		const auto found = tree.Nearest(q, k);
+		nearest = nearest and found.size() == Min(k, count);
+		for(size_t j=0;j<found.size();j++)
+			nearest = nearest and found[j].distance == sorted[j] and distances[found[j].index] == found[j].distance;
+		if( count ) nearest = nearest and tree.Nearest(q).distance == sorted[0];
+
+		const double r = 0.5;
+		auto within = tree.Radius(q, r);
+		std::vector<uint32_t> indices, expected;
+		for(const auto & n : within) indices.push_back(n.index), radius = radius and n.distance <= r*r;
+		for(size_t i=0;i<count;i++)
+			if( distances[i] <= r*r ) expected.push_back(uint32_t(i));
+		std::sort(indices.begin(), indices.end());
+		radius = radius and indices == expected;
+
+		Geometry::Point<double,space> lo, hi;
+		for(uint32_t d=0;d<space;d++) lo[d] = q[d] - 0.4, hi[d] = q[d] + 0.6;
+		auto inside = tree.Box(lo, hi);
+		expected.clear();
+		for(size_t i=0;i<count;i++){
+			bool in = true;
+			for(uint32_t d=0;d<space;d++) in = in and lo[d] <= points[i][d] and points[i][d] <= hi[d];
+			if( in ) expected.push_back(uint32_t(i));
+		}
+		std::sort(inside.begin(), inside.end());
+		box = box and inside == expected;
+	}
+	MATH_CHECK(nearest);
+	MATH_CHECK(radius);
+	MATH_CHECK(box);
+
+	// the batch forms split the queries across workers and have to match one at a time, padding included //
+	std::vector<typename Tree::Neighbour> rows(queries.size()*k);
+	tree.Nearest(queries.data(), queries.size(), k, rows.data());
+	const auto balls = tree.Radius(queries.data(), queries.size(), 0.5);
+	bool batch = true;
+	for(size_t i=0;i<queries.size();i++){
+		const auto one = tree.Nearest(queries[i], k);
+		for(size_t j=0;j<k;j++){
+			if( j < one.size() ) batch = batch and rows[i*k+j].distance == one[j].distance;
+			else batch = batch and rows[i*k+j].index == Tree::None;
+		}
+		batch = batch and balls[i].size() == tree.Radius(queries[i], 0.5).size();
+	}
+	MATH_CHECK(batch);
+}
+
+int main() {
+	std::mt19937 random(41);
+	Compare<2>(0, random, false);
+	Compare<2>(1, random, false);
+	Compare<2>(7, random, false);
+	Compare<2>(1000, random, false);
+	// many equal coordinates, the medians fall inside runs of ties //
+	Compare<2>(1000, random, true);
+	Compare<3>(5000, random, false);
+	Compare<3>(800, random, true);
+	Compare<7>(3000, random, false);
+	// large enough that the top levels are partitioned across workers //
+	Compare<2>(40000, random, false);
+	return Tests::Report("KDTree");
+}
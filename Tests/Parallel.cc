@@ -0,0 +1,98 @@
+#include <Tests/Check.h>
+#include <Math/Parallel.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Math;
+
+// every index is visited exactly once, however the range is chunked and whatever runs it //
+static void Cover(unsigned threads) {
+	Parallel::Configure(threads);
+	MATH_CHECK(Parallel::Threads() == threads);
+	for(size_t count : {size_t(0), size_t(1), size_t(7), size_t(1000), size_t(100003)}){
+		std::vector<std::atomic<int>> visits(count);
+		for(auto & v : visits) v.store(0);
+		Parallel::For(0, count, 16, [&](size_t first, size_t last) {
+			for(size_t i=first;i<last;i++) visits[i].fetch_add(1);
+		});
+		bool once = true;
+		for(auto & v : visits) once = once and v.load() == 1;
+		MATH_CHECK(once);
+	}
+
+	// nested loops run inside workers, which help rather than block while they wait //
+	std::atomic<size_t> total(0);
+	Parallel::For(0, 64, 1, [&](size_t first, size_t last) {
+		for(size_t i=first;i<last;i++)
+			Parallel::For(0, 100, 10, [&](size_t a, size_t b) { total.fetch_add(b - a); });
+	});
+	MATH_CHECK(total.load() == 6400);
+
+	// the exception of a chunk reaches the caller, after every chunk when the pool ran them //
+	std::atomic<size_t> done(0);
+	bool thrown = false;
+	try {
+		Parallel::For(0, 1000, 10, [&](size_t first, size_t last) {
+			done.fetch_add(last - first);
+			if( first <= 500 and 500 < last ) throw std::runtime_error("chunk");
+		});
+	}
+	catch(const std::runtime_error &) { thrown = true; }
+	MATH_CHECK(thrown and (threads == 1 or done.load() == 1000));
+}
+
+// deterministic mode cuts chunks by grain alone, so a floating sum gives the same bits on any thread count //
+static void Deterministic() {
+	std::vector<double> x(100000);
+	for(size_t i=0;i<x.size();i++) x[i] = 1.0/double(i+1) * (i % 3 ? 1 : -1);
+	const auto sum = [&]() {
+		return Parallel::Reduce(0, x.size(), 1000, 0.0, [&](size_t first, size_t last) {
+			double s = 0;
+			for(size_t i=first;i<last;i++) s += x[i];
+			return s;
+		}, [](double a, double b) { return a + b; });
+	};
+
+	Parallel::SetDeterministic(true);
+	MATH_CHECK(Parallel::IsDeterministic() and Parallel::Chunk(x.size(), 1000) == 1000);
+	Parallel::Configure(1);
+	const double one = sum();
+	Parallel::Configure(3);
+	const double three = sum();
+	Parallel::Configure(8);
+	const double eight = sum();
+	Parallel::SetDeterministic(false);
+	MATH_CHECK(one == three and one == eight);
+	MATH_CHECK(Parallel::Chunk(x.size(), 1000) >= 1000 and Parallel::Chunk(10, 0) >= 1);
+}
+
+// Threads and Chunk are read from many threads at once without a lock, while loops run on the pool //
+static void Concurrent() {
+	Parallel::Configure(4);
+	std::atomic<bool> same(true);
+	std::vector<std::thread> readers;
+	for(int t=0;t<4;t++)
+		readers.emplace_back([&]() {
+			for(int k=0;k<20000;k++)
+				if( Parallel::Threads() != 4 or Parallel::Chunk(4000, 1) != 250 ) same.store(false);
+			std::atomic<size_t> n(0);
+			Parallel::For(0, 10000, 100, [&](size_t first, size_t last) { n.fetch_add(last - first); });
+			if( n.load() != 10000 ) same.store(false);
+		});
+	for(auto & reader : readers) reader.join();
+	MATH_CHECK(same.load());
+}
+
+int main() {
+	const unsigned threads = Parallel::Threads();
+	Cover(1);
+	Cover(2);
+	Cover(5);
+	Deterministic();
+	Concurrent();
+	Parallel::Configure(threads);
+	return Tests::Report("Parallel");
+}
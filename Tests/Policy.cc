@@ -0,0 +1,80 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <random>
+
+using namespace Math;
+
+// both TransformInto paths finish every element the way the policy says, whichever kernel computed it //
+template<int N>
+void Transform(std::mt19937 & random) {
+	std::uniform_int_distribution<int> u(-9, 9);
+	Matrix::Template<double,N,N> A, B, exact, snapped;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) A[i][j] = 0.1*u(random), B[i][j] = double(u(random));
+	// 0.6 + 0.3 + 0.1 sums to 1 - 2^-53, one element that only a snapping policy moves //
+	A[0][0] = 0.6, A[0][1] = 0.3, A[0][2] = 0.1;
+	for(int k=0;k<N;k++) B[k][0] = k < 3 ? 1.0 : 0.0;
+
+	Matrix::TransformInto<Policy::Exact>(exact, A, B);
+	Matrix::TransformInto<Policy::Snapped>(snapped, A, B);
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++){
+			double e = exact[i][j];
+			MATH_CHECK(snapped[i][j] == AutoCorrect(e));
+		}
+	MATH_CHECK(exact[0][0] < 1.0 and snapped[0][0] == 1.0);
+}
+
+// the closed forms up to 4x4 and Invert past it finish the inverse the same way under every policy //
+template<int N>
+void Inverse(std::mt19937 & random) {
+	std::uniform_int_distribution<int> u(-3, 3);
+	for(int t=0;t<20;t++){
+		// a unit lower times a unit upper triangle is unimodular, a tenth of it has ten times a whole matrix as inverse //
+		Matrix::Template<double,N,N> L, U, A, exact, snapped;
+		for(int i=0;i<N;i++)
+			for(int j=0;j<N;j++) L[i][j] = i == j ? 1.0 : i > j ? double(u(random)) : 0.0, U[i][j] = i == j ? 1.0 : i < j ? double(u(random)) : 0.0;
+		A = Matrix::Transform<Policy::Exact>(L, U);
+		for(int i=0;i<N;i++)
+			for(int j=0;j<N;j++) A[i][j] *= 0.1;
+
+		MATH_CHECK(Matrix::InverseInto<Policy::Exact>(exact, A) == Status::Success);
+		MATH_CHECK(Matrix::InverseInto<Policy::Snapped>(snapped, A) == Status::Success);
+		bool same = true;
+		for(int i=0;i<N;i++)
+			for(int j=0;j<N;j++){
+				double e = exact[i][j];
+				same = same and snapped[i][j] == AutoCorrect(e);
+			}
+		MATH_CHECK(same);
+	}
+}
+
+// a rotation built at compile time holds the same snapped entries as one built at run time //
+static void Rotation() {
+#ifndef MATH_NO_CONSTANT_EVALUATED
+	constexpr Matrix::Template<double,3,3> fixed = Matrix::Rotate::Z<double,Policy::Snapped>(Pi<double>()/2);
+	double angle = Pi<double>()/2;
+	const Matrix::Template<double,3,3> computed = Matrix::Rotate::Z<double,Policy::Snapped>(angle);
+	bool same = true;
+	for(int i=0;i<3;i++)
+		for(int j=0;j<3;j++) same = same and fixed[i][j] == computed[i][j];
+	MATH_CHECK(same and fixed[0][0] == 0.0 and fixed[1][0] == 1.0);
+#endif
+}
+
+int main() {
+	std::mt19937 random(17);
+	Transform<4>(random);
+	Transform<8>(random);
+	// at and past Matrix::TransformKernelThreshold the product goes through Gemm //
+	Transform<16>(random);
+	Transform<24>(random);
+	Inverse<2>(random);
+	Inverse<3>(random);
+	Inverse<4>(random);
+	Inverse<5>(random);
+	Rotation();
+	return Tests::Report("Policy");
+}
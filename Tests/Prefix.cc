@@ -0,0 +1,67 @@
+#include <Tests/Check.h>
+#include <Math/Prefix.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace Math;
+
+// past the Pascal rows Choose is plain constexpr arithmetic on any compiler //
+static_assert(Choose(68, 34) == 0 and Choose(100, 2) == 4950, "Choose past the Pascal rows");
+
+// the rest needs a compiler that tells constant evaluation apart, or MATH_CONSTANT_EVALUATED() defined as true //
+#ifndef MATH_NO_CONSTANT_EVALUATED
+static_assert(Choose(10, 3) == 120 and Choose(3, 10) == 120 and Choose(67, 33) == 14226520737620288370ull, "Choose in a constant expression");
+constexpr double sine = Sin(0.5), cosine = Cos(0.5);
+static_assert(sine > 0.4794255386 and sine < 0.4794255387 and cosine > 0.8775825618 and cosine < 0.8775825619, "Sin and Cos in a constant expression");
+// the constant path is finished under the policy like the run time one, so a right angle gives exact zeros when snapping //
+constexpr double right = Cos<double,Policy::Snapped>(Pi<double>()/2), straight = Sin<double,Policy::Snapped>(Pi<double>());
+static_assert(right == 0.0 and straight == 0.0 and Cos<double,Policy::Exact>(Pi<double>()/2) != 0.0, "Sin and Cos snap in a constant expression");
+#endif
+
+// the table, the multiplicative steps and the rows agree at run time, and report overflow the same way //
+static void Binomial() {
+	bool same = true;
+	for(uint32_t n=0;n<=80;n++){
+		std::vector<uint64_t> row(n+1);
+		const Status status = ChooseRow(n, row.data());
+		bool overflow = false;
+		for(uint32_t k=0;k<=n;k++){
+			Status s = Status::Success;
+			const uint64_t c = Choose(n, k, &s);
+			// Pascal's rule from the previous row where it fits //
+			if( k and k < n and s == Status::Success ){
+				Status t = Status::Success, u = Status::Success;
+				const uint64_t a = Choose(n-1, k-1, &t), b = Choose(n-1, k, &u);
+				if( t == Status::Success and u == Status::Success ) same = same and c == a + b;
+			}
+			same = same and row[k] == c and (s == Status::Overflow) == (c == 0);
+			overflow = overflow or s == Status::Overflow;
+		}
+		same = same and (status == Status::Overflow) == overflow and (overflow == (n > PascalRows));
+	}
+	MATH_CHECK(same);
+}
+
+static void Trigonometry() {
+	bool near = true;
+	for(int i=-200;i<=200;i++){
+		const double x = 0.05*i;
+		near = near and Tests::Near(Sin(x), std::sin(x), 1e-14) and Tests::Near(Cos(x), std::cos(x), 1e-14);
+	}
+	MATH_CHECK(near);
+
+	// compile time and run time agree wherever snapping decides the value //
+	double quarter = Pi<double>()/2, half = Pi<double>();
+	MATH_CHECK((Cos<double,Policy::Snapped>(quarter) == 0.0 and Sin<double,Policy::Snapped>(half) == 0.0 and Sin<double,Policy::Snapped>(quarter) == 1.0));
+#ifndef MATH_NO_CONSTANT_EVALUATED
+	constexpr double one = Sin<double,Policy::Snapped>(Pi<double>()/2), minus = Cos<double,Policy::Snapped>(Pi<double>());
+	MATH_CHECK((one == 1.0 and minus == -1.0 and right == Cos<double,Policy::Snapped>(quarter)));
+#endif
+}
+
+int main() {
+	Binomial();
+	Trigonometry();
+	return Tests::Report("Prefix");
+}
@@ -0,0 +1,151 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Quaternion.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+static Vector::Template<double,3> Axis(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Vector::Template<double,3> a;
+	double length = 0;
+	while( length < 1e-3 ){
+		for(int i=0;i<3;i++) a[i] = u(random);
+		length = std::sqrt(a[0]*a[0] + a[1]*a[1] + a[2]*a[2]);
+	}
+	for(int i=0;i<3;i++) a[i] /= length;
+	return a;
+}
+
+static Quaternion::Double Random(std::mt19937 & random) {
+	std::uniform_real_distribution<double> angle(-Pi<double>(), Pi<double>());
+	return Quaternion::AxisAngle(Axis(random), angle(random));
+}
+
+static double Distance(const Vector::Template<double,3> & a, const Vector::Template<double,3> & b) {
+	return Max(Abs(a[0] - b[0]), Max(Abs(a[1] - b[1]), Abs(a[2] - b[2])));
+}
+
+// q and -q are the same rotation //
+static double Distance(const Quaternion::Double & a, const Quaternion::Double & b) {
+	double plus = 0, minus = 0;
+	for(int i=0;i<4;i++) plus = Max(plus, Abs(a[i] - b[i])), minus = Max(minus, Abs(a[i] + b[i]));
+	return Min(plus, minus);
+}
+
+static Vector::Template<double,3> Apply(const Matrix::Template<double,3,3> & R, const Vector::Template<double,3> & v) {
+	Vector::Template<double,3> out;
+	for(int i=0;i<3;i++) out[i] = R[i][0]*v[0] + R[i][1]*v[1] + R[i][2]*v[2];
+	return out;
+}
+
+// rotating by a quaternion matches its matrix and the matrix of the same axis and angle, products compose right to left //
+static void Rotations(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1), angle(-Pi<double>(), Pi<double>());
+	bool matrix = true, compose = true, inverse = true, round = true;
+	for(int k=0;k<200;k++){
+		const Vector::Template<double,3> axis = Axis(random), v{u(random), u(random), u(random)};
+		const double theta = angle(random);
+		const Quaternion::Double q = Quaternion::AxisAngle(axis, theta), p = Random(random);
+		const Matrix::Template<double,3,3> R = Quaternion::ToMatrix(q), A = Matrix::Rotate::AxisAngle(axis, theta);
+		matrix = matrix and Distance(q.Rotate(v), Apply(R, v)) < 1e-14 and Distance(q.Rotate(v), Apply(A, v)) < 1e-14;
+		compose = compose and Distance((q*p).Rotate(v), q.Rotate(p.Rotate(v))) < 1e-14;
+		inverse = inverse and Distance(q.Inverse().Rotate(q.Rotate(v)), v) < 1e-14 and Distance(q*q.Inverse(), Quaternion::Double()) < 1e-15;
+		round = round and Distance(Quaternion::FromMatrix(R), q) < 1e-14 and Distance(Quaternion::FromMatrix(Quaternion::ToMatrixDim4(q)), q) < 1e-14;
+	}
+	MATH_CHECK(matrix);
+	MATH_CHECK(compose);
+	MATH_CHECK(inverse);
+	MATH_CHECK(round);
+
+	// half turns put every branch of FromMatrix on a zero or negative trace //
+	bool turns = true;
+	for(int i=0;i<3;i++){
+		Vector::Template<double,3> axis{0, 0, 0};
+		axis[i] = 1;
+		const Quaternion::Double q = Quaternion::AxisAngle(axis, Pi<double>());
+		turns = turns and Distance(Quaternion::FromMatrix(Quaternion::ToMatrix(q)), q) < 1e-15;
+	}
+	MATH_CHECK(turns);
+	MATH_CHECK(Quaternion::Double(0, 0, 0, 0).Inverse() == Quaternion::Double(0, 0, 0, 0));
+}
+
+// Slerp turns at a constant rate along the shorter arc and meets both ends, Nlerp stays on the path //
+static void Interpolation(std::mt19937 & random) {
+	bool ends = true, rate = true, shorter = true, near = true;
+	for(int k=0;k<100;k++){
+		const Vector::Template<double,3> axis = Axis(random);
+		const Quaternion::Double a = Random(random), turn = Quaternion::AxisAngle(axis, 2.0), b = turn*a;
+		ends = ends and Distance(Quaternion::Slerp(a, b, 0.0), a) < 1e-14 and Distance(Quaternion::Slerp(a, b, 1.0), b) < 1e-14;
+		for(double t : {0.1, 0.25, 0.5, 0.9}){
+			rate = rate and Distance(Quaternion::Slerp(a, b, t), Quaternion::AxisAngle(axis, 2.0*t)*a) < 1e-13;
+			shorter = shorter and Distance(Quaternion::Slerp(a, -b, t), Quaternion::Slerp(a, b, t)) < 1e-13;
+			const Quaternion::Double n = Quaternion::Nlerp(a, b, t);
+			near = near and Abs(n.Norm() - 1) < 1e-14 and Distance(n, Quaternion::Slerp(a, b, t)) < 0.05;
+		}
+		// nearly equal ends take the chord //
+		const Quaternion::Double c = Quaternion::AxisAngle(axis, 1e-9)*a;
+		ends = ends and Distance(Quaternion::Slerp(a, c, 0.5), Quaternion::AxisAngle(axis, 0.5e-9)*a) < 1e-14;
+	}
+	MATH_CHECK(ends);
+	MATH_CHECK(rate);
+	MATH_CHECK(shorter);
+	MATH_CHECK(near);
+}
+
+// the structure of arrays kernels against the scalar ones, over a count that leaves a partial register //
+template<typename T>
+static void Batches(std::mt19937 & random, double tolerance) {
+	std::uniform_real_distribution<double> u(-2, 2);
+	const size_t count = 1003;
+	std::vector< Quaternion::Template<T> > a(count), b(count);
+	std::vector< Vector::Template<T,3> > v(count);
+	for(size_t i=0;i<count;i++){
+		const Quaternion::Double p = Random(random), q = Random(random);
+		a[i] = Quaternion::Template<T>(T(p[0]), T(p[1]), T(p[2]), T(p[3]));
+		b[i] = Quaternion::Template<T>(T(q[0]), T(q[1]), T(q[2]), T(q[3]));
+		for(int c=0;c<3;c++) v[i][c] = T(u(random));
+	}
+	const Quaternion::Batch<T> A(a.data(), count), B(b.data(), count);
+	const Vector::Batch<T,3> V(v.data(), count);
+
+	Quaternion::Batch<T> C;
+	Quaternion::Compose(A, B, C);
+	Vector::Batch<T,3> W, U = V;
+	Quaternion::Rotate(A, V, W);
+	Quaternion::Rotate(a[7], U, U);
+
+	bool compose = true, rotate = true, one = true;
+	for(size_t i=0;i<count;i++){
+		const Quaternion::Template<T> c = a[i]*b[i];
+		const Vector::Template<T,3> w = a[i].Rotate(v[i]), u = a[7].Rotate(v[i]);
+		for(int k=0;k<4;k++) compose = compose and Abs(double(C[i][k]) - double(c[k])) <= tolerance;
+		for(int k=0;k<3;k++){
+			rotate = rotate and Abs(double(W[i][k]) - double(w[k])) <= tolerance;
+			one = one and Abs(double(U[i][k]) - double(u[k])) <= tolerance;
+		}
+	}
+	MATH_CHECK(compose);
+	MATH_CHECK(rotate);
+	MATH_CHECK(one);
+
+	// drifted quaternions back to unit length, zero to the identity //
+	Quaternion::Batch<T> D = C;
+	for(size_t i=0;i<count;i++) D.Set(i, C[i]*T(1.5));
+	D.Set(3, Quaternion::Template<T>(0, 0, 0, 0));
+	Quaternion::Normalize(D);
+	bool unit = D[3] == Quaternion::Template<T>();
+	for(size_t i=0;i<count;i++)
+		if( i != 3 ) unit = unit and Abs(double(D[i].Norm()) - 1) <= tolerance and Abs(double(D[i][0]) - double(C[i][0])) <= tolerance;
+	MATH_CHECK(unit);
+}
+
+int main() {
+	std::mt19937 random(43);
+	Rotations(random);
+	Interpolation(random);
+	Batches<double>(random, 1e-14);
+	Batches<float>(random, 1e-5);
+	return Tests::Report("Quaternion");
+}
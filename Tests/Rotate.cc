@@ -0,0 +1,128 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+template<typename T>
+static Vector::Template<T,3> Axis(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	double a[3] = {}, length = 0;
+	while( length < 1e-3 ){
+		for(int i=0;i<3;i++) a[i] = u(random);
+		length = std::sqrt(a[0]*a[0] + a[1]*a[1] + a[2]*a[2]);
+	}
+	Vector::Template<T,3> axis;
+	for(int i=0;i<3;i++) axis[i] = T(a[i]/length);
+	return axis;
+}
+
+template<typename A, typename B>
+static double Distance(const A & a, const B & b, int n) {
+	double d = 0;
+	for(int i=0;i<n;i++)
+		for(int j=0;j<n;j++) d = Max(d, Abs(double(a[i][j]) - double(b[i][j])));
+	return d;
+}
+
+// I + sin(angle)*K + (1 - cos(angle))*K*K with K the cross product matrix of the axis //
+template<typename T>
+static Matrix::Template<double,3,3> Rodrigues(const Vector::Template<T,3> & axis, double angle) {
+	const double x = axis[0], y = axis[1], z = axis[2];
+	const double K[3][3] = {{0, -z, y}, {z, 0, -x}, {-y, x, 0}};
+	const double s = std::sin(angle), t = 1 - std::cos(angle);
+	Matrix::Template<double,3,3> R;
+	for(int i=0;i<3;i++)
+		for(int j=0;j<3;j++){
+			double kk = 0;
+			for(int k=0;k<3;k++) kk += K[i][k]*K[k][j];
+			R[i][j] = double(i == j) + s*K[i][j] + t*kk;
+		}
+	return R;
+}
+
+// the homogeneous row and column of a 4x4 rotation are those of the identity //
+template<typename T>
+static bool Homogeneous(const Matrix::Template<T,4,4> & R) {
+	return R[0][3] == T(0) and R[1][3] == T(0) and R[2][3] == T(0) and R[3][0] == T(0) and R[3][1] == T(0) and R[3][2] == T(0) and R[3][3] == T(1);
+}
+
+// the closed forms against the products and formulas they replace, the 4x4 forms against the 3x3 ones //
+static void Scalar(std::mt19937 & random) {
+	std::uniform_real_distribution<double> angle(-Pi<double>(), Pi<double>());
+	bool euler = true, axis = true, homogeneous = true;
+	for(int k=0;k<200;k++){
+		const double yaw = angle(random), pitch = angle(random), roll = angle(random);
+		using namespace Matrix::Rotate;
+		const Matrix::Template<double,3,3> product = Matrix::Transform(Z(yaw), Matrix::Transform(Y(pitch), X(roll)));
+		const Matrix::Template<double,3,3> R = Euler(yaw, pitch, roll);
+		const Matrix::Template<double,4,4> H = EulerDim4(yaw, pitch, roll);
+		euler = euler and Distance(R, product, 3) < 1e-14 and Distance(H, R, 3) < 1e-15;
+
+		const Vector::Template<double,3> u = Axis<double>(random);
+		const double theta = angle(random);
+		const Matrix::Template<double,3,3> A = AxisAngle(u, theta);
+		const Matrix::Template<double,4,4> B = AxisAngleDim4(u, theta);
+		axis = axis and Distance(A, Rodrigues(u, theta), 3) < 1e-14 and Distance(B, A, 3) < 1e-15;
+
+		homogeneous = homogeneous and Homogeneous(H) and Homogeneous(B);
+	}
+	MATH_CHECK(euler);
+	MATH_CHECK(axis);
+	MATH_CHECK(homogeneous);
+
+	// about the coordinate axes AxisAngle is X, Y and Z //
+	const double theta = 0.7;
+	const Vector::Template<double,3> ex = {1, 0, 0}, ey = {0, 1, 0}, ez = {0, 0, 1};
+	MATH_CHECK(Distance(Matrix::Rotate::AxisAngle(ex, theta), Matrix::Rotate::X(theta), 3) < 1e-15);
+	MATH_CHECK(Distance(Matrix::Rotate::AxisAngle(ey, theta), Matrix::Rotate::Y(theta), 3) < 1e-15);
+	MATH_CHECK(Distance(Matrix::Rotate::AxisAngle(ez, theta), Matrix::Rotate::Z(theta), 3) < 1e-15);
+}
+
+// the batch forms agree with the scalar ones over several blocks, a ragged tail and a parallel split //
+template<typename T, int N>
+static void Batches(std::mt19937 & random, double tolerance, double fast) {
+	std::uniform_real_distribution<double> angle(-Pi<double>(), Pi<double>());
+	const size_t count = Vector::Kernel::BatchGrain*2 + 3*Matrix::Rotate::BatchBlock + 17;
+	std::vector<T> yaw(count), pitch(count), roll(count), theta(count);
+	std::vector< Vector::Template<T,3> > axis(count);
+	for(size_t i=0;i<count;i++){
+		yaw[i] = T(angle(random)), pitch[i] = T(angle(random)), roll[i] = T(angle(random)), theta[i] = T(angle(random));
+		axis[i] = Axis<T>(random);
+	}
+	std::vector< Matrix::Template<T,N,N> > euler(count), rotation(count), quick(count);
+	Matrix::Rotate::Euler(yaw.data(), pitch.data(), roll.data(), euler.data(), count);
+	Matrix::Rotate::AxisAngle(axis.data(), theta.data(), rotation.data(), count);
+	Matrix::Rotate::Euler(yaw.data(), pitch.data(), roll.data(), quick.data(), count, Math::Batch::Accuracy::Fast);
+
+	double e = 0, a = 0, f = 0;
+	bool homogeneous = true;
+	for(size_t i=0;i<count;i++){
+		const Matrix::Template<T,3,3> R = Matrix::Rotate::Euler<T,Policy::Exact>(yaw[i], pitch[i], roll[i]);
+		e = Max(e, Distance(euler[i], R, 3));
+		f = Max(f, Distance(quick[i], R, 3));
+		a = Max(a, Distance(rotation[i], Matrix::Rotate::AxisAngle<T,Policy::Exact>(axis[i], theta[i]), 3));
+		for(int r=3;r<N;r++)
+			for(int c=0;c<N;c++) homogeneous = homogeneous and euler[i][r][c] == T(r == c) and euler[i][c][r] == T(r == c) and rotation[i][r][c] == T(r == c) and rotation[i][c][r] == T(r == c);
+	}
+	MATH_CHECK(e <= tolerance);
+	MATH_CHECK(a <= tolerance);
+	MATH_CHECK(f <= fast);
+	MATH_CHECK(homogeneous);
+}
+
+int main() {
+	std::mt19937 random(29);
+	Scalar(random);
+	const unsigned threads = Parallel::Threads();
+	Parallel::Configure(4);
+	Batches<double,3>(random, 1e-14, 1e-6);
+	Batches<double,4>(random, 1e-14, 1e-6);
+	Batches<float,3>(random, 1e-5, 1e-4);
+	Batches<float,4>(random, 1e-5, 1e-4);
+	Parallel::Configure(threads);
+	return Tests::Report("Rotate");
+}
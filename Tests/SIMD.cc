@@ -0,0 +1,190 @@
+#include <Tests/Check.h>
+#include <Math/SIMD.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// the native width, which has intrinsic specializations on x86, lane for lane against plain loops over three lanes //
+template<typename T>
+static void Lanes(std::mt19937 & random) {
+	typedef Simd::Pack<T> P;
+	typedef Simd::Pack<T,1> S;
+	const int L = P::Lanes();
+	std::uniform_real_distribution<double> u(-100, 100);
+	const T nan = std::numeric_limits<T>::quiet_NaN();
+
+	bool same = true;
+	for(int k=0;k<1000;k++){
+		alignas(64) T x[16], y[16], z[16];
+		for(int l=0;l<L;l++) x[l] = T(u(random)), y[l] = T(u(random)), z[l] = T(u(random));
+		if( k % 5 == 0 ) x[k % L] = T(std::floor(x[k % L])) + T(0.5);
+		if( k % 7 == 0 ) y[k % L] = nan;
+		const P a = P::Load(x), b = P::Load(y), c = P::Load(z);
+		const P round = Simd::Round(a), power = Simd::Power2(Simd::Round(a*P(T(0.5)))), root = Simd::Sqrt(Simd::Abs(a));
+		const P low = Simd::Min(a, c), high = Simd::Max(a, c), fused = Simd::MultiplyAdd(a, c, b*c);
+		const P less = Simd::Select(Simd::Less(a, c), P(T(1)), P(T(0))), outside = Simd::Select(Simd::Outside(b, P(T(-50)), P(T(50))), P(T(1)), P(T(0)));
+		P exponent;
+		const P mantissa = Simd::Mantissa(Simd::Abs(a) + P(T(1)), exponent);
+
+		for(int l=0;l<L;l++){
+			const S s = S(x[l]), v = S(z[l]);
+			S e;
+			const S m = Simd::Mantissa(Simd::Abs(s) + S(T(1)), e);
+			same = same and round[l] == Simd::Round(s)[0] and power[l] == Simd::Power2(Simd::Round(s*S(T(0.5))))[0];
+			same = same and root[l] == Simd::Sqrt(Simd::Abs(s))[0] and low[l] == Simd::Min(s, v)[0] and high[l] == Simd::Max(s, v)[0];
+			same = same and mantissa[l] == m[0] and exponent[l] == e[0] and m[0] >= T(0.5) and m[0] < T(1);
+			same = same and less[l] == (x[l] < z[l] ? T(1) : T(0)) and outside[l] == (y[l] >= T(-50) and y[l] <= T(50) ? T(0) : T(1));
+			same = same and (std::isnan(y[l]) ? std::isnan(fused[l]) : Abs(double(fused[l]) - (double(x[l])*z[l] + double(y[l])*z[l])) <= 1e-4*(1 + Abs(double(y[l])*z[l])));
+		}
+		same = same and Simd::Any(Simd::Less(a, c)) == (Simd::Sum(less) > T(0));
+	}
+	MATH_CHECK(same);
+
+	// ties go to the even neighbour //
+	const T ties[4] = {T(0.5), T(1.5), T(2.5), T(-2.5)}, even[4] = {T(0), T(2), T(2), T(-2)};
+	bool tie = true;
+	for(int i=0;i<4;i++) tie = tie and Simd::Round(P(ties[i]))[0] == even[i];
+	MATH_CHECK(tie);
+
+	// gather by index, sum of every lane, streaming stores land once fenced //
+	std::vector<T> base(64);
+	for(size_t i=0;i<base.size();i++) base[i] = T(i)*T(0.25);
+	int index[16];
+	for(int l=0;l<L;l++) index[l] = (l*13 + 5) % 64;
+	const P gathered = Simd::Gather<T,Simd::Width<T>::value>(base.data(), index);
+	T sum = 0;
+	bool gather = true;
+	for(int l=0;l<L;l++) gather = gather and gathered[l] == base[index[l]], sum += base[index[l]];
+	MATH_CHECK(gather and Simd::Sum(gathered) == sum);
+
+	alignas(64) T streamed[16] = {};
+	Simd::Stream(streamed, gathered);
+	Simd::Fence();
+	bool stream = true;
+	for(int l=0;l<L;l++) stream = stream and streamed[l] == gathered[l];
+	MATH_CHECK(stream);
+
+	// splitting 2L interleaved values and putting them back is exact and lands lane for lane //
+	alignas(64) T pairs[32], back[32];
+	for(int i=0;i<2*L;i++) pairs[i] = T(i)*T(1.5) - T(7);
+	P re, im;
+	Simd::Deinterleave(pairs, re, im);
+	Simd::Interleave(back, re, im);
+	bool split = true;
+	for(int l=0;l<L;l++) split = split and re[l] == pairs[2*l] and im[l] == pairs[2*l+1];
+	for(int i=0;i<2*L;i++) split = split and back[i] == pairs[i];
+	MATH_CHECK(split);
+}
+
+template<typename T, int N>
+static Matrix::Template<T,N,N> Random(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Template<T,N,N> M;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) M[i][j] = T(u(random));
+	return M;
+}
+
+template<typename T, int N>
+static bool IsZero(const Matrix::Template<T,N,N> & M) {
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) if( M[i][j] != T(0) ) return false;
+	return true;
+}
+
+template<typename T, int N>
+static double Identity(const Matrix::Template<T,N,N> & M, const Matrix::Template<T,N,N> & inverse) {
+	double worst = 0;
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++){
+			double s = i == j ? -1 : 0;
+			for(int k=0;k<N;k++) s += double(M[i][k])*double(inverse[k][j]);
+			worst = Max(worst, Abs(s));
+		}
+	return worst;
+}
+
+// the closed forms against LU, and the lane group batch against one matrix at a time, singular entries included //
+template<typename T, int N>
+static void Closed(std::mt19937 & random, double tolerance) {
+	const size_t count = 4*Simd::Width<T>::value + 3;
+	std::vector< Matrix::Template<T,N,N> > in(count), out(count);
+	for(size_t i=0;i<count;i++) in[i] = Random<T,N>(random);
+	// small whole numbers with a repeated row, so every closed form cancels to an exact zero //
+	for(int i=0;i<N;i++)
+		for(int j=0;j<N;j++) in[2][i][j] = T((i*j + i + 2*j) % 5 + 1);
+	for(int j=0;j<N;j++) in[2][N-1][j] = in[2][0][j];
+	in[count-1] = Matrix::Zero<T,N,N>();
+
+	bool determinant = true, inverse = true;
+	for(size_t i=0;i<count;i++){
+		const double reference = double(Matrix::LU<T,N>(in[i]).Determinant());
+		determinant = determinant and Abs(double(Matrix::Determinant(in[i])) - reference) <= tolerance;
+		if( i == 2 or i == count-1 ) continue;
+		Matrix::Template<T,N,N> inv;
+		inverse = inverse and Matrix::InverseInto(inv, in[i]) == Status::Success and Identity(in[i], inv) <= tolerance/Abs(reference);
+	}
+	MATH_CHECK(determinant);
+	MATH_CHECK(inverse);
+
+	std::vector<Status> status(count);
+	const size_t singular = Matrix::InverseBatch(out.data(), in.data(), count, status.data());
+	MATH_CHECK(singular == 2 and status[2] == Status::Singular and status[count-1] == Status::Singular);
+	bool batch = IsZero(out[2]) and IsZero(out[count-1]);
+	for(size_t i=0;i<count;i++){
+		if( i == 2 or i == count-1 ) continue;
+		Matrix::Template<T,N,N> inv;
+		Matrix::InverseInto(inv, in[i]);
+		batch = batch and status[i] == Status::Success;
+		for(int r=0;r<N;r++)
+			for(int c=0;c<N;c++) batch = batch and Abs(double(out[i][r][c]) - double(inv[r][c])) <= tolerance*(1 + Abs(double(inv[r][c])));
+	}
+	MATH_CHECK(batch);
+}
+
+// the singular test of the closed forms follows the scale of the entries, as Invert does past 4x4 //
+template<typename T, int N>
+static void Scaled(std::mt19937 & random, double tolerance) {
+	for(double scale : {1e-6, 1e-4, 1.0, 1e4}){
+		Matrix::Template<T,N,N> M = Random<T,N>(random), I = Matrix::Zero<T,N,N>(), R, inv;
+		for(int i=0;i<N;i++){
+			I[i][i] = T(scale);
+			for(int j=0;j<N;j++) M[i][j] *= T(scale) + T(2)*T(i == j)*T(scale);
+		}
+		MATH_CHECK(Matrix::InverseInto(inv, I) == Status::Success and Abs(double(inv[0][0])*scale - 1) <= tolerance);
+		const double det = double(Matrix::LU<T,N>(M).Determinant())/std::pow(scale, N);
+		MATH_CHECK(Matrix::InverseInto(inv, M) == Status::Success and Identity(M, inv) <= tolerance/Abs(det));
+
+		// a row that is a combination of two others leaves only rounding in the determinant //
+		R = M;
+		for(int j=0;j<N;j++) R[N-1][j] = T(0.75)*R[0][j] - T(1.5)*R[N > 2 ? 1 : 0][j];
+		MATH_CHECK(Matrix::InverseInto(inv, R) == Status::Singular);
+
+		Matrix::Template<T,N,N> in[3] = {I, M, R}, out[3];
+		Status status[3];
+		MATH_CHECK(Matrix::InverseBatch(out, in, 3, status) == 1 and status[0] == Status::Success and status[1] == Status::Success and status[2] == Status::Singular);
+	}
+}
+
+int main() {
+	std::mt19937 random(53);
+	Lanes<float>(random);
+	Lanes<double>(random);
+	Closed<double,2>(random, 1e-13);
+	Closed<double,3>(random, 1e-13);
+	Closed<double,4>(random, 1e-13);
+	Closed<float,2>(random, 1e-5);
+	Closed<float,3>(random, 1e-5);
+	Closed<float,4>(random, 1e-5);
+	Scaled<double,2>(random, 1e-12);
+	Scaled<double,3>(random, 1e-12);
+	Scaled<double,4>(random, 1e-12);
+	Scaled<float,3>(random, 1e-4);
+	Scaled<float,4>(random, 1e-4);
+	return Tests::Report("SIMD");
+}
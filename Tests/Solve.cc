@@ -0,0 +1,223 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Solve.h>
+
+#include <cmath>
+#include <random>
+
+using namespace Math;
+
+static Matrix::Dynamic<double> Random(int rows, int columns, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Dynamic<double> A(rows, columns);
+	for(int i=0;i<rows;i++)
+		for(int j=0;j<columns;j++) A(i,j) = u(random);
+	return A;
+}
+
+// |A X - B| / (|A| |X| + |B|) in the max norm, the backward error every solver here is held to //
+static double Residual(const Matrix::Dynamic<double> & A, const double * x, const double * b, int columns) {
+	double r = 0, a = 0, xs = 0, bs = 0;
+	for(int i=0;i<A.Rows();i++){
+		double row = 0;
+		for(int k=0;k<A.Columns();k++) row += Abs(A(i,k));
+		a = Max(a, row);
+		for(int j=0;j<columns;j++){
+			double s = 0;
+			for(int k=0;k<A.Columns();k++) s += A(i,k)*x[k*columns+j];
+			r = Max(r, Abs(s - b[i*columns+j]));
+			bs = Max(bs, Abs(b[i*columns+j]));
+		}
+	}
+	for(int k=0;k<A.Columns()*columns;k++) xs = Max(xs, Abs(x[k]));
+	return r/(a*xs + bs);
+}
+
+static void General(std::mt19937 & random) {
+	// one right hand side by dot products, then enough to go blocked and split the columns across workers //
+	for(int n : {1, 7, 64, 150}){
+		const Matrix::Dynamic<double> A = Random(n, n, random), b = Random(n, 1, random);
+		Status status;
+		Vector::Dynamic<double> v(n);
+		for(int i=0;i<n;i++) v[i] = b(i,0);
+		const Vector::Dynamic<double> x = Matrix::Solve(A, v, &status);
+		MATH_CHECK(status == Status::Success);
+		MATH_CHECK(Residual(A, &x, &b, 1) < 1e-14);
+
+		const Matrix::Dynamic<double> B = Random(n, 600, random), X = Matrix::Solve(A, B, &status);
+		MATH_CHECK(status == Status::Success);
+		MATH_CHECK(Residual(A, &X, &B, 600) < 1e-14);
+
+		Matrix::Factor::LU<double> lu(A);
+		MATH_CHECK(!lu.IsSingular() and lu.GetStatus() == Status::Success);
+		MATH_CHECK_NEAR(lu.Determinant(), Matrix::Determinant(A), 1e-10);
+	}
+
+	// a repeated row is singular and solves to zeros //
+	Matrix::Dynamic<double> S = Random(6, 6, random);
+	for(int j=0;j<6;j++) S(5,j) = S(2,j);
+	Status status;
+	const Vector::Dynamic<double> zero = Matrix::Solve(S, Vector::Dynamic<double>(6, 1.0), &status);
+	MATH_CHECK(status == Status::Singular and zero[0] == 0.0);
+	MATH_CHECK(Matrix::Factor::LU<double>(S).IsSingular());
+}
+
+static void Fixed(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	Matrix::Template<double,5,5> A;
+	Vector::Template<double,5> b;
+	for(int i=0;i<5;i++){
+		for(int j=0;j<5;j++) A[i][j] = u(random);
+		b[i] = u(random);
+	}
+	Status status;
+	const Vector::Template<double,5> x = Matrix::Solve(A, b, &status);
+	MATH_CHECK(status == Status::Success);
+	const Matrix::Dynamic<double> D(A);
+	MATH_CHECK(Residual(D, &x, &b, 1) < 1e-14);
+
+	// the Solve free function is Matrix::LU underneath //
+	const Matrix::LU<double,5> lu(A);
+	MATH_CHECK(lu.GetStatus() == Status::Success);
+	MATH_CHECK(lu.Solve(b) == x);
+
+	for(int j=0;j<5;j++) A[4][j] = A[0][j] + A[1][j];
+	A[4][0] = A[0][0];
+	for(int j=0;j<5;j++) A[3][j] = 2*A[0][j];
+	MATH_CHECK((Matrix::LU<double,5>(A).GetStatus() == Status::Singular));
+	Matrix::Solve(A, b, &status);
+	MATH_CHECK(status == Status::Singular);
+
+	// integral systems are factored in double //
+	Matrix::Template<int,3,3> I{{2,1,0},{1,3,1},{0,1,4}};
+	const Vector::Template<double,3> y = Matrix::Solve(I, Vector::Template<int,3>{3,5,5}, &status);
+	MATH_CHECK(status == Status::Success);
+	for(int i=0;i<3;i++) MATH_CHECK_NEAR(y[i], 1.0, 1e-14);
+}
+
+static void Cholesky(std::mt19937 & random) {
+	for(int n : {5, 100}){
+		// M M^T + n I is symmetric positive definite //
+		const Matrix::Dynamic<double> M = Random(n, n, random), b = Random(n, 3, random);
+		Matrix::Dynamic<double> A(n, n);
+		for(int i=0;i<n;i++)
+			for(int j=0;j<n;j++){
+				double s = i == j ? double(n) : 0.0;
+				for(int k=0;k<n;k++) s += M(i,k)*M(j,k);
+				A(i,j) = s;
+			}
+		Matrix::Factor::Cholesky<double> cholesky(A);
+		MATH_CHECK(cholesky.GetStatus() == Status::Success and !cholesky.IsSingular());
+		const Matrix::Dynamic<double> X = cholesky.Solve(b);
+		MATH_CHECK(Residual(A, &X, &b, 3) < 1e-14);
+
+		A(0,0) = -1;
+		MATH_CHECK(Matrix::Factor::Cholesky<double>(A).IsSingular());
+	}
+}
+
+static void LeastSquares(std::mt19937 & random) {
+	// the residual of the least squares solution is orthogonal to the columns of A //
+	const int m = 80, n = 20;
+	const Matrix::Dynamic<double> A = Random(m, n, random);
+	Vector::Dynamic<double> b(m);
+	std::uniform_real_distribution<double> u(-1, 1);
+	for(int i=0;i<m;i++) b[i] = u(random);
+	Status status;
+	const Vector::Dynamic<double> x = Matrix::LeastSquares(A, b, &status);
+	MATH_CHECK(status == Status::Success);
+	double worst = 0;
+	for(int j=0;j<n;j++){
+		double s = 0;
+		for(int i=0;i<m;i++){
+			double r = -b[i];
+			for(int k=0;k<n;k++) r += A(i,k)*x[k];
+			s += A(i,j)*r;
+		}
+		worst = Max(worst, Abs(s));
+	}
+	MATH_CHECK(worst < 1e-12);
+
+	// a column that is the sum of two others only cancels to rounding, not to an exact zero //
+	Matrix::Dynamic<double> D = A;
+	for(int i=0;i<m;i++) D(i,7) = 0.1*D(i,2) + 0.3*D(i,5);
+	Matrix::Factor::QR<double> qr(D);
+	MATH_CHECK(qr.IsSingular() and qr.GetStatus() == Status::Singular);
+	Matrix::LeastSquares(D, b, &status);
+	MATH_CHECK(status == Status::Singular);
+
+	// scaling a column down by a large factor is not a loss of rank //
+	Matrix::Dynamic<double> E = A;
+	for(int i=0;i<m;i++) E(i,3) *= 1e-8;
+	MATH_CHECK(!Matrix::Factor::QR<double>(E).IsSingular());
+}
+
+// the singular test of Invert is relative to the largest entry, so scaling A changes the inverse by the reciprocal and nothing else //
+static void Inverse(std::mt19937 & random) {
+	for(double scale : {1e-20, 1.0, 1e20}){
+		const Matrix::Dynamic<double> A = Random(7, 7, random);
+		Matrix::Dynamic<double> S(A), inverse, scaled;
+		for(size_t i=0;i<S.Size();i++) (&S)[i] *= scale;
+		MATH_CHECK(Matrix::InverseInto(inverse, A) == Status::Success);
+		MATH_CHECK(Matrix::InverseInto(scaled, S) == Status::Success);
+		double error = 0, largest = 0;
+		for(size_t i=0;i<inverse.Size();i++){
+			error = Max(error, Abs((&scaled)[i]*scale - (&inverse)[i]));
+			largest = Max(largest, Abs((&inverse)[i]));
+		}
+		MATH_CHECK(error <= 1e-12*largest);
+
+		// a tiny multiple of the identity is as invertible as the identity, Exact keeps the default policy from snapping 1e-20 //
+		Matrix::Template<double,5,5> I;
+		for(int i=0;i<5;i++)
+			for(int j=0;j<5;j++) I[i][j] = i == j ? scale : 0.0;
+		Matrix::Template<double,5,5> J;
+		MATH_CHECK(Matrix::InverseInto<Policy::Exact>(J, I) == Status::Success and J[2][2] == 1/scale);
+
+		// a row that is a combination of two others is singular at every scale, to rounding //
+		Matrix::Dynamic<double> R(S);
+		for(int j=0;j<7;j++) R(6,j) = 0.75*S(0,j) - 1.5*S(3,j);
+		MATH_CHECK(Matrix::InverseInto(scaled, R) == Status::Singular);
+	}
+}
+
+// LU, Solve and Invert share one scale relative pivot test, so they agree on matrices that are singular only to rounding //
+static void Rounding(std::mt19937 & random) {
+	const Matrix::Template<double,3,3> A{{1,2,3},{4,5,6},{7,8,9}};
+	const Matrix::Dynamic<double> D(A);
+	Matrix::Template<double,3,3> inverse;
+	Matrix::Dynamic<double> dynamic;
+	Status status;
+	Matrix::Solve(A, Vector::Template<double,3>{1,2,3}, &status);
+	MATH_CHECK(status == Status::Singular);
+	Matrix::Solve(D, Vector::Dynamic<double>(3, 1.0), &status);
+	MATH_CHECK(status == Status::Singular);
+	MATH_CHECK((Matrix::LU<double,3>(A).IsSingular() and Matrix::Factor::LU<double>(D).IsSingular()));
+	MATH_CHECK(Matrix::InverseInto(dynamic, D) == Status::Singular);
+
+	for(double scale : {1e-20, 1.0, 1e20}){
+		Matrix::Dynamic<double> S = Random(6, 6, random), R(S);
+		for(size_t i=0;i<S.Size();i++) (&S)[i] *= scale, (&R)[i] *= scale;
+		for(int j=0;j<6;j++) R(5,j) = 0.75*R(0,j) - 1.5*R(3,j);
+		Matrix::Solve(S, Vector::Dynamic<double>(6, scale), &status);
+		MATH_CHECK(status == Status::Success and !Matrix::Factor::LU<double>(S).IsSingular());
+		Matrix::Solve(R, Vector::Dynamic<double>(6, scale), &status);
+		MATH_CHECK(status == Status::Singular and Matrix::Factor::LU<double>(R).IsSingular());
+		MATH_CHECK(Matrix::InverseInto(dynamic, R) == Status::Singular);
+	}
+
+	// the blocked factorization keeps the same test across its panels //
+	Matrix::Dynamic<double> B = Random(150, 150, random);
+	for(int j=0;j<150;j++) B(149,j) = 0.5*B(10,j) + 0.25*B(140,j);
+	MATH_CHECK(Matrix::Factor::LU<double>(B).IsSingular());
+}
+
+int main() {
+	std::mt19937 random(23);
+	General(random);
+	Fixed(random);
+	Cholesky(random);
+	LeastSquares(random);
+	Inverse(random);
+	Rounding(random);
+	return Tests::Report("Solve");
+}
@@ -0,0 +1,87 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Sparse.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+// every product is held to the dense product of the same entries //
+static void Compare(int rows, int columns, double density, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-1, 1);
+	std::uniform_int_distribution<int> r(0, rows-1), c(0, columns-1);
+
+	// triplets in random order, some positions repeated and summed on assembly, possibly in another order //
+	Matrix::Dynamic<double> D(rows, columns, 0.0);
+	std::vector< Matrix::Triplet<double> > triplets;
+	const size_t count = size_t(density*rows*columns);
+	for(size_t k=0;k<count;k++){
+		const Matrix::Triplet<double> t{r(random), c(random), u(random)};
+		triplets.push_back(t);
+		D(t.row,t.column) += t.value;
+	}
+	const Matrix::Sparse<double> A(rows, columns, triplets);
+
+	const Matrix::Dynamic<double> E = A.Dense();
+	bool ordered = true, same = true;
+	for(int i=0;i<rows;i++)
+		for(size_t k=A.Offsets()[i]+1;k<A.Offsets()[i+1];k++) ordered = ordered and A.Indices()[k-1] < A.Indices()[k];
+	for(int i=0;i<rows;i++)
+		for(int j=0;j<columns;j++) same = same and Abs(A(i,j) - D(i,j)) < 1e-15 and E(i,j) == A(i,j);
+	MATH_CHECK(ordered);
+	MATH_CHECK(same);
+
+	// y = 2 A x - y //
+	Vector::Dynamic<double> x(columns), y(rows), z(rows);
+	for(int j=0;j<columns;j++) x[j] = u(random);
+	for(int i=0;i<rows;i++) y[i] = z[i] = u(random);
+	Matrix::TransformInto(y, A, x, 2.0, -1.0);
+	double error = 0;
+	for(int i=0;i<rows;i++){
+		double s = -z[i];
+		for(int j=0;j<columns;j++) s += 2*D(i,j)*x[j];
+		error = Max(error, Abs(s - y[i]));
+	}
+	MATH_CHECK(error < 1e-12);
+
+	// sparse by dense, dense by sparse and the transpose //
+	const int n = 7;
+	Matrix::Dynamic<double> B(columns, n), L(n, rows);
+	for(int i=0;i<columns;i++)
+		for(int j=0;j<n;j++) B(i,j) = u(random);
+	for(int i=0;i<n;i++)
+		for(int j=0;j<rows;j++) L(i,j) = u(random);
+	const Matrix::Dynamic<double> AB = A*B, LA = Matrix::Transform(L, A), DB = Matrix::Transform(D, B), LD = Matrix::Transform(L, D);
+	double right = 0, left = 0;
+	for(size_t k=0;k<AB.Size();k++) right = Max(right, Abs((&AB)[k] - (&DB)[k]));
+	for(size_t k=0;k<LA.Size();k++) left = Max(left, Abs((&LA)[k] - (&LD)[k]));
+	MATH_CHECK(right < 1e-12 and left < 1e-12);
+
+	const Matrix::Sparse<double> T = Matrix::Transpose(A);
+	bool transposed = T.Rows() == columns and T.Columns() == rows and T.NonZeros() == A.NonZeros();
+	for(int i=0;i<rows;i++)
+		for(int j=0;j<columns;j++) transposed = transposed and T(j,i) == D(i,j);
+	MATH_CHECK(transposed);
+
+	// blocks of 3 over shapes that do not fill whole blocks //
+	const Matrix::Blocked<double,3> K(A);
+	Vector::Dynamic<double> w(rows);
+	Matrix::TransformInto(w, K, x);
+	error = 0;
+	for(int i=0;i<rows;i++){
+		double s = 0;
+		for(int j=0;j<columns;j++) s += D(i,j)*x[j];
+		error = Max(error, Abs(s - w[i]));
+	}
+	MATH_CHECK(error < 1e-12);
+}
+
+int main() {
+	std::mt19937 random(29);
+	Compare(1, 1, 1.0, random);
+	Compare(10, 17, 0.3, random);
+	Compare(101, 64, 0.05, random);
+	// enough stored entries to split the rows across workers //
+	Compare(2000, 1500, 0.01, random);
+	return Tests::Report("Sparse");
+}
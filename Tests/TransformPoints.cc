@@ -0,0 +1,126 @@
+#include <Tests/Check.h>
+#include <Math/Algebra/Matrix.h>
+
+#include <random>
+#include <vector>
+
+using namespace Math;
+
+template<typename T, int rows, int columns>
+static Matrix::Template<T,rows,columns> Random(std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-2, 2);
+	Matrix::Template<T,rows,columns> M;
+	for(int i=0;i<rows;i++)
+		for(int j=0;j<columns;j++) M[i][j] = T(u(random));
+	return M;
+}
+
+template<typename T, int size>
+static std::vector< Vector::Template<T,size> > Points(size_t count, std::mt19937 & random) {
+	std::uniform_real_distribution<double> u(-10, 10);
+	std::vector< Vector::Template<T,size> > points(count);
+	for(auto & p : points)
+		for(int c=0;c<size;c++) p[c] = T(u(random));
+	return points;
+}
+
+// M*p in double, plus column `columns` of M when affine //
+template<typename T, int rows, int columns, int size>
+static double Reference(const Matrix::Template<T,rows,columns> & M, const Vector::Template<T,size> & p, int i, bool affine) {
+	double s = affine ? double(M[i][columns-1]) : 0;
+	for(int j=0;j<(affine ? columns-1 : columns);j++) s += double(M[i][j])*double(p[j]);
+	return s;
+}
+
+template<typename T, int rows, int columns>
+static void InPlace(const Matrix::Template<T,rows,columns> &, const std::vector< Vector::Template<T,columns> > &, const std::vector< Vector::Template<T,rows> > &) {}
+
+// square matrices overwrite their points with exactly what the out of place form writes //
+template<typename T, int N>
+static void InPlace(const Matrix::Template<T,N,N> & M, const std::vector< Vector::Template<T,N> > & in, const std::vector< Vector::Template<T,N> > & out) {
+	std::vector< Vector::Template<T,N> > points(in);
+	Matrix::TransformPoints(M, points.data(), points.size());
+	bool same = true;
+	for(size_t k=0;k<points.size();k++)
+		for(int i=0;i<N;i++) same = same and points[k][i] == out[k][i];
+	MATH_CHECK(same);
+}
+
+// square and rectangular products, below a worker grain, past it, and past the streaming size, checked against a double reference //
+template<typename T, int rows, int columns>
+static void Linear(std::mt19937 & random, double tolerance) {
+	const Matrix::Template<T,rows,columns> M = Random<T,rows,columns>(random);
+	const size_t streamed = Matrix::Kernel::StreamBytes/sizeof(Vector::Template<T,rows>) + 77;
+	for(size_t count : {size_t(0), size_t(1), size_t(5), size_t(Matrix::Kernel::PointGrain) + 3, streamed}){
+		const auto in = Points<T,columns>(count, random);
+		std::vector< Vector::Template<T,rows> > out(count);
+		Matrix::TransformPoints(M, in.data(), out.data(), count);
+		bool near = true;
+		for(size_t k=0;k<count;k++)
+			for(int i=0;i<rows;i++) near = near and Abs(double(out[k][i]) - Reference(M, in[k], i, false)) <= tolerance;
+		MATH_CHECK(near);
+
+		InPlace(M, in, out);
+	}
+}
+
+// a 4x4 taken as [R t; 0 1] moves 3 component points, in place or not //
+template<typename T>
+static void Affine(std::mt19937 & random, double tolerance) {
+	Matrix::Template<T,4,4> M = Random<T,4,4>(random);
+	M[3][0] = M[3][1] = M[3][2] = T(0), M[3][3] = T(1);
+	const size_t streamed = Matrix::Kernel::StreamBytes/sizeof(Vector::Template<T,3>) + 5;
+	for(size_t count : {size_t(3), size_t(Matrix::Kernel::PointGrain)*2 + 1, streamed}){
+		const auto in = Points<T,3>(count, random);
+		std::vector< Vector::Template<T,3> > out(count), points(in);
+		Matrix::TransformPoints(M, in.data(), out.data(), count);
+		Matrix::TransformPoints(M, points.data(), count);
+		bool near = true, same = true;
+		for(size_t k=0;k<count;k++)
+			for(int i=0;i<3;i++){
+				near = near and Abs(double(out[k][i]) - Reference(M, in[k], i, true)) <= tolerance;
+				same = same and points[k][i] == out[k][i];
+			}
+		MATH_CHECK(near);
+		MATH_CHECK(same);
+	}
+}
+
+// strided raw buffers write exactly the rows of each point and leave the values between points alone //
+template<typename T>
+static void Strided(std::mt19937 & random, double tolerance) {
+	const Matrix::Template<T,2,3> M = Random<T,2,3>(random);
+	const size_t count = 1000, is = 5, os = 3;
+	std::vector<T> in(count*is), out(count*os, T(-7));
+	std::uniform_real_distribution<double> u(-10, 10);
+	for(auto & x : in) x = T(u(random));
+	Matrix::TransformPoints(M, in.data(), is, out.data(), os, count);
+	bool near = true, untouched = true;
+	for(size_t k=0;k<count;k++){
+		for(int i=0;i<2;i++){
+			double s = 0;
+			for(int j=0;j<3;j++) s += double(M[i][j])*double(in[k*is+j]);
+			near = near and Abs(double(out[k*os+i]) - s) <= tolerance;
+		}
+		untouched = untouched and out[k*os+2] == T(-7);
+	}
+	MATH_CHECK(near);
+	MATH_CHECK(untouched);
+}
+
+int main() {
+	std::mt19937 random(71);
+	const unsigned threads = Parallel::Threads();
+	Parallel::Configure(4);
+	Linear<float,4,4>(random, 1e-4);
+	Linear<float,3,3>(random, 1e-4);
+	Linear<double,4,4>(random, 1e-12);
+	Linear<double,3,2>(random, 1e-12);
+	Linear<double,2,4>(random, 1e-12);
+	Affine<float>(random, 1e-4);
+	Affine<double>(random, 1e-12);
+	Strided<float>(random, 1e-4);
+	Strided<double>(random, 1e-12);
+	Parallel::Configure(threads);
+	return Tests::Report("TransformPoints");
+}